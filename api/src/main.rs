@@ -5,11 +5,18 @@
 use std::process::Command;
 use rocket::response::content;
 
+//imports for talking to orpgd
+use std::io::{BufRead, BufReader, Read, Write};
+use std::os::unix::net::UnixStream;
+
 //extern crate for rock framework && json 
 extern crate rocket;
 #[macro_use]
 extern crate serde_json;
 
+/// The socket orpgd listens on by default, see `orpgd --help`
+const ORPGD_SOCKET: &'static str = "/tmp/orpgd.sock";
+
 
 /// # Function Name: roll_module
 /// ---
@@ -35,20 +42,14 @@ let mut args1: Vec<&str> = args.split("&").collect();
 let index = args1.iter().position(|&r| r == "json");
 match index {
         None => {
-            let output = Command::new("./build/roll")
-                .args(args1)
-                .output()
-                .expect("failed");
-            return String::from_utf8_lossy(&output.stdout).to_string();
+            let request = roll_request(&args1);
+            return run_module("./build/roll", request, &args1);
         },
 
         Some(i) => {
             remove_ele(&mut args1, i);
-            let output = Command::new("./build/roll")
-                .args(args1)
-                .output()
-                .expect("failed");
-            let mut output_string = String::from_utf8_lossy(&output.stdout).to_string();
+            let request = roll_request(&args1);
+            let mut output_string = run_module("./build/roll", request, &args1);
             output_string.pop();
             let json = json!({"output" : output_string});
             return json.to_string();
@@ -81,20 +82,14 @@ let mut args1: Vec<&str> = args.split("&").collect();
 let index = args1.iter().position(|&r| r == "json");
 match index {
         None => {
-                let output = Command::new("./build/name-generator")
-                    .args(args1)
-                    .output()
-                    .expect("failed");
-                return String::from_utf8_lossy(&output.stdout).to_string();
+                let request = name_request(&args1);
+                return run_module("./build/name-generator", request, &args1);
             },
 
         Some(i) => {
                 remove_ele(&mut args1, i);
-                let output = Command::new("./build/name-generator")
-                    .args(args1)
-                    .output()
-                    .expect("failed");
-                let mut output_string = String::from_utf8_lossy(&output.stdout).to_string();
+                let request = name_request(&args1);
+                let mut output_string = run_module("./build/name-generator", request, &args1);
                 output_string.pop();
                 let json = json!({"name" : output_string});
                 return json.to_string();
@@ -103,6 +98,106 @@ match index {
 }
 
 
+/// # Function Name: roll_request
+/// ---
+///
+/// Builds the orpgd request for a /roll call. Options (i.e -h) are only
+/// understood by the roll program, so they return None to spawn it instead.
+
+fn roll_request(args: &Vec<&str>) -> Option<String> {
+    if args.iter().any(|a| a.starts_with("-")) {
+        return None;
+    }
+
+    // roll joins its arguments in to one expression the same way
+    Some(format!("roll {}", args.concat()))
+}
+
+
+/// # Function Name: name_request
+/// ---
+///
+/// Builds the orpgd request for a /name call. Options, and anything but a
+/// race and an optional gender, return None so name-generator can answer
+/// with its own help or error.
+
+fn name_request(args: &Vec<&str>) -> Option<String> {
+    if args.len() < 1 || args.len() > 2 || args.iter().any(|a| a.is_empty() || a.starts_with("-")) {
+        return None;
+    }
+
+    Some(format!("name {}", args.join(" ")))
+}
+
+
+/// # Function Name: orpgd_request
+/// ---
+///
+/// Sends a single request line to orpgd and returns the reply, printed the
+/// way the matching program would print it: the result and a newline, or
+/// nothing if orpgd answered with an error (the programs print those to
+/// stderr). Returns None if orpgd could not be reached.
+
+fn orpgd_request(line: &str) -> Option<String> {
+    let mut stream = match UnixStream::connect(ORPGD_SOCKET) {
+        Ok(stream) => stream,
+        Err(_) => return None,
+    };
+
+    if stream.write_all(format!("{}\n", line).as_bytes()).is_err() {
+        return None;
+    }
+
+    // every reply is a line of "ok LENGTH" or "err LENGTH" followed by LENGTH bytes
+    let mut reader = BufReader::new(stream);
+    let mut head = String::new();
+
+    if reader.read_line(&mut head).is_err() {
+        return None;
+    }
+
+    let parts: Vec<&str> = head.trim().split(" ").collect();
+    let length: usize = match parts.get(1).and_then(|l| l.parse().ok()) {
+        Some(length) => length,
+        None => return None,
+    };
+
+    let mut payload = vec![0; length];
+    if reader.read_exact(&mut payload).is_err() {
+        return None;
+    }
+
+    if parts[0] == "ok" {
+        Some(format!("{}\n", String::from_utf8_lossy(&payload)))
+    } else {
+        Some(String::new())
+    }
+}
+
+
+/// # Function Name: run_module
+/// ---
+///
+/// Asks orpgd for the answer to request when there is one, falling back to
+/// spawning program with args if orpgd is not running. orpgd answers in
+/// microseconds, where spawning a program costs a fork, an exec, and loading
+/// the OpenRPG libraries and data for every request.
+
+fn run_module(program: &str, request: Option<String>, args: &Vec<&str>) -> String {
+    if let Some(line) = request {
+        if let Some(output) = orpgd_request(&line) {
+            return output;
+        }
+    }
+
+    let output = Command::new(program)
+        .args(args)
+        .output()
+        .expect("failed");
+    String::from_utf8_lossy(&output.stdout).to_string()
+}
+
+
 /// # Function Name: remove_ele
 /// ---
 /// 
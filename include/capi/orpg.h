@@ -0,0 +1,193 @@
+/*
+capi - orpg.h
+Created on: Oct 18, 2026
+
+OpenRPG Software License - Version 1.0 - February 10th, 2017 <https://openrpg.io/about/license/>
+This is free software: you are free to change and redistribute it.
+There is NO WARRANTY, to the extent permitted by law.
+*/
+#ifndef SRC_ORPG_C_H_
+#define SRC_ORPG_C_H_
+
+/**
+ * The OpenRPG C API. This is the stable interface for calling the OpenRPG
+ * libraries from other languages in process (via FFI), rather than spawning
+ * the command line programs. It is plain C: every object is an opaque
+ * handle made and freed through these functions, and every string or array
+ * is written in to a buffer the caller provides, so no memory ever crosses
+ * the boundary in either direction.
+ *
+ * Functions that write a string follow snprintf(): they return the length
+ * of the whole string, not counting the terminating NUL, and write as much
+ * of it as fits in size bytes (always NUL terminated when size > 0). A
+ * return at or past size means the buffer was too small. Negative returns
+ * are an orpg_status, and orpg_last_error() says why.
+ *
+ * A handle may be used from any thread, but only by one thread at a time.
+ * Different handles may be used from different threads at once.
+ *
+ * Only the functions in this header are exported from the library, see
+ * orpg.map. Symbols are only ever added, never changed or removed, within
+ * ORPG_C_API_VERSION.
+ **/
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(_WIN32)
+#   ifdef ORPG_C_BUILD
+#       define ORPG_C_EXPORT __declspec(dllexport)
+#   else
+#       define ORPG_C_EXPORT __declspec(dllimport)
+#   endif
+#else
+#   define ORPG_C_EXPORT __attribute__((visibility("default")))
+#endif
+
+/* bumped only if an existing function changes, which should be never */
+#define ORPG_C_API_VERSION      1
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* a compiled roll expression, see orpg_roll_compile() */
+typedef struct orpg_roll orpg_roll;
+
+/* a name generator for a single race and gender, see orpg_names_create() */
+typedef struct orpg_names orpg_names;
+
+/* the negative results a function may return */
+typedef enum orpg_status {
+    ORPG_OK                 =  0,
+    ORPG_ERROR_ARGUMENT     = -1,   /* a NULL handle or buffer, or a bad count */
+    ORPG_ERROR_EXPRESSION   = -2,   /* a roll expression or score method that does not parse */
+    ORPG_ERROR_FORMAT       = -3,   /* an unknown orpg_format */
+    ORPG_ERROR_MEMORY       = -4    /* the library ran out of memory */
+} orpg_status;
+
+/* the formats orpg_character_generate() can write a character in */
+typedef enum orpg_format {
+    ORPG_FORMAT_TEXT    = 0,
+    ORPG_FORMAT_JSON    = 1,
+    ORPG_FORMAT_SHEET   = 2
+} orpg_format;
+
+/**
+ * @desc returns the version of the OpenRPG libraries, i.e "v0.6.0"
+ * @return const char* - a static string, never freed
+ **/
+ORPG_C_EXPORT const char* orpg_version(void);
+
+/**
+ * @desc returns ORPG_C_API_VERSION as the library was built, so a caller
+ * can check it loaded the API it was written against
+ * @return int - the API version of the loaded library
+ **/
+ORPG_C_EXPORT int orpg_api_version(void);
+
+/**
+ * @desc returns why the last call on this thread failed
+ * @return const char* - the message, empty if nothing has failed. It is
+ * owned by the library and valid until the next failing call on this thread
+ **/
+ORPG_C_EXPORT const char* orpg_last_error(void);
+
+/**
+ * @desc parses a roll expression, i.e "4d6h3" or "1d20+5", once so it can
+ * be rolled any number of times
+ * @param const char* expression - the NUL terminated expression to parse
+ * @return orpg_roll* - the compiled expression, or NULL if it did not parse
+ **/
+ORPG_C_EXPORT orpg_roll* orpg_roll_compile(const char* expression);
+
+/**
+ * @desc frees a compiled expression. Passing NULL does nothing.
+ * @param orpg_roll* roll - the expression to free
+ **/
+ORPG_C_EXPORT void orpg_roll_free(orpg_roll* roll);
+
+/**
+ * @desc rolls a compiled expression once
+ * @param orpg_roll* roll - the expression to roll
+ * @param int32_t* out - where the result is written
+ * @return int - ORPG_OK, or a negative orpg_status
+ **/
+ORPG_C_EXPORT int orpg_roll_eval(orpg_roll* roll, int32_t* out);
+
+/**
+ * @desc rolls a compiled expression count times. If a roll fails, out may
+ * hold the results rolled before it.
+ * @param orpg_roll* roll - the expression to roll
+ * @param int32_t* out - an array of at least count results to fill in
+ * @param size_t count - the number of times to roll
+ * @return int - ORPG_OK, or a negative orpg_status
+ **/
+ORPG_C_EXPORT int orpg_roll_eval_batch(orpg_roll* roll, int32_t* out, size_t count);
+
+/**
+ * @desc makes a name generator
+ * @param const char* race - the race to name, i.e "dwarf" or "half-elf"
+ * @param const char* gender - "male", "female", or NULL for the gender neutral lists
+ * @param const char* data_dir - the OpenRPG data directory, NULL for the installed one
+ * @return orpg_names* - the generator, or NULL if race is NULL
+ **/
+ORPG_C_EXPORT orpg_names* orpg_names_create(const char* race, const char* gender,
+                                            const char* data_dir);
+
+/**
+ * @desc frees a name generator. Passing NULL does nothing.
+ * @param orpg_names* names - the generator to free
+ **/
+ORPG_C_EXPORT void orpg_names_free(orpg_names* names);
+
+/**
+ * @desc writes a random full name in to out, snprintf() style
+ * @param orpg_names* names - the generator to use
+ * @param char* out - the buffer to write the name in to
+ * @param size_t size - the size of out in bytes
+ * @return int - the length of the name, or a negative orpg_status
+ **/
+ORPG_C_EXPORT int orpg_names_make(orpg_names* names, char* out, size_t size);
+
+/**
+ * @desc writes count random full names in to out back to back, each NUL
+ * terminated, and where each starts in to offsets. Nothing is written
+ * unless every name fits.
+ * @param orpg_names* names - the generator to use
+ * @param size_t count - the number of names to make
+ * @param char* out - the buffer to write the names in to
+ * @param size_t size - the size of out in bytes
+ * @param size_t* offsets - an array of at least count offsets in to out
+ * @return int64_t - the bytes the names need, NULs included, or a negative
+ * orpg_status. If it is more than size, nothing was written.
+ **/
+ORPG_C_EXPORT int64_t orpg_names_make_batch(orpg_names* names, size_t count,
+                                            char* out, size_t size, size_t* offsets);
+
+/**
+ * @desc generates a fully random character and writes it in to out,
+ * snprintf() style
+ * @param orpg_format format - how to write the character
+ * @param char* out - the buffer to write the character in to
+ * @param size_t size - the size of out in bytes
+ * @return int - the length of the character, or a negative orpg_status
+ **/
+ORPG_C_EXPORT int orpg_character_generate(orpg_format format, char* out, size_t size);
+
+/**
+ * @desc generates the ability scores of count characters at once, the
+ * same way character-generator --method does
+ * @param const char* method - a roll expression, "standard", or "point-buy"
+ * @param size_t count - the number of characters to generate scores for
+ * @param uint8_t* out - an array of at least count * 6 scores, written one
+ * character at a time in STR, DEX, CON, INT, WIS, CHA order
+ * @return int - ORPG_OK, or a negative orpg_status
+ **/
+ORPG_C_EXPORT int orpg_scores_generate(const char* method, size_t count, uint8_t* out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SRC_ORPG_C_H_ */
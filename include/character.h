@@ -10,10 +10,20 @@ There is NO WARRANTY, to the extent permitted by law.
 #define CHARACTER_H
 
 #include "character/classes.h"
+#include "character/ability-generation.h"
 #include "character/ability-scores.h"
 #include "character/backgrounds.h"
+#include "character/build-optimizer.h"
 #include "character/character.h"
+#include "character/checks.h"
+#include "character/combat.h"
+#include "character/initiative.h"
+#include "character/name-provider.h"
+#include "character/population.h"
+#include "character/progression.h"
 #include "character/races.h"
+#include "character/roster.h"
+#include "character/sheet.h"
 #include "character/skills.h"
 
 #endif /* CHARACTER_H */
@@ -0,0 +1,144 @@
+/*
+characters - ability-generation.h
+Created on: Oct 18, 2026
+
+OpenRPG Software License - Version 1.0 - February 10th, 2017 <https://openrpg.io/about/license/>
+This is free software: you are free to change and redistribute it.
+There is NO WARRANTY, to the extent permitted by law.
+*/
+#ifndef SRC_ABILITY_GENERATION_H_
+#define SRC_ABILITY_GENERATION_H_
+
+#ifdef _WIN32
+#	include "exports/character_exports.h"
+#else
+#	define CHARACTER_EXPORT
+#endif
+
+#include <string>
+#include <vector>
+
+#include "roll/distribution.h"
+
+#include "ability-scores.h"
+
+/* the points a point buy has to spend, and the scores it may buy between */
+#define POINT_BUY_BUDGET        27
+#define POINT_BUY_MIN           8
+#define POINT_BUY_MAX           15
+
+/* the number of samples used to estimate the distribution of a roll expression */
+#define SCORE_METHOD_SAMPLES    1000000
+
+namespace ORPG {
+    /**
+     * An enum of the ways a ScoreMethod can generate ability scores:
+     *
+     *  - DICE_SCORES rolls some dice and keeps the highest, plus a bonus,
+     *    i.e 2d6+6, 4d6h3, or 4d4+4
+     *  - EXPRESSION_SCORES rolls any other expression the roll parser accepts
+     *  - STANDARD_ARRAY deals 15, 14, 13, 12, 10, 8 out in a random order
+     *  - POINT_BUY spends POINT_BUY_BUDGET points one at a time on random
+     *    abilities, until nothing more can be afforded
+     **/
+    enum CHARACTER_EXPORT EnumScoreMethod {
+        DICE_SCORES,
+        EXPRESSION_SCORES,
+        STANDARD_ARRAY,
+        POINT_BUY
+    };
+
+    /**
+     * the point buy cost of each score from POINT_BUY_MIN to POINT_BUY_MAX,
+     * i.e POINT_BUY_COST[15 - POINT_BUY_MIN] == 9
+     **/
+    extern const int CHARACTER_EXPORT POINT_BUY_COST[POINT_BUY_MAX - POINT_BUY_MIN + 1];
+
+    /**
+     * ScoreColumns holds the ability scores of many characters column by
+     * column, the same way a Population does: scores[ability][n] is the
+     * score of character n.
+     **/
+    struct CHARACTER_EXPORT ScoreColumns {
+        std::vector<uint8> scores[ABILITY_SCORE_COUNT];
+
+        size_t size() const { return scores[0].size(); };
+    };
+
+    /**
+     * A ScoreMethod is a way of generating a characters ability scores. It is
+     * built from a string, either the name of a standard method ("standard"
+     * or "point-buy") or a roll expression. Expressions of the form
+     * NdS, NdS+B, or NdShK+B (keep the highest K) are rolled in bulk by the
+     * DICE_SCORES kernel; anything else is handed to the roll parser one
+     * score at a time.
+     **/
+    class CHARACTER_EXPORT ScoreMethod {
+    private:
+        EnumScoreMethod method;
+        std::string text;           // the string this method was built from
+        std::string errorStr;       // why the string was not a method, empty if valid
+
+        /* only used by DICE_SCORES */
+        int dice;
+        int sides;
+        int keep;
+        int bonus;
+
+        void generate_range(ScoreColumns& out, size_t begin, size_t end) const;
+
+    public:
+        /**
+         * @desc builds a ScoreMethod from its name or roll expression. If the
+         * string is neither, is_valid() is false and get_error() says why.
+         *
+         * @param const std::string& method - i.e "4d6h3", "standard", or "point-buy"
+         **/
+        ScoreMethod(const std::string& method = "2d6+6");
+
+        bool is_valid() const { return errorStr.empty(); };
+        const std::string& get_error() const { return errorStr; };
+        EnumScoreMethod type() const { return method; };
+        const std::string& to_string() const { return text; };
+
+        /**
+         * @desc returns whether distribution() is exact, rather than estimated
+         * from SCORE_METHOD_SAMPLES samples. Only EXPRESSION_SCORES is estimated.
+         *
+         * @return bool - true if distribution() is exact
+         **/
+        bool is_exact() const { return method != EXPRESSION_SCORES; };
+
+        /**
+         * @desc generates the ability scores of count characters at once,
+         * spread across a thread pool. Each thread fills in its own range of
+         * rows, and DICE_SCORES rolls every die of a block in one batch and
+         * keeps the highest with branch free loops the compiler can vectorize.
+         *
+         * @param size_t count - the number of characters to generate scores for
+         * @param unsigned int threads - the number of threads to use, 0 for one per core
+         *
+         * @return ScoreColumns - count rows of scores, empty if !is_valid()
+         **/
+        ScoreColumns generate(size_t count, unsigned int threads = 0) const;
+
+        /**
+         * @desc returns how a single ability score generated by this method is
+         * distributed. This is exact for every method but EXPRESSION_SCORES.
+         *
+         * @return Distribution - the chance of every score
+         **/
+        Distribution distribution() const;
+    };
+
+    /**
+     * @desc Generates an array of ability scores with the given method
+     *
+     * @param const ScoreMethod& method - the method to generate them with
+     *
+     * @return std::vector<uint8> - one score per EnumAbilityScore
+     **/
+    std::vector<uint8> CHARACTER_EXPORT ability_score_vector(const ScoreMethod& method);
+}
+
+#endif /* SRC_ABILITY_GENERATION_H_ */
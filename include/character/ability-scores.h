@@ -15,10 +15,14 @@ There is NO WARRANTY, to the extent permitted by law.
 #	define CHARACTER_EXPORT
 #endif
 
-#include <map>
-
 #include "core/types.h"
 
+/* the number of entries in EnumAbilityScore */
+#define ABILITY_SCORE_COUNT     6
+
+/* a dirty mask with the bit set for every EnumAbilityScore */
+#define ALL_ABILITIES_DIRTY     ((1 << ABILITY_SCORE_COUNT) - 1)
+
 namespace ORPG {
     /**
      * An AbilityScore represents the score of some ability. A score is an
@@ -61,12 +65,6 @@ namespace ORPG {
          **/
         AbilityScore(uint8 score, bool isProf);
 
-        /**
-         * @desc Deconstructor for AbilityScore that is passed no arguments.
-         * Currently does nothing, and the compiler handles deconstruction.
-         **/
-        ~AbilityScore();
-
         /**
          * @desc Setter method for score and isProf. isProf is a boolean
          * representation of whether or not a proficiency bonus should be added to
@@ -100,7 +98,7 @@ namespace ORPG {
          *
          * @return uint8 - an unsigned 8-bit integer of the AbilityScore's score
          **/
-        uint8 get_score();
+        uint8 get_score() const;
 
         /**
          * @desc Accessor method for the AbilityScore's modifier.
@@ -110,7 +108,7 @@ namespace ORPG {
          *
          * @return int8 - an 8-bit integer of the AbilityScore's modifier
          **/
-        int8 get_mod();
+        int8 get_mod() const;
 
         /**
          * @desc Accessor method for the isProf property. The current Proficiency
@@ -121,7 +119,7 @@ namespace ORPG {
          * @return bool - a boolean value denoting whether or not a proficiency
          * bonus should be added to the save of this AbilityScore
          **/
-        bool is_prof();
+        bool is_prof() const;
     };
 
     /**
@@ -135,7 +133,12 @@ namespace ORPG {
 
     /**
      * AbilityScores is a class to assist in working with the AbilityScore
-     * class. It creates a map, pairing EnumAbilityScore's to AbilityScore's.
+     * class. It stores one AbilityScore per EnumAbilityScore in a flat array
+     * indexed by the enum, so it is trivially copyable and never allocates.
+     *
+     * Every setter marks the bit (1 << EnumAbilityScore) in a dirty mask, so
+     * an owner that caches values derived from these scores (i.e skill and
+     * save modifiers) only needs to recompute what actually changed.
      * 
      * This currently assumes 5e. What can we do to abstract outside of
      * that space?
@@ -145,8 +148,11 @@ namespace ORPG {
         /* The current unsigned 8-bit integer proficiency bonus to add */
         uint8 curProf = 0;
 
-        /* The map relating EnumAbilityScore to their respective AbilityScore */
-        std::map <EnumAbilityScore, AbilityScore*> scoresMap;
+        /* The AbilityScore for each EnumAbilityScore, indexed by the enum */
+        AbilityScore scores[ABILITY_SCORE_COUNT];
+
+        /* a bit per EnumAbilityScore that has changed since the last clear_dirty() */
+        uint8 dirty = ALL_ABILITIES_DIRTY;
 
     public:
         /**
@@ -158,22 +164,16 @@ namespace ORPG {
          */
         AbilityScores(uint8 def = 0);
 
-        /**
-         * @desc Deconstructor for AbilityScores that is passed no arguments.
-         * Currently does nothing, and the compiler handles deconstruction.
-         **/
-        ~AbilityScores();
-
         /**
          * @desc Operator overload for adding two AbilityScores objects together.
          *
-         * @param const AbilityScores obj - the LHS AbilityScores object during the
+         * @param const AbilityScores& obj - the RHS AbilityScores object during the
          * addition operator.
          *
-         * @return AbilityScores& - an AbilityScores object containing the addition of
+         * @return AbilityScores - an AbilityScores object containing the addition of
          * the calling object and the passed AbilityScores object
          **/
-        AbilityScores operator+(const AbilityScores);
+        AbilityScores operator+(const AbilityScores& obj) const;
 
         /**
          * @desc Setter method for an AbilityScore's score and isProf, denoted
@@ -191,7 +191,8 @@ namespace ORPG {
         /**
          * @desc Accessor method for an AbilityScore, denoted by
          * EnumAbilityScore ability. This returns the pointer of the queried
-         * AbilityScore.
+         * AbilityScore. As the pointer allows the score to be changed, the
+         * ability is marked dirty.
          *
          * @param EnumAbilityScore ability - the AbilityScore score to query
          *
@@ -241,8 +242,8 @@ namespace ORPG {
          *
          * @return uint8 - an unsigned 8-bit integer of the AbilityScore's score
          **/
-        uint8 get_score(EnumAbilityScore ability) {
-            return scoresMap[ability]->get_score();
+        uint8 get_score(EnumAbilityScore ability) const {
+            return scores[ability].get_score();
         };
 
         /**
@@ -255,8 +256,8 @@ namespace ORPG {
          *
          * @return int8 - an 8-bit integer of the AbilityScore's modifier
          **/
-        int8 get_mod(EnumAbilityScore ability) {
-            return scoresMap[ability]->get_mod();
+        int8 get_mod(EnumAbilityScore ability) const {
+            return scores[ability].get_mod();
         };
 
         /**
@@ -270,8 +271,8 @@ namespace ORPG {
          * @return bool - a boolean value denoting whether or not a proficiency
          * bonus should be added to the save of the given AbilityScore
          **/
-        bool is_prof(EnumAbilityScore ability) {
-            return scoresMap[ability]->is_prof();
+        bool is_prof(EnumAbilityScore ability) const {
+            return scores[ability].is_prof();
         }
 
         /**
@@ -284,8 +285,8 @@ namespace ORPG {
          *
          * @return int8 - an 8-bit integer of the AbilityScore's save modifier
          **/
-        int8 get_save(EnumAbilityScore ability) {
-            return scoresMap[ability]->is_prof() ?
+        int8 get_save(EnumAbilityScore ability) const {
+            return scores[ability].is_prof() ?
                     this->get_mod(ability) + curProf :
                     this->get_mod(ability);
         };
@@ -298,9 +299,39 @@ namespace ORPG {
          * Proficiency bonus that is added to any AbilityScore that has isProf
          * set to true.
          **/
-        uint8 get_current_prof() {
+        uint8 get_current_prof() const {
             return curProf;
         };
+
+        /**
+         * @desc Accessor method for the dirty mask. Bit (1 << EnumAbilityScore)
+         * is set for every AbilityScore that has changed since the last call to
+         * clear_dirty(). Changing the current proficiency bonus marks every
+         * AbilityScore dirty, as every save depends on it.
+         *
+         * @return uint8 - the dirty mask
+         **/
+        uint8 dirty_mask() const {
+            return dirty;
+        };
+
+        /**
+         * @desc Marks the given abilities dirty, forcing anything derived from
+         * them to be recomputed.
+         *
+         * @param uint8 mask - a bit per EnumAbilityScore to mark, defaults to all
+         **/
+        void mark_dirty(uint8 mask = ALL_ABILITIES_DIRTY) {
+            dirty |= mask;
+        };
+
+        /**
+         * @desc Clears the dirty mask. This should be called by whoever
+         * consumes the mask, once every derived value is up to date.
+         **/
+        void clear_dirty() {
+            dirty = 0;
+        };
     };
 }
 
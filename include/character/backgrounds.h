@@ -39,6 +39,10 @@ There is NO WARRANTY, to the extent permitted by law.
  **/
 
 namespace ORPG {
+    /* Predefine the Background parent class so that anything defined in the Character namespace
+        may use it in the event that they need access to it */
+    class Background;
+
     namespace Characters {
         /**
          * @desc This function returns a random BackgroundID as an unsigned integer,
@@ -50,6 +54,23 @@ namespace ORPG {
          * @return uint - the randomly selected background ID
          **/
         const uint CHARACTER_EXPORT random_bg_id();
+
+        /**
+         * @desc This function takes in an integer, ideally a Background::ID,
+         * and returns a pointer to the shared Background registered under that
+         * ID. If an ID less than 0 is passed we instead will randomly select a
+         * Background type to return.
+         *
+         * NOTE(incomingstick): every Background is immutable, so there is only
+         * ever one of each, created the first time it is asked for. Nothing is
+         * allocated here, and the returned pointer must never be deleted.
+         *
+         * @param const int identifier - the Background::ID of the background to look up
+         *
+         * @return const Background* - a pointer to the shared Background, or
+         * nullptr if the ID is unknown
+         **/
+        CHARACTER_EXPORT const Background* select_background(const int identifier = -1);
     }
 
     /* An enum containing the list of D&D 5E languages */
@@ -87,6 +108,8 @@ namespace ORPG {
         virtual void Initialize() = 0;
 
     public:
+        virtual ~Background() {};
+
         /**
          * @desc A function that returns the Background::ID static property
          *
@@ -94,15 +117,15 @@ namespace ORPG {
          * 
          * @return const uint - the ID value of the calling class
          **/
-        virtual const uint id() = 0;
+        virtual const uint id() const = 0;
 
         /**
          * @desc A function that returns the Background as its string
          * representation
          *
-         * @return const std::string - the string representation of a Background
+         * @return const std::string& - the string representation of a Background
          **/
-        virtual const std::string to_string() = 0;
+        virtual const std::string& to_string() const = 0;
 
         /* The const uint ID for a generic Background */
         static const uint ID = 0x1b810000;
@@ -136,15 +159,15 @@ namespace ORPG {
          * 
          * @return const int - the ID value of the calling class
          **/
-        const uint id() { return Acolyte::ID; };
+        const uint id() const { return Acolyte::ID; };
 
         /**
          * @desc A function that returns the Acolyte as its string
          * representation
          *
-         * @return const std::string - the string representation of an Acolyte
+         * @return const std::string& - the string representation of an Acolyte
          **/
-        const std::string to_string() { return bg_str; };
+        const std::string& to_string() const { return bg_str; };
 
         /* The const uint ID for a generic Background */
         static const uint ID = 0x1b810001;
@@ -0,0 +1,111 @@
+/*
+characters - build-optimizer.h
+Created on: Oct 18, 2026
+
+OpenRPG Software License - Version 1.0 - February 10th, 2017 <https://openrpg.io/about/license/>
+This is free software: you are free to change and redistribute it.
+There is NO WARRANTY, to the extent permitted by law.
+*/
+#ifndef SRC_BUILD_OPTIMIZER_H_
+#define SRC_BUILD_OPTIMIZER_H_
+
+#ifdef _WIN32
+#	include "exports/character_exports.h"
+#else
+#	define CHARACTER_EXPORT
+#endif
+
+#include <functional>
+#include <vector>
+
+#include "ability-generation.h"
+#include "classes.h"
+#include "races.h"
+
+namespace ORPG {
+    /**
+     * A BuildGoal describes what makes one set of ability scores better than
+     * another for a character. The value of a build is the sum, over every
+     * ability, of its weight times the final modifier, plus hitPoints times the
+     * expected maximum hit points at level (taking the average of the hit die
+     * every level after the first). i.e to maximise AC + attack for a finesse
+     * fighter in light armor, weigh DEX at 2.
+     *
+     * Builds with a final score under the minimum of any ability, or that
+     * accept turns down, are never returned.
+     **/
+    struct CHARACTER_EXPORT BuildGoal {
+        double weights[ABILITY_SCORE_COUNT];    // the value of each point of modifier, by EnumAbilityScore
+        uint8 minimum[ABILITY_SCORE_COUNT];     // the lowest final score allowed, by EnumAbilityScore
+        double hitPoints;                       // the value of each expected hit point
+        int level;                              // the level hit points are expected at
+
+        /* an optional last say on each build, given its final scores */
+        std::function<bool(const uint8* scores)> accept;
+
+        /**
+         * @desc Constructor for a BuildGoal that values nothing, allows any
+         * scores, and expects hit points at level 1
+         **/
+        BuildGoal();
+    };
+
+    /**
+     * A Build is a single way of assigning a characters ability scores, as
+     * found by the optimizers below.
+     **/
+    struct CHARACTER_EXPORT Build {
+        uint8 base[ABILITY_SCORE_COUNT];    // the scores bought or assigned, before racial bonuses
+        uint8 scores[ABILITY_SCORE_COUNT];  // the final scores, with racial bonuses
+        int pointsSpent;                    // the point buy cost of base, 0 for an assignment
+        double value;                       // what the BuildGoal made of it
+    };
+
+    namespace Characters {
+        /**
+         * @desc searches every legal point buy (scores of POINT_BUY_MIN to
+         * POINT_BUY_MAX, costing at most POINT_BUY_BUDGET) for the builds a
+         * goal values most. The search is split across a thread pool by the
+         * first two abilities, and each branch is dropped as soon as the best
+         * it could possibly do, read from a precomputed table of what each
+         * remaining ability is worth for every budget, cannot make the top.
+         *
+         * @param const Race& race - the race whose bonuses are applied
+         * @param const CharacterClass& cClass - the class whose hit die is used
+         * @param const BuildGoal& goal - what makes a build better
+         * @param size_t count - the number of builds to return
+         * @param unsigned int threads - the number of threads to use, 0 for one per core
+         *
+         * @return std::vector<Build> - the best builds, best first. Ties go to
+         * the build that spent fewer points, then to the lower base scores
+         * in ability order.
+         **/
+        CHARACTER_EXPORT std::vector<Build> optimize_point_buy(const Race& race,
+                                                               const CharacterClass& cClass,
+                                                               const BuildGoal& goal,
+                                                               size_t count = 1,
+                                                               unsigned int threads = 0);
+
+        /**
+         * @desc searches every way of assigning the given scores (i.e the
+         * standard array, or six rolled scores) to abilities for the builds a
+         * goal values most, pruning the same way as optimize_point_buy().
+         *
+         * @param const std::vector<uint8>& scores - ABILITY_SCORE_COUNT scores to assign
+         * @param const Race& race - the race whose bonuses are applied
+         * @param const CharacterClass& cClass - the class whose hit die is used
+         * @param const BuildGoal& goal - what makes a build better
+         * @param size_t count - the number of builds to return
+         *
+         * @return std::vector<Build> - the best builds, best first, empty if
+         * there are not ABILITY_SCORE_COUNT scores
+         **/
+        CHARACTER_EXPORT std::vector<Build> optimize_assignment(const std::vector<uint8>& scores,
+                                                                const Race& race,
+                                                                const CharacterClass& cClass,
+                                                                const BuildGoal& goal,
+                                                                size_t count = 1);
+    }
+}
+
+#endif /* SRC_BUILD_OPTIMIZER_H_ */
@@ -20,6 +20,8 @@ There is NO WARRANTY, to the extent permitted by law.
 #include "races.h"
 #include "backgrounds.h"
 #include "classes.h"
+#include "name-provider.h"
+#include "sheet.h"
 
 namespace ORPG {
     /* predefinition of Character class incase functions in the Characters
@@ -27,6 +29,32 @@ namespace ORPG {
     class Character;
 
     namespace Characters {
+        /**
+         * An ImportError describes why a single file could not be imported as
+         * a Character. line is the line number of the offending XMLNode or
+         * XMLAttribute, or 0 if the error is not tied to a line (i.e the
+         * file could not be opened).
+         **/
+        struct CHARACTER_EXPORT ImportError {
+            std::string file;       // the path of the file that failed
+            int line;               // the line the error was found on, 0 if none
+            std::string message;    // a description of what went wrong
+        };
+
+        /**
+         * An ImportResult holds the outcome of importing a directory of character
+         * files. files and characters are parallel arrays sorted by path, where
+         * characters[i] is nullptr if files[i] failed to import. Every failure has
+         * a matching entry in errors, in the same order as files.
+         *
+         * NOTE(incomingstick): the caller owns every Character in characters.
+         **/
+        struct CHARACTER_EXPORT ImportResult {
+            std::vector<std::string> files;
+            std::vector<Character*> characters;
+            std::vector<ImportError> errors;
+        };
+
         /**
          * @desc prints the version info when -V or --version is an argument to the command.
          * This adhears to the GNU standard for version printing, and immediately terminates
@@ -134,7 +162,7 @@ namespace ORPG {
          * 
          * @return auto - the current race ID from the RaceSelector
          **/
-        CHARACTER_EXPORT Race* request_race();
+        CHARACTER_EXPORT const Race* request_race();
 
         /**
          * @desc This function prompts the user, via stdout, for 6 numbers to
@@ -155,6 +183,14 @@ namespace ORPG {
          **/
         CHARACTER_EXPORT AbilityScores* request_scores();
 
+        /**
+         * @desc creates a new set of ability scores, rolling each score with
+         * gen_stat(). Nothing is printed or read from stdin.
+         *
+         * @return AbilityScores* - a pointer to the newly rolled ability scores
+         **/
+        CHARACTER_EXPORT AbilityScores* new_random_ability_scores();
+
         /**
          * @desc This function prompts the user via stdout for a name, and reading
          * from stdin the input. We use the safeGetline function via the ORPG::Utils
@@ -175,13 +211,13 @@ namespace ORPG {
 
         /**
          * @desc prints "Wizard Class Automatically Chosen\n" to stdout
-         * and returns a pointer to a new Wizard.
+         * and returns a pointer to the shared Wizard.
          *
          * TODO(incomingstick): Add more character classes
          *
-         * @return CharacterClass* - always will return a pointer to a Wizard
+         * @return const CharacterClass* - always will return a pointer to the shared Wizard
          **/
-        CHARACTER_EXPORT CharacterClass* request_class();
+        CHARACTER_EXPORT const CharacterClass* request_class();
 
         /**
          * @desc prints "Skill select based on class\n" to stdout
@@ -199,7 +235,7 @@ namespace ORPG {
          *
          * @return bool - always will return true
          **/
-        bool CHARACTER_EXPORT request_hitpoints(CharacterClass* classPtr);
+        bool CHARACTER_EXPORT request_hitpoints(const CharacterClass* classPtr);
 
         /**
          * @desc prints "Equipment\n" to stdout
@@ -220,6 +256,62 @@ namespace ORPG {
          * @return Character* - a pointer to a character created via the file
          **/
         CHARACTER_EXPORT Character* import_character(std::string file);
+
+        /**
+         * @desc import_character takes in the location of an XML character file
+         * and attempts to load it as a Character. Unlike the single argument
+         * version nothing is printed; if the file cannot be imported nullptr is
+         * returned and error, if not nullptr, describes why. This is safe to call
+         * from multiple threads at once.
+         *
+         * The expected file looks like the following, where race, class, and
+         * background are the ID's of the Race, CharacterClass, and Background to
+         * use, and the ability scores are the final scores (racial bonuses included):
+         *
+         *  <character name="Tordek Ironfist" race="0x1b800011" class="0x1b820001"
+         *             background="0x1b810001" level="3" exp="900">
+         *      <abilities str="12" dex="10" con="16" int="15" wis="13" cha="8"/>
+         *      <hitpoints current="14" max="16" temp="0"/>
+         *  </character>
+         *
+         * The level, exp, and <hitpoints> data are optional. Without <hitpoints>
+         * every level past the first adds the fixed average of the class hit die.
+         *
+         * @param std::string file - the path of the file to import
+         * @param ImportError* error - filled in on failure, may be nullptr
+         *
+         * @return Character* - a pointer to the imported character, nullptr on failure
+         **/
+        CHARACTER_EXPORT Character* import_character(std::string file, ImportError* error);
+
+        /**
+         * @desc import_directory walks the given directory tree and imports every
+         * .xml file found as a Character. The files are parsed in parallel on a
+         * Core::ThreadPool, and the results are written directly into a vector
+         * allocated up front with a slot for each file. A file that fails to import
+         * does not stop the others; its slot is left as nullptr and the reason is
+         * recorded in the results errors, along with the line it was found on.
+         *
+         * @param std::string path - the directory to search for character files
+         * @param unsigned int threads - the number of threads to use, 0 for one per core
+         *
+         * @return ImportResult - the imported characters and any per-file errors
+         **/
+        CHARACTER_EXPORT ImportResult import_directory(std::string path, unsigned int threads = 0);
+
+        /**
+         * @desc creates a fully random Character without any user input; the
+         * race, class, background, ability scores, and name are all chosen at
+         * random. This is safe to call from multiple threads at once, as each
+         * thread rolls with its own Utils::thread_engine() and the name lists
+         * are shared between every thread once loaded.
+         *
+         * @param NameProvider* names - where the name comes from, nullptr for
+         * the default_name_provider()
+         *
+         * @return Character* - a pointer to the new random Character
+         **/
+        CHARACTER_EXPORT Character* new_random_character(NameProvider* names = nullptr);
     }
 
     /* NOTE: These are just the 5E character requirements */
@@ -282,10 +374,10 @@ namespace ORPG {
     // TODO take an in depth look at what should and should not be public here
     class CHARACTER_EXPORT Character {
     private:
-        Race* race;			                // The race of our character
+        const Race* race;                   // The race of our character, shared
         AbilityScores* abils;               // struct of ability scores
-        CharacterClass* cClass;             // the characters class
-        Background* bg;                     // the characters background
+        const CharacterClass* cClass;       // the characters class, shared
+        const Background* bg;               // the characters background, shared
         Skills* skills;                     // struct of skill checks
         Alignment alignment;                // the character alignment
         Gender gender;                      // the characters gender
@@ -303,19 +395,35 @@ namespace ORPG {
         std::vector<Language> langs;        // the array of known languages
         uint8 age;                          // the age of the character
 
+        /* NOTE(incomingstick): these are derived from abils and skills, and
+            are only brought up to date by update_skills() */
+        int8 saves[ABILITY_SCORE_COUNT];    // cached saving throw modifiers
+        int8 checks[SKILL_COUNT];           // cached skill check modifiers
+
         void Initialize();
         std::string format_mod(int mod, int spaces);
 
     public:
-        Character(Race* racePtr = Characters::new_random_race(),
+        Character(const Race* racePtr = Characters::new_random_race(),
                   AbilityScores* ab = new AbilityScores,
-                  CharacterClass* classPtr = Characters::new_random_character_class(),
+                  const CharacterClass* classPtr = Characters::new_random_character_class(),
                   const int bgID = -1,
                   Skills* sk = new Skills,
-                  std::string name = "");
+                  std::string name = "",
+                  NameProvider* names = nullptr);
         ~Character();
 
+        /* a Character owns its scores and skills, so it may not be copied */
+        Character(const Character&) = delete;
+        Character& operator=(const Character&) = delete;
+
 
+        /**
+         * @desc recomputes the cached save and skill modifiers that depend on an
+         * ability score or skill proficiency that has changed since the last
+         * call. This is called lazily by the accessors below, so there is rarely
+         * a need to call it directly.
+         **/
         void update_skills();
 
         // Returns a copy of our Ability abils struct
@@ -346,21 +454,149 @@ namespace ORPG {
         int8 CHA_MOD() { return abils->get_mod(EnumAbilityScore::CHA); };
 
         /* accessor functions for ability score saves */
-        int8 SCORE_SAVE(EnumAbilityScore score) { return abils->get_save(score); }
-        int8 STR_SAVE() { return abils->get_save(EnumAbilityScore::STR); };
-        int8 DEX_SAVE() { return abils->get_save(EnumAbilityScore::DEX); };
-        int8 CON_SAVE() { return abils->get_save(EnumAbilityScore::CON); };
-        int8 INT_SAVE() { return abils->get_save(EnumAbilityScore::INT); };
-        int8 WIS_SAVE() { return abils->get_save(EnumAbilityScore::WIS); };
-        int8 CHA_SAVE() { return abils->get_save(EnumAbilityScore::CHA); };
+        int8 SCORE_SAVE(EnumAbilityScore score) { update_skills(); return saves[score]; }
+        int8 STR_SAVE() { return SCORE_SAVE(EnumAbilityScore::STR); };
+        int8 DEX_SAVE() { return SCORE_SAVE(EnumAbilityScore::DEX); };
+        int8 CON_SAVE() { return SCORE_SAVE(EnumAbilityScore::CON); };
+        int8 INT_SAVE() { return SCORE_SAVE(EnumAbilityScore::INT); };
+        int8 WIS_SAVE() { return SCORE_SAVE(EnumAbilityScore::WIS); };
+        int8 CHA_SAVE() { return SCORE_SAVE(EnumAbilityScore::CHA); };
+
+        /* accessor functions for skill checks, including proficiency */
+        int8 SKILL_MOD(EnumSkill skill) { update_skills(); return checks[skill]; };
+
+        /* the passive score of a skill, i.e passive Perception */
+        int8 PASSIVE(EnumSkill skill) { return 10 + SKILL_MOD(skill); };
 
         int get_proficiency_bonus() { return prof; };
 
         // allows quick conversion of a skill for its passive check
         int8 passive_stat(int mod) { return 8 + prof + mod; };
 
+        std::string get_first_name() { return firstName; };
+        std::string get_last_name() { return lastName; };
+        int get_level() { return level; };
+        int get_exp() { return curr_exp; };
+        int get_current_hp() { return curr_hp; };
+        int get_max_hp() { return max_hp; };
+        int get_temp_hp() { return temp_hp; };
+        uint get_race_id() { return race->id(); };
+        uint get_class_id() { return cClass->id(); };
+        uint get_background_id() { return bg->id(); };
+        bool is_save_prof(EnumAbilityScore ability) { return abils->is_prof(ability); };
+        uint8 get_skill_prof(EnumSkill skill) { return skills->get_prof_bonus(skill); };
+        const std::vector<Language>& get_languages() { return langs; };
+
+        /**
+         * @desc sets the given ability score to a new final value, bypassing any
+         * racial bonuses, and updates everything derived from it. If Constitution
+         * changes, the characters hit points change by the difference in modifier
+         * for each level.
+         *
+         * @param EnumAbilityScore ability - the ability score to set
+         * @param uint8 score - the new score
+         **/
+        void set_ability_score(EnumAbilityScore ability, uint8 score);
+
+        /**
+         * @desc sets whether the character adds their proficiency bonus to
+         * saving throws made with the given ability
+         *
+         * @param EnumAbilityScore ability - the ability score to set
+         * @param bool isProf - true if the character is proficient in the save
+         **/
+        void set_save_prof(EnumAbilityScore ability, bool isProf) { abils->set_is_prof(ability, isProf); };
+
+        /**
+         * @desc sets the proficiency level (see Skill::get_prof()) the character
+         * has in the given skill
+         *
+         * @param EnumSkill skill - the skill to set
+         * @param uint8 rank - the new proficiency level
+         **/
+        void set_skill_prof(EnumSkill skill, uint8 rank) { skills->get(skill)->set_prof_bonus(rank); };
+
+        /**
+         * @desc replaces the languages the character knows
+         *
+         * @param const std::vector<Language>& languages - the known languages
+         **/
+        void set_languages(const std::vector<Language>& languages) { langs = languages; };
+
+        /**
+         * @desc sets the characters level (clamped to 1 - 20) and updates the
+         * proficiency bonus and the experience needed for the next level
+         *
+         * @param int newLevel - the new character level
+         **/
+        void set_level(int newLevel);
+
+        /**
+         * @desc advances the character one level, rolling their class hit die
+         * and adding their Constitution modifier to their maximum and current
+         * hit points. A level always adds at least 1 hit point. Nothing happens
+         * at level 20.
+         *
+         * @return int - the hit points gained, 0 if already level 20
+         **/
+        int level_up();
+
+        /**
+         * @desc adds to the characters experience, calling level_up() for
+         * every level the new total reaches
+         *
+         * @param int amount - the experience to add
+         *
+         * @return int - the number of levels gained
+         **/
+        int add_exp(int amount);
+
+        /**
+         * @desc sets the characters current experience points
+         *
+         * @param int exp - the new experience total
+         **/
+        void set_exp(int exp) { curr_exp = exp; };
+
+        /**
+         * @desc sets the characters current, maximum, and temporary hit points
+         *
+         * @param int current - the current hit points
+         * @param int maximum - the maximum hit points
+         * @param int temp - the temporary hit points
+         **/
+        void set_hit_points(int current, int maximum, int temp = 0);
+
         std::string to_string();
         std::string to_ascii_sheet();
+
+        /**
+         * @desc renders the characters sheet in to out, using the compiled
+         * ASCII_SHEET_TEMPLATE. out is cleared first, but keeps its capacity,
+         * so rendering many sheets in to the same buffer does not allocate.
+         *
+         * @param std::string& out - the buffer to render the sheet in to
+         **/
+        void to_ascii_sheet(std::string& out);
+
+        /**
+         * @desc renders the characters sheet in to out using the given
+         * template, rather than the one found under Core::DATA_LOCATION().
+         * out is cleared first, but keeps its capacity.
+         *
+         * @param std::string& out - the buffer to render the sheet in to
+         * @param const SheetTemplate& sheet - a compiled sheet template
+         **/
+        void to_ascii_sheet(std::string& out, const SheetTemplate& sheet);
+
+        /**
+         * @desc returns this Character as a single line JSON object with no
+         * trailing newline, suitable for writing out as NDJSON (one object
+         * per line).
+         *
+         * @return std::string - the Character as a JSON object
+         **/
+        std::string to_json();
     };
 }
 
@@ -0,0 +1,153 @@
+/*
+characters - checks.h
+Created on: Oct 18, 2026
+
+OpenRPG Software License - Version 1.0 - February 10th, 2017 <https://openrpg.io/about/license/>
+This is free software: you are free to change and redistribute it.
+There is NO WARRANTY, to the extent permitted by law.
+*/
+#ifndef SRC_CHECKS_H_
+#define SRC_CHECKS_H_
+
+#ifdef _WIN32
+#	include "exports/character_exports.h"
+#else
+#	define CHARACTER_EXPORT
+#endif
+
+#include <vector>
+
+#include "core/utils.h"
+#include "roll/die.h"
+
+#include "character.h"
+#include "population.h"
+
+namespace ORPG {
+    /**
+     * An enum of the ways a d20 can be rolled: NORMAL_ROLL rolls it once,
+     * ADVANTAGE rolls it twice and keeps the higher, and DISADVANTAGE rolls
+     * it twice and keeps the lower.
+     **/
+    enum CHARACTER_EXPORT EnumRollMode {
+        NORMAL_ROLL,
+        ADVANTAGE,
+        DISADVANTAGE
+    };
+
+    /**
+     * A CheckResult holds the outcome of the same check (or save) made by
+     * many characters at once, in the order they were given. Whether each
+     * one passed is packed 64 to a word, so a result for a whole army is
+     * cheap to keep, combine, and count.
+     **/
+    struct CHARACTER_EXPORT CheckResult {
+        size_t count;                   // the number of checks made
+        size_t passes;                  // the number of checks that met or beat the DC
+        std::vector<uint64> passed;     // bit (n % 64) of word (n / 64) is set if check n passed
+        std::vector<int16> totals;      // the d20 plus modifier rolled for each check
+
+        /**
+         * @desc returns whether the given check met or beat the DC
+         *
+         * @param size_t n - the check to query
+         *
+         * @return bool - true if check n passed
+         **/
+        bool is_pass(size_t n) const { return (passed[n / 64] >> (n % 64)) & 1; };
+    };
+
+    namespace Characters {
+        /**
+         * @desc rolls the given Die count times into out, drawing from the
+         * random engine in bulk. Each 32 bit draw is mapped onto several rolls
+         * at once (6 for a d20) with a multiply and a shift, and the rare draw
+         * that would bias the result is rerolled after, so every face stays
+         * exactly as likely as with Die::roll(). The die may have at most 255
+         * sides. A die with fewer than 2 sides always rolls its sides, or 0 if
+         * it has less than none.
+         *
+         * @param const Die& die - the die to roll
+         * @param size_t count - the number of rolls to make
+         * @param uint8* out - where to write the rolls, room for count entries
+         * @param Utils::RandomEngine& engine - the engine to draw from
+         **/
+        CHARACTER_EXPORT void roll_dice(const Die& die, size_t count, uint8* out,
+                                        Utils::RandomEngine& engine);
+
+        /**
+         * @desc rolls count d20s with the given EnumRollMode into out, using
+         * the calling threads random engine
+         *
+         * @param size_t count - the number of d20s to roll
+         * @param uint8* out - where to write the rolls, room for count entries
+         * @param EnumRollMode mode - whether to roll with advantage or disadvantage
+         **/
+        CHARACTER_EXPORT void roll_d20s(size_t count, uint8* out, EnumRollMode mode = NORMAL_ROLL);
+
+        /**
+         * @desc makes count checks at once, each rolling 1d20 + mods[n]
+         * against the same DC. This is what every other function here ends
+         * up calling once it has gathered the modifiers.
+         *
+         * @param const int8* mods - the modifier of each check
+         * @param size_t count - the number of checks to make
+         * @param int dc - the difficulty class to meet or beat
+         * @param EnumRollMode mode - whether to roll with advantage or disadvantage
+         *
+         * @return CheckResult - the outcome of every check
+         **/
+        CHARACTER_EXPORT CheckResult resolve_checks(const int8* mods, size_t count, int dc,
+                                                    EnumRollMode mode = NORMAL_ROLL);
+
+        /**
+         * @desc has every Character make the same skill check, using their
+         * SKILL_MOD() for it
+         *
+         * @param const std::vector<Character*>& characters - who makes the check
+         * @param EnumSkill skill - the skill the check is made with
+         * @param int dc - the difficulty class to meet or beat
+         * @param EnumRollMode mode - whether to roll with advantage or disadvantage
+         *
+         * @return CheckResult - the outcome of every check, in the order of characters
+         **/
+        CHARACTER_EXPORT CheckResult roll_checks(const std::vector<Character*>& characters,
+                                                 EnumSkill skill, int dc,
+                                                 EnumRollMode mode = NORMAL_ROLL);
+
+        /**
+         * @desc has every Character make the same saving throw, using their
+         * SCORE_SAVE() for it
+         *
+         * @param const std::vector<Character*>& characters - who makes the save
+         * @param EnumAbilityScore ability - the ability the save is made with
+         * @param int dc - the difficulty class to meet or beat
+         * @param EnumRollMode mode - whether to roll with advantage or disadvantage
+         *
+         * @return CheckResult - the outcome of every save, in the order of characters
+         **/
+        CHARACTER_EXPORT CheckResult roll_saves(const std::vector<Character*>& characters,
+                                                EnumAbilityScore ability, int dc,
+                                                EnumRollMode mode = NORMAL_ROLL);
+
+        /**
+         * @desc has every member of a Population make the same saving throw,
+         * reading the save modifiers straight from its columns
+         *
+         * NOTE(incomingstick): a Population does not store skills, so skill
+         * checks have to go through the Character overload for now
+         *
+         * @param const Population& population - who makes the save
+         * @param EnumAbilityScore ability - the ability the save is made with
+         * @param int dc - the difficulty class to meet or beat
+         * @param EnumRollMode mode - whether to roll with advantage or disadvantage
+         *
+         * @return CheckResult - the outcome of every save, by member Index
+         **/
+        CHARACTER_EXPORT CheckResult roll_saves(const Population& population,
+                                                EnumAbilityScore ability, int dc,
+                                                EnumRollMode mode = NORMAL_ROLL);
+    }
+}
+
+#endif /* SRC_CHECKS_H_ */
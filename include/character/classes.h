@@ -57,25 +57,41 @@ namespace ORPG {
          **/
         const uint CHARACTER_EXPORT random_class_id();
 
+        /**
+         * @desc This function returns the CharacterClass::ID of every available
+         * class, i.e to report on each of them in turn.
+         *
+         * TODO(incomingstick): this must be kept in step with random_class_id()
+         * by hand, just like select_character_class()
+         *
+         * @return const std::vector<uint>& - every CharacterClass ID
+         **/
+        CHARACTER_EXPORT const std::vector<uint>& character_class_ids();
+
         /**
          * @desc This function takes in an integer, ideally a CharacterClass::ID,
-         * creates a new CharacterClass of that ID type and returns a pointer to it.
-         * If an ID less than 0 is passed we instead will randomly select a 
+         * and returns a pointer to the shared CharacterClass registered under that
+         * ID. If an ID less than 0 is passed we instead will randomly select a
          * CharacterClass type to return.
+         *
+         * NOTE(incomingstick): every CharacterClass is immutable, so there is only
+         * ever one of each, created the first time it is asked for. Nothing is
+         * allocated here, and the returned pointer must never be deleted.
          * 
-         * @param const int identifier - the CharacterClass of the class to be generated
+         * @param const int identifier - the CharacterClass::ID of the class to look up
          * 
-         * @return CharacterClass* - a pointer to the newly created CharacterClass
+         * @return const CharacterClass* - a pointer to the shared CharacterClass,
+         * or nullptr if the ID is unknown
          **/
-        CHARACTER_EXPORT CharacterClass* select_character_class(const int identifier = -1);
+        CHARACTER_EXPORT const CharacterClass* select_character_class(const int identifier = -1);
 
         /**
-         * @desc This function returns a pointer to a random new CharacterClass,
+         * @desc This function returns a pointer to a random shared CharacterClass,
          * from the available classes.
          *
-         * @return CharacterClass* - a pointer to a random new CharacterClass
+         * @return const CharacterClass* - a pointer to a random shared CharacterClass
          **/
-        inline CHARACTER_EXPORT CharacterClass* new_random_character_class() { return select_character_class(); };
+        inline CHARACTER_EXPORT const CharacterClass* new_random_character_class() { return select_character_class(); };
     }
 
     class CHARACTER_EXPORT CharacterClass {
@@ -85,11 +101,6 @@ namespace ORPG {
         std::string equipment;  // TODO(incomingstick): dont use a string here
         std::vector<ORPG::EnumSkill> skillProfs;
 
-        /* this is a pointer to our container (likely a character, however
-            we cannot assume it is) that expects a function named
-            get_proficiency_bonus that returns an integer */
-        void* container;
-
         /* The const string representation for a Background */
         const std::string class_str;
 
@@ -104,24 +115,19 @@ namespace ORPG {
         virtual void Initialize() = 0;
 
     public:
+        virtual ~CharacterClass() {};
+
         /**
          * @desc Rolls the hitDie one time and returns a result between 1 and  
          **/
-        virtual int roll_hit_die() = 0;
+        virtual int roll_hit_die() const = 0;
 
         /**
          * @desc This function simply returns the highest the die could possibly roll
          * 
          * @return const int - the MAX value of the hit die
          **/
-        virtual const int HIT_DIE_MAX() = 0;
-
-        /**
-         * @desc set_owner takes a pointer to an object to set as the container,
-         * as it expects access to its owners proficiency bonus via a function that
-         * should be defined as 'int8 get_proficiency_bonus()'
-         **/
-        void set_owner(void* owner) { container = owner; };
+        virtual const int HIT_DIE_MAX() const = 0;
 
         /**
          * @desc A function that returns the Class::ID static property
@@ -130,15 +136,15 @@ namespace ORPG {
          * 
          * @return const uint - the ID value of the calling class
          **/
-        virtual const uint id() = 0;
+        virtual const uint id() const = 0;
 
         /**
          * @desc A function that returns the Class as its string
          * representation
          *
-         * @return const std::string - the string representation of a Class
+         * @return const std::string& - the string representation of a Class
          **/
-        virtual const std::string to_string() = 0;
+        virtual const std::string& to_string() const = 0;
 
         /* The const uint ID for a generic Class */
         static const uint ID = 0x1b820000;
@@ -171,14 +177,14 @@ namespace ORPG {
         /**
          * @desc Rolls the hitDie one time and returns a result between 1 and  
          **/
-        int roll_hit_die() { return hitDie.roll(); };
+        int roll_hit_die() const { return hitDie.roll(); };
 
         /**
          * @desc This function simply returns the highest the die could possibly roll
          * 
          * @return const int - the MAX value of the hit die
          **/
-        const int HIT_DIE_MAX() { return hitDie.MAX(); };
+        const int HIT_DIE_MAX() const { return hitDie.MAX(); };
 
         /**
          * @desc A function that returns the Wizard::ID static property
@@ -187,15 +193,15 @@ namespace ORPG {
          * 
          * @return const int - the ID value of the calling class
          **/
-        const uint id() { return Wizard::ID; };
+        const uint id() const { return Wizard::ID; };
 
         /**
          * @desc A function that returns the Wizard as its string
          * representation
          *
-         * @return const std::string - the string representation of a Wizard
+         * @return const std::string& - the string representation of a Wizard
          **/
-        const std::string to_string() { return class_str; };
+        const std::string& to_string() const { return class_str; };
 
         /* The const uint ID for a generic Background */
         static const uint ID = 0x1b820001;
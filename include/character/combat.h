@@ -0,0 +1,174 @@
+/*
+characters - combat.h
+Created on: Oct 18, 2026
+
+OpenRPG Software License - Version 1.0 - February 10th, 2017 <https://openrpg.io/about/license/>
+This is free software: you are free to change and redistribute it.
+There is NO WARRANTY, to the extent permitted by law.
+*/
+#ifndef SRC_COMBAT_H_
+#define SRC_COMBAT_H_
+
+#ifdef _WIN32
+#	include "exports/character_exports.h"
+#else
+#	define CHARACTER_EXPORT
+#endif
+
+#include <string>
+#include <vector>
+
+#include "character.h"
+
+/* the number of rounds after which a combat is called a draw */
+#define COMBAT_MAX_ROUNDS       100
+
+namespace ORPG {
+    /**
+     * An Attack is a single attack a Combatant makes on each of their turns.
+     * The attack roll is 1d20 + toHit against the targets armor class, and
+     * damage is any roll expression the roll parser understands.
+     **/
+    struct CHARACTER_EXPORT Attack {
+        std::string name;           // i.e "Longsword"
+        int toHit;                  // the bonus added to the attack roll
+        std::string damage;         // the damage roll, i.e "1d8+3"
+    };
+
+    /**
+     * A Combatant is the stat block of anything that takes part in a combat,
+     * be it a Character or a monster. Every Attack is made on every turn.
+     **/
+    struct CHARACTER_EXPORT Combatant {
+        std::string name;
+        uint8 scores[ABILITY_SCORE_COUNT];  // ability scores, by EnumAbilityScore
+        int maxHP;                          // the hit points the Combatant starts each combat with
+        int armorClass;                     // what an attack roll must meet or beat to hit
+        std::vector<Attack> attacks;        // the attacks made each turn
+
+        /**
+         * @desc returns the bonus this Combatant adds to their initiative,
+         * which is their Dexterity modifier
+         *
+         * @return int - the initiative bonus
+         **/
+        int initiative_bonus() const { return modifier(scores[DEX]); };
+    };
+
+    /**
+     * An EncounterResult sums up many simulated combats between a party and a
+     * group of monsters. A combat that is still going after COMBAT_MAX_ROUNDS
+     * rounds is counted as a draw.
+     **/
+    struct CHARACTER_EXPORT EncounterResult {
+        uint64 combats;             // the number of combats simulated
+        uint64 partyWins;           // combats where every monster fell
+        uint64 monsterWins;         // combats where every party member fell
+        uint64 draws;               // combats that ran out of rounds
+
+        /* rounds[n] is the number of combats that ended in round n */
+        std::vector<uint64> rounds;
+
+        /* partyHP[n] is the number of combats the party ended with n percent
+            of their total maximum hit points left, 0 - 100 */
+        std::vector<uint64> partyHP;
+
+        /* survivors[n] is the number of combats party member n was still standing at the end */
+        std::vector<uint64> survivors;
+
+        /**
+         * @desc returns the fraction of combats the party won
+         *
+         * @return double - the party win rate, 0.0 - 1.0
+         **/
+        double win_rate() const { return combats == 0 ? 0.0 : (double)partyWins / combats; };
+
+        /**
+         * @desc returns the mean number of rounds a combat lasted
+         *
+         * @return double - the mean combat length in rounds
+         **/
+        double mean_rounds() const;
+
+        /**
+         * @desc returns the mean percentage of the partys total maximum hit
+         * points left at the end of a combat
+         *
+         * @return double - the mean hit points left, 0.0 - 100.0
+         **/
+        double mean_party_hp() const;
+
+        /**
+         * @desc adds the counts of another result to this one
+         *
+         * @param const EncounterResult& other - the result to add
+         **/
+        void merge(const EncounterResult& other);
+    };
+
+    /**
+     * @desc builds a Combatant from a Character, taking their name, ability
+     * scores, and maximum hit points. A Character does not yet track their
+     * armor or weapons, so those are given here.
+     *
+     * @param Character& character - the Character to copy
+     * @param int armorClass - the Characters armor class
+     * @param const std::vector<Attack>& attacks - the attacks they make each turn
+     *
+     * @return Combatant - the Characters stat block
+     **/
+    CHARACTER_EXPORT Combatant make_combatant(Character& character, int armorClass,
+                                              const std::vector<Attack>& attacks);
+
+    /**
+     * An EncounterSimulator runs the same encounter, a party against a group
+     * of monsters, many times over to see how it tends to go. Each combat:
+     *
+     *  - everyone rolls initiative (1d20 + Dexterity modifier), highest first
+     *  - on their turn, a Combatant makes every Attack against the standing
+     *    enemy with the fewest hit points left. A natural 20 always hits and
+     *    a natural 1 always misses.
+     *  - a Combatant at 0 hit points is out of the fight
+     *  - the combat ends when one side is down, or after COMBAT_MAX_ROUNDS
+     *
+     * TODO(incomingstick): critical hits do not yet double the damage dice
+     **/
+    class CHARACTER_EXPORT EncounterSimulator {
+    private:
+        std::vector<Combatant> party;
+        std::vector<Combatant> monsters;
+        std::string errorStr;
+
+    public:
+        /**
+         * @desc sets up a simulator for the given encounter. Every damage
+         * roll is checked here; if one cannot be parsed is_valid() is false
+         * and get_error() says which.
+         *
+         * @param const std::vector<Combatant>& party - the first side
+         * @param const std::vector<Combatant>& monsters - the second side
+         **/
+        EncounterSimulator(const std::vector<Combatant>& party,
+                           const std::vector<Combatant>& monsters);
+
+        bool is_valid() const { return errorStr.empty(); };
+        const std::string& get_error() const { return errorStr; };
+
+        /**
+         * @desc simulates the given number of combats, spread across a thread
+         * pool. Every worker shares the damage rolls cached by
+         * ExpressionCache::shared(), which never change once compiled, and
+         * rolls them with the random engine of the thread it runs on. Each
+         * worker keeps its own fighters and tallies, so nothing else is shared
+         * between threads until the results are merged at the end.
+         *
+         * @param uint64 combats - the number of combats to simulate
+         * @param unsigned int threads - the number of threads to use, 0 for one per core
+         *
+         * @return EncounterResult - the combined results, empty if !is_valid()
+         **/
+        EncounterResult run(uint64 combats, unsigned int threads = 0) const;
+    };
+}
+
+#endif /* SRC_COMBAT_H_ */
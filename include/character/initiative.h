@@ -0,0 +1,194 @@
+/*
+characters - initiative.h
+Created on: Oct 18, 2026
+
+OpenRPG Software License - Version 1.0 - February 10th, 2017 <https://openrpg.io/about/license/>
+This is free software: you are free to change and redistribute it.
+There is NO WARRANTY, to the extent permitted by law.
+*/
+#ifndef SRC_INITIATIVE_H_
+#define SRC_INITIATIVE_H_
+
+#ifdef _WIN32
+#	include "exports/character_exports.h"
+#else
+#	define CHARACTER_EXPORT
+#endif
+
+#include <string>
+#include <vector>
+
+#include "character.h"
+
+namespace ORPG {
+    /**
+     * An InitiativeTracker decides whose turn it is in a battle of any size.
+     * Every entrant has an initiative (usually 1d20 + their Dexterity
+     * modifier) and the tracker hands out turns highest first, round after
+     * round, until they are removed. Ties go to the higher Dexterity
+     * modifier, and then to whoever joined first, so the order never depends
+     * on chance once the initiatives are rolled.
+     *
+     * The entrants are kept in a binary heap keyed on (round, initiative),
+     * with each entrants position in the heap tracked by handle. Taking a
+     * turn, adding, removing, or delaying an entrant are all O(log n).
+     **/
+    class CHARACTER_EXPORT InitiativeTracker {
+    public:
+        /* identifies an entrant for as long as the tracker lives */
+        typedef uint32 Handle;
+
+        /* returned in place of a Handle when there is no entrant */
+        static const Handle NONE = 0xFFFFFFFF;
+
+        struct Entry {
+            std::string name;       // the name the entrant was added with
+            int initiative;         // the initiative the entrant acts on
+            int dexMod;             // the Dexterity modifier, used to break ties
+            int round;              // the round of the entrants next turn
+            uint32 joined;          // the order entrants were added, used to break ties
+        };
+
+    private:
+        std::vector<Entry> entries;         // every entrant ever added, by Handle
+        std::vector<int32> positions;       // where each Handle is in heap, -1 once removed
+        std::vector<Handle> heap;           // the entrants waiting for a turn
+        Handle currentTurn;                 // whose turn it is, NONE before the first
+        int currentRound;                   // the round currentTurn is acting in
+
+        bool before(Handle a, Handle b) const;
+        void place(size_t index, Handle handle);
+        void sift_up(size_t index);
+        void sift_down(size_t index);
+        void push(Handle handle);
+        void erase(size_t index);
+        Handle make_entry(const std::string& name, int dexMod, int initiative);
+
+    public:
+        InitiativeTracker();
+
+        /**
+         * @desc adds an entrant, rolling their initiative as 1d20 + dexMod. An
+         * entrant that joins part way through a round acts this round if their
+         * initiative has not come up yet, and next round otherwise.
+         *
+         * @param const std::string& name - the name of the entrant
+         * @param int dexMod - their Dexterity modifier
+         *
+         * @return Handle - the new entrants handle
+         **/
+        Handle add(const std::string& name, int dexMod);
+
+        /**
+         * @desc adds an entrant with an initiative that was already rolled,
+         * i.e at the table
+         *
+         * @param const std::string& name - the name of the entrant
+         * @param int dexMod - their Dexterity modifier, used to break ties
+         * @param int initiative - their initiative
+         *
+         * @return Handle - the new entrants handle
+         **/
+        Handle add(const std::string& name, int dexMod, int initiative);
+
+        /**
+         * @desc adds a Character, rolling 1d20 + DEX_MOD() for them
+         *
+         * @param Character& character - the Character joining the battle
+         *
+         * @return Handle - the new entrants handle
+         **/
+        Handle add(Character& character);
+
+        /**
+         * @desc adds many entrants at once. Every initiative is rolled in one
+         * pass, and the heap is rebuilt once at the end in O(n) rather than
+         * sifting each entrant in on its own.
+         *
+         * @param const std::vector<std::string>& names - the names of the entrants
+         * @param const std::vector<int>& dexMods - their Dexterity modifiers, parallel to names
+         *
+         * @return std::vector<Handle> - the new handles, in the same order as names
+         **/
+        std::vector<Handle> add_all(const std::vector<std::string>& names,
+                                    const std::vector<int>& dexMods);
+
+        /**
+         * @desc removes an entrant, i.e when they die or flee
+         *
+         * @param Handle handle - the entrant to remove
+         *
+         * @return bool - true if the entrant was in the tracker
+         **/
+        bool remove(Handle handle);
+
+        /**
+         * @desc delays the entrant whose turn it is to a lower initiative. They
+         * act again later this round at the new initiative, and keep it for
+         * the rest of the battle.
+         *
+         * @param Handle handle - the entrant whose turn it is
+         * @param int initiative - the new initiative, lower than their current one
+         *
+         * @return bool - true if the entrant was delayed
+         **/
+        bool delay(Handle handle, int initiative);
+
+        /**
+         * @desc changes an entrants initiative, moving them in the order. The
+         * round of their next turn does not change.
+         *
+         * @param Handle handle - the entrant to change
+         * @param int initiative - their new initiative
+         *
+         * @return bool - true if the entrant was in the tracker
+         **/
+        bool set_initiative(Handle handle, int initiative);
+
+        /**
+         * @desc starts the next turn, returning whose it is
+         *
+         * @return Handle - the entrant whose turn it is, NONE if the tracker is empty
+         **/
+        Handle next();
+
+        /**
+         * @desc returns the entrant whose turn is next, without starting it
+         *
+         * @return Handle - the next entrant, NONE if the tracker is empty
+         **/
+        Handle peek() const { return heap.empty() ? NONE : heap[0]; };
+
+        /**
+         * @desc returns the first entrant added with the given name that is
+         * still in the tracker
+         *
+         * @param const std::string& name - the name to look for
+         *
+         * @return Handle - the entrant, NONE if there is none
+         **/
+        Handle find(const std::string& name) const;
+
+        /**
+         * @desc returns every entrant in the order they will take their turns,
+         * starting with the next one. This sorts a copy of the heap, so it is
+         * O(n log n) and meant for display.
+         *
+         * @return std::vector<Handle> - the entrants in turn order
+         **/
+        std::vector<Handle> order() const;
+
+        /**
+         * @desc removes every entrant and starts again from round 1
+         **/
+        void clear();
+
+        bool contains(Handle handle) const { return handle < positions.size() && positions[handle] >= 0; };
+        const Entry& get(Handle handle) const { return entries[handle]; };
+        size_t size() const { return heap.size(); };
+        Handle current() const { return currentTurn; };
+        int round() const { return currentRound; };
+    };
+}
+
+#endif /* SRC_INITIATIVE_H_ */
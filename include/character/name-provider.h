@@ -0,0 +1,133 @@
+/*
+characters - name-provider.h
+Created on: Oct 18, 2026
+
+OpenRPG Software License - Version 1.0 - February 10th, 2017 <https://openrpg.io/about/license/>
+This is free software: you are free to change and redistribute it.
+There is NO WARRANTY, to the extent permitted by law.
+*/
+#ifndef SRC_NAME_PROVIDER_H_
+#define SRC_NAME_PROVIDER_H_
+
+#ifdef _WIN32
+#	include "exports/character_exports.h"
+#else
+#	define CHARACTER_EXPORT
+#endif
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+namespace ORPG {
+    /* Predefine the Race parent class so that a NameProvider may name one */
+    class Race;
+
+    /**
+     * A NameProvider hands out the first and last name of every Character that
+     * is built without one. By default this is a GeneratorNameProvider, but
+     * anything that builds many characters at once may pass its own to skip
+     * the name lists entirely.
+     *
+     * NOTE(incomingstick): bulk generation calls make_name() from many threads
+     * at once, so every NameProvider must be safe to share between threads.
+     **/
+    class CHARACTER_EXPORT NameProvider {
+    public:
+        virtual ~NameProvider() {};
+
+        /**
+         * @desc sets first and last to a name for a new Character of the
+         * given Race. last may be left empty for races without last names.
+         *
+         * @param const Race& race - the race of the Character being named
+         * @param std::string& first - set to the first name
+         * @param std::string& last - set to the last name
+         **/
+        virtual void make_name(const Race& race, std::string& first, std::string& last) = 0;
+    };
+
+    /**
+     * A GeneratorNameProvider picks names at random from the name lists in
+     * the data directory, the same way a NameGenerator does. Each thread keeps
+     * one NameGenerator per Race, so the race file is only worked out once
+     * rather than once per Character.
+     **/
+    class CHARACTER_EXPORT GeneratorNameProvider : public NameProvider {
+    private:
+        const std::string location;
+
+    public:
+        /**
+         * @desc Constructor for GeneratorNameProvider that is passed one
+         * optional argument, the toplevel location to read name lists from.
+         * An empty location uses Core::DATA_LOCATION(), as a NameGenerator
+         * does.
+         *
+         * @param std::string _location = "" - the toplevel location to check
+         * for lst files. note that /names will be appended to this location
+         **/
+        GeneratorNameProvider(std::string _location = ""):
+            location(_location) {};
+
+        void make_name(const Race& race, std::string& first, std::string& last);
+    };
+
+    /**
+     * A ListNameProvider hands out names from a list made ahead of time, in
+     * order, starting over once the list runs out. Each name is split on its
+     * first space, the same way the Character constructor splits a name.
+     * Shuffling a list of distinct names beforehand makes every Character
+     * unique, up to the size of the list.
+     **/
+    class CHARACTER_EXPORT ListNameProvider : public NameProvider {
+    private:
+        std::vector<std::string> firstNames;
+        std::vector<std::string> lastNames;
+        std::atomic<size_t> next;
+
+    public:
+        ListNameProvider(const std::vector<std::string>& names);
+
+        /**
+         * @desc returns the number of names in the list
+         *
+         * @return size_t - the number of names
+         **/
+        size_t size() const { return firstNames.size(); };
+
+        void make_name(const Race& race, std::string& first, std::string& last);
+    };
+
+    /**
+     * A FixedNameProvider gives every Character the same name. It does no
+     * work at all, which makes it useful for tests and benchmarks.
+     **/
+    class CHARACTER_EXPORT FixedNameProvider : public NameProvider {
+    private:
+        const std::string firstName;
+        const std::string lastName;
+
+    public:
+        FixedNameProvider(std::string first = "", std::string last = ""):
+            firstName(first), lastName(last) {};
+
+        void make_name(const Race& race, std::string& first, std::string& last) {
+            first = firstName;
+            last = lastName;
+        };
+    };
+
+    namespace Characters {
+        /**
+         * @desc returns the NameProvider used when a Character is built
+         * without a name or a provider of its own. This is a single shared
+         * GeneratorNameProvider.
+         *
+         * @return NameProvider& - the shared default NameProvider
+         **/
+        CHARACTER_EXPORT NameProvider& default_name_provider();
+    }
+}
+
+#endif /* SRC_NAME_PROVIDER_H_ */
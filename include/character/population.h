@@ -0,0 +1,265 @@
+/*
+characters - population.h
+Created on: Oct 18, 2026
+
+OpenRPG Software License - Version 1.0 - February 10th, 2017 <https://openrpg.io/about/license/>
+This is free software: you are free to change and redistribute it.
+There is NO WARRANTY, to the extent permitted by law.
+*/
+#ifndef SRC_POPULATION_H_
+#define SRC_POPULATION_H_
+
+#ifdef _WIN32
+#	include "exports/character_exports.h"
+#else
+#	define CHARACTER_EXPORT
+#endif
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "character.h"
+
+namespace ORPG {
+    /**
+     * A Population stores many characters (i.e the NPCs of a town, or both
+     * sides of a large battle) column by column rather than one Character
+     * object at a time. Each member is a row; every property of the row lives
+     * in its own tightly packed array:
+     *
+     *  - one uint8 column per ability score, and a bitmask of save proficiencies
+     *  - skill proficiencies packed 2 bits per skill, and a bitmask of languages
+     *  - the race, class, and background ID's, packed down to their low 16 bits
+     *    (the class space of an ORPG ID is implied by the column it is in)
+     *  - level, experience, and current/max/temporary hit points
+     *  - first and last names, interned into a single shared string table
+     *
+     * A million members fit in a few tens of megabytes and nothing is allocated
+     * per member, so the bulk operations below walk straight down a column and
+     * can be vectorized by the compiler. Use to_character() when a single member
+     * needs the full Character interface.
+     *
+     * NOTE(incomingstick): like the rest of Characters, the scores stored here
+     * are final scores, with any racial bonus already applied.
+     **/
+    class CHARACTER_EXPORT Population {
+    public:
+        /* the type used to refer to a member (row) of a Population */
+        typedef uint32 Index;
+
+        /* the type used to refer to an interned name */
+        typedef uint32 NameID;
+
+    private:
+        std::vector<uint8> scores[ABILITY_SCORE_COUNT]; // one column per ability score
+        std::vector<uint8> saveProfs;       // bit N set if proficient in EnumAbilityScore N saves
+        std::vector<uint64> skillProfs;     // 2 bits per EnumSkill, see Skill::get_prof()
+        std::vector<uint32> languages;      // bit N set if the Language N is known
+        std::vector<uint16> raceIDs;        // low 16 bits of the members Race::ID
+        std::vector<uint16> classIDs;       // low 16 bits of the members CharacterClass::ID
+        std::vector<uint16> bgIDs;          // low 16 bits of the members Background::ID
+        std::vector<uint8> levels;          // character level, 1 - 20
+        std::vector<int32> exp;             // current experience
+        std::vector<int32> currHP;          // current hit points
+        std::vector<int32> maxHP;           // maximum hit points
+        std::vector<int32> tempHP;          // temporary hit points
+        std::vector<NameID> firstNames;     // index into names
+        std::vector<NameID> lastNames;      // index into names
+
+        std::vector<std::string> names;                     // interned names, 0 is always ""
+        std::unordered_map<std::string, NameID> nameIndex;  // name -> index into names
+
+    public:
+        /**
+         * @desc Constructor for an empty Population
+         **/
+        Population();
+
+        /**
+         * @desc returns the number of members in this Population
+         *
+         * @return size_t - the number of members
+         **/
+        size_t size() const { return levels.size(); };
+
+        /**
+         * @desc reserves space for the given number of members in every column,
+         * so adding that many members does not reallocate
+         *
+         * @param size_t count - the number of members to reserve space for
+         **/
+        void reserve(size_t count);
+
+        /**
+         * @desc removes every member, and every interned name, from this Population
+         **/
+        void clear();
+
+        /**
+         * @desc interns the given name, returning its NameID. Adding the same
+         * name twice returns the same NameID, so a million NPCs drawn from a
+         * few hundred names only store each name once.
+         *
+         * @param const std::string& name - the name to intern
+         *
+         * @return NameID - the ID of the interned name
+         **/
+        NameID intern(const std::string& name);
+
+        /**
+         * @desc returns the name interned as the given NameID
+         *
+         * @param NameID id - the ID of the name to look up
+         *
+         * @return const std::string& - the interned name
+         **/
+        const std::string& name(NameID id) const { return names[id]; };
+
+        /**
+         * @desc copies everything a Population stores about the given Character
+         * into a new member
+         *
+         * @param Character& character - the character to add
+         *
+         * @return Index - the index of the new member
+         **/
+        Index add(Character& character);
+
+        /**
+         * @desc creates a new Character from the given member. The caller owns
+         * the returned Character and must delete it.
+         *
+         * @param Index member - the member to convert
+         *
+         * @return Character* - a pointer to the new Character, nullptr if the
+         * member has an ID that does not match a known Race, class, or Background
+         **/
+        Character* to_character(Index member) const;
+
+        /* accessor functions for a single member */
+        uint8 score(Index member, EnumAbilityScore ability) const { return scores[ability][member]; };
+        bool is_save_prof(Index member, EnumAbilityScore ability) const { return (saveProfs[member] >> ability) & 1; };
+        uint8 skill_prof(Index member, EnumSkill skill) const { return (skillProfs[member] >> (2 * skill)) & 3; };
+        bool knows_language(Index member, Language lang) const { return (languages[member] >> lang) & 1; };
+        uint race_id(Index member) const { return Race::ID | raceIDs[member]; };
+        uint class_id(Index member) const { return CharacterClass::ID | classIDs[member]; };
+        uint background_id(Index member) const { return Background::ID | bgIDs[member]; };
+        int level(Index member) const { return levels[member]; };
+        int experience(Index member) const { return exp[member]; };
+        int proficiency_bonus(Index member) const { return 2 + (levels[member] - 1) / 4; };
+        int current_hp(Index member) const { return currHP[member]; };
+        int max_hp(Index member) const { return maxHP[member]; };
+        int temp_hp(Index member) const { return tempHP[member]; };
+        const std::string& first_name(Index member) const { return names[firstNames[member]]; };
+        const std::string& last_name(Index member) const { return names[lastNames[member]]; };
+
+        /**
+         * @desc direct read only access to a whole ability score column, for
+         * callers that want to write their own bulk operations
+         *
+         * @param EnumAbilityScore ability - the column to return
+         *
+         * @return const std::vector<uint8>& - the score of every member
+         **/
+        const std::vector<uint8>& score_column(EnumAbilityScore ability) const { return scores[ability]; };
+
+        /**
+         * @desc computes the given ability modifier of every member. out must
+         * have room for size() entries.
+         *
+         * @param EnumAbilityScore ability - the ability to compute modifiers for
+         * @param int8* out - where to write the modifiers, one per member
+         **/
+        void modifiers(EnumAbilityScore ability, int8* out) const;
+
+        /**
+         * @desc computes the given saving throw modifier of every member, that
+         * is the ability modifier plus the members proficiency bonus if they
+         * are proficient in the save. out must have room for size() entries.
+         *
+         * @param EnumAbilityScore ability - the ability to compute saves for
+         * @param int8* out - where to write the save modifiers, one per member
+         **/
+        void saves(EnumAbilityScore ability, int8* out) const;
+
+        /**
+         * @desc rolls a saving throw (1d20 + save modifier) against the given
+         * DC for every member, using the calling threads random engine.
+         * passed[member] is set to 1 if the member met or beat the DC, and
+         * to 0 otherwise.
+         *
+         * @param EnumAbilityScore ability - the ability the save is made with
+         * @param int dc - the difficulty class of the save
+         * @param std::vector<uint8>& passed - resized and filled in with the results
+         *
+         * @return size_t - the number of members that passed
+         **/
+        size_t roll_saves(EnumAbilityScore ability, int dc, std::vector<uint8>& passed) const;
+
+        /**
+         * @desc deals damage to every member whose entry in mask is non-zero,
+         * taking it from temporary hit points first. mask is usually the result
+         * of filter_mask() or the inverse of roll_saves().
+         *
+         * @param const std::vector<uint8>& mask - which members take the damage
+         * @param int amount - the amount of damage to deal
+         **/
+        void apply_damage(const std::vector<uint8>& mask, int amount);
+
+        /**
+         * @desc advances every member below the given level up to it, one level
+         * at a time. Each level rolls the hit die of every member that is still
+         * climbing in one pass, adding the members Constitution modifier (and
+         * at least 1) to their current and maximum hit points.
+         *
+         * @param int targetLevel - the level to advance to, clamped to 1 - 20
+         *
+         * @return size_t - the number of levels gained across every member
+         **/
+        size_t level_up(int targetLevel);
+
+        /**
+         * @desc returns the index of every member for which pred(*this, member)
+         * returns true, in order
+         *
+         * @param Predicate pred - a callable taking (const Population&, Index)
+         *
+         * @return std::vector<Index> - the matching members
+         **/
+        template<typename Predicate>
+        std::vector<Index> filter(Predicate pred) const {
+            std::vector<Index> ret;
+
+            for(Index member = 0; member < size(); member++) {
+                if(pred(*this, member)) ret.push_back(member);
+            }
+
+            return ret;
+        }
+
+        /**
+         * @desc like filter(), but writes a 1 or 0 for every member rather than
+         * collecting indices, which is cheaper to feed into another bulk op
+         *
+         * @param Predicate pred - a callable taking (const Population&, Index)
+         * @param std::vector<uint8>& mask - resized and filled in with the results
+         *
+         * @return size_t - the number of matching members
+         **/
+        template<typename Predicate>
+        size_t filter_mask(Predicate pred, std::vector<uint8>& mask) const {
+            size_t count = 0;
+
+            mask.resize(size());
+            for(Index member = 0; member < size(); member++) {
+                mask[member] = pred(*this, member) ? 1 : 0;
+                count += mask[member];
+            }
+
+            return count;
+        }
+    };
+}
+
+#endif /* SRC_POPULATION_H_ */
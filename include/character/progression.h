@@ -0,0 +1,113 @@
+/*
+characters - progression.h
+Created on: Oct 18, 2026
+
+OpenRPG Software License - Version 1.0 - February 10th, 2017 <https://openrpg.io/about/license/>
+This is free software: you are free to change and redistribute it.
+There is NO WARRANTY, to the extent permitted by law.
+*/
+#ifndef SRC_PROGRESSION_H_
+#define SRC_PROGRESSION_H_
+
+#ifdef _WIN32
+#	include "exports/character_exports.h"
+#else
+#	define CHARACTER_EXPORT
+#endif
+
+#include <vector>
+
+#include "classes.h"
+
+/* the highest level a character may reach */
+#define CHARACTER_MAX_LEVEL     20
+
+namespace ORPG {
+    /**
+     * A HitPointDistribution is the result of simulate_hit_points(): how many
+     * of the simulated characters of one class and Constitution modifier ended
+     * up with each maximum hit point total, at every level.
+     **/
+    struct CHARACTER_EXPORT HitPointDistribution {
+        uint classID;               // the CharacterClass::ID that was simulated
+        int hitDie;                 // the size of the classes hit die
+        int conMod;                 // the Constitution modifier that was simulated
+        uint64 samples;             // the number of characters simulated
+
+        /* counts[level - 1][hp] is the number of characters with hp
+            maximum hit points at that level */
+        std::vector<uint64> counts[CHARACTER_MAX_LEVEL];
+
+        /**
+         * @desc returns the lowest maximum hit points seen at the given level
+         *
+         * @param int level - the level to query, 1 - CHARACTER_MAX_LEVEL
+         *
+         * @return int - the lowest hit point total, 0 if nothing was simulated
+         **/
+        int lowest(int level) const;
+
+        /**
+         * @desc returns the highest maximum hit points seen at the given level
+         *
+         * @param int level - the level to query, 1 - CHARACTER_MAX_LEVEL
+         *
+         * @return int - the highest hit point total, 0 if nothing was simulated
+         **/
+        int highest(int level) const;
+
+        /**
+         * @desc returns the mean maximum hit points at the given level
+         *
+         * @param int level - the level to query, 1 - CHARACTER_MAX_LEVEL
+         *
+         * @return double - the mean hit point total
+         **/
+        double mean(int level) const;
+
+        /**
+         * @desc returns the standard deviation of the maximum hit points at
+         * the given level
+         *
+         * @param int level - the level to query, 1 - CHARACTER_MAX_LEVEL
+         *
+         * @return double - the standard deviation of the hit point total
+         **/
+        double stddev(int level) const;
+
+        /**
+         * @desc returns the smallest hit point total that at least the given
+         * fraction of characters are at or below, i.e 0.5 for the median
+         *
+         * @param int level - the level to query, 1 - CHARACTER_MAX_LEVEL
+         * @param double fraction - the fraction of characters, 0.0 - 1.0
+         *
+         * @return int - the hit point total at that percentile
+         **/
+        int percentile(int level, double fraction) const;
+    };
+
+    namespace Characters {
+        /**
+         * @desc simulates the given number of characters of one class and
+         * Constitution modifier leveling from 1 to CHARACTER_MAX_LEVEL, using
+         * the same rules as Character::level_up(). The characters are split in
+         * to blocks spread across a thread pool; each block rolls the hit die
+         * for every character in it one level at a time, with the random
+         * engine of the thread it runs on, and keeps its own counts until the
+         * end so the threads never share a counter.
+         *
+         * @param const CharacterClass& cClass - the class to simulate
+         * @param int conMod - the Constitution modifier of every character
+         * @param uint64 samples - the number of characters to simulate
+         * @param unsigned int threads - the number of threads to use, 0 for one per core
+         *
+         * @return HitPointDistribution - the hit point totals seen at every level
+         **/
+        CHARACTER_EXPORT HitPointDistribution simulate_hit_points(const CharacterClass& cClass,
+                                                                  int conMod, uint64 samples,
+                                                                  unsigned int threads = 0);
+    }
+}
+
+#endif /* SRC_PROGRESSION_H_ */
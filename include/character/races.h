@@ -53,23 +53,28 @@ namespace ORPG {
         const uint CHARACTER_EXPORT random_race_id();
 
         /**
-         * @desc This function takes in an integer, ideally a Race::ID,
-         * creates a new Race of that ID type and returns a pointer to it. If an ID
+         * @desc This function takes in an integer, ideally a Race::ID, and
+         * returns a pointer to the shared Race registered under that ID. If an ID
          * less than 0 is passed we instead will randomly select a Race type to return.
+         *
+         * NOTE(incomingstick): every Race is immutable, so there is only ever one
+         * of each, created the first time it is asked for. Nothing is allocated
+         * here, and the returned pointer must never be deleted.
          * 
-         * @param const int identifier - the RaceID of the race to be generated
+         * @param const int identifier - the Race::ID of the race to look up
          * 
-         * @return Race* - a pointer to the newly created Race
+         * @return const Race* - a pointer to the shared Race, or nullptr if the
+         * ID is unknown
          **/
-        CHARACTER_EXPORT Race* select_race(const int identifier = -1);
+        CHARACTER_EXPORT const Race* select_race(const int identifier = -1);
 
         /**
-         * @desc This function returns a pointer to a random new Race,
+         * @desc This function returns a pointer to a random shared Race,
          * from the available races.
          *
-         * @return Race* - a pointer to a random new Race
+         * @return const Race* - a pointer to a random shared Race
          **/
-        inline CHARACTER_EXPORT Race* new_random_race() { return select_race(); };
+        inline CHARACTER_EXPORT const Race* new_random_race() { return select_race(); };
     }
 
     class CHARACTER_EXPORT Race {
@@ -87,6 +92,8 @@ namespace ORPG {
         virtual void Initialize() = 0;
 
     public:
+        virtual ~Race() {};
+
         /**
          * @desc A function that returns the Race::ID static property
          *
@@ -94,7 +101,7 @@ namespace ORPG {
          * 
          * @return const int - the ID value of the calling class
          **/
-        virtual const uint id() = 0;
+        virtual const uint id() const = 0;
 
         /**
          * @desc apply the current Race's AbilityScores to the passed set
@@ -103,14 +110,14 @@ namespace ORPG {
          * @param AbilityScores* - a pointer the base AbilityScores to
          * add to
          **/
-        virtual void applyRacialBonus(AbilityScores* base) = 0;
+        virtual void applyRacialBonus(AbilityScores* base) const = 0;
 
         /**
          * @desc A function that returns the Race as its string representation
          *
-         * @return const std::string - the string representation of a Race
+         * @return const std::string& - the string representation of a Race
          **/
-        virtual const std::string to_string() = 0;
+        virtual const std::string& to_string() const = 0;
 
         /* The const uint ID for a generic Race */
         static const uint ID = 0x1b800000;
@@ -149,7 +156,7 @@ namespace ORPG {
          * 
          * @return const int - the ID value of the calling class
          **/
-        const uint id() { return Human::ID; };
+        const uint id() const { return Human::ID; };
 
         /**
          * @desc apply the current Human's AbilityScores to the passed set
@@ -158,7 +165,7 @@ namespace ORPG {
          * @param AbilityScores* - a pointer the base AbilityScores to
          * add to
          **/
-        void applyRacialBonus(AbilityScores* base);
+        void applyRacialBonus(AbilityScores* base) const;
 
         /**
          * @desc A function that returns the Human as its string representation
@@ -166,7 +173,7 @@ namespace ORPG {
          *
          * @return const std::string - a string representation of a Human
          **/
-        const std::string to_string() { return race_str; };
+        const std::string& to_string() const { return race_str; };
 
         /* The const uint ID for a Human */
         static const uint ID = 0x1b800001;
@@ -204,7 +211,7 @@ namespace ORPG {
          * 
          * @return const int - the ID value of the calling class
          **/
-        const uint id() { return Dwarf::ID; };
+        const uint id() const { return Dwarf::ID; };
 
         /**
          * @desc apply the current Dwarf's AbilityScores to the passed set
@@ -213,7 +220,7 @@ namespace ORPG {
          * @param AbilityScores* - a pointer the base AbilityScores to
          * add to
          **/
-        void applyRacialBonus(AbilityScores* base);
+        void applyRacialBonus(AbilityScores* base) const;
 
         /**
          * @desc A function that returns the Dwarf as its string representation
@@ -221,7 +228,7 @@ namespace ORPG {
          *
          * @return const std::string - a string representation of a Dwarf
          **/
-        const std::string to_string() { return race_str; };
+        const std::string& to_string() const { return race_str; };
 
         /* The const uint ID for a Dwarf */
         static const uint ID = 0x1b800010;
@@ -248,7 +255,7 @@ namespace ORPG {
          * 
          * @return const uint - the ID value of the calling class
          **/
-        const uint id() { return HillDwarf::ID; };
+        const uint id() const { return HillDwarf::ID; };
 
         /**
          * @desc apply the current HillDwarf's AbilityScores to the passed set
@@ -257,7 +264,7 @@ namespace ORPG {
          * @param AbilityScores* - a pointer the base AbilityScores to
          * add to
          **/
-        void applyRacialBonus(AbilityScores* base);
+        void applyRacialBonus(AbilityScores* base) const;
 
         /**
          * @desc A function that returns the Hill Dwarf as its string representation
@@ -265,7 +272,7 @@ namespace ORPG {
          *
          * @return const std::string - a string representation of a Hill Dwarf
          **/
-        const std::string to_string() { return race_str; };
+        const std::string& to_string() const { return race_str; };
 
         /* The const uint ID for a HillDwarf */
         static const uint ID = 0x1b800011;
@@ -303,7 +310,7 @@ namespace ORPG {
          * 
          * @return const int - the ID value of the calling class
          **/
-        const uint id() { return Elf::ID; };
+        const uint id() const { return Elf::ID; };
 
         /**
          * @desc apply the current Elf's AbilityScores to the passed set
@@ -312,7 +319,7 @@ namespace ORPG {
          * @param AbilityScores* - a pointer the base AbilityScores to
          * add to
          **/
-        void applyRacialBonus(AbilityScores* base);
+        void applyRacialBonus(AbilityScores* base) const;
 
         /**
          * @desc A function that returns the Elf as its string representation
@@ -320,7 +327,7 @@ namespace ORPG {
          *
          * @return const std::string - a string representation of an Elf
          **/
-        const std::string to_string() { return race_str; };
+        const std::string& to_string() const { return race_str; };
 
         /* The const uint ID for an Elf */
         static const uint ID = 0x1b800020;
@@ -347,13 +354,13 @@ namespace ORPG {
          * 
          * @return const uint - the ID value of the calling class
          **/
-        const uint id() { return HighElf::ID; };
+        const uint id() const { return HighElf::ID; };
 
         /**
          * @desc apply the current HighElf's AbilityScores to the passed set
          * of AbilityScores located at the provided pointer location
          **/
-        void applyRacialBonus(AbilityScores* base);
+        void applyRacialBonus(AbilityScores* base) const;
 
         /**
          * @desc A function that returns the High Elf as its string representation.
@@ -361,7 +368,7 @@ namespace ORPG {
          *
          * @return const std::string - a string representation of a High Elf
          **/
-        const std::string to_string() { return race_str; };
+        const std::string& to_string() const { return race_str; };
 
         /* The const uint ID for a HighElf */
         static const uint ID = 0x1b800021;
@@ -0,0 +1,236 @@
+/*
+characters - roster.h
+Created on: Oct 18, 2026
+
+OpenRPG Software License - Version 1.0 - February 10th, 2017 <https://openrpg.io/about/license/>
+This is free software: you are free to change and redistribute it.
+There is NO WARRANTY, to the extent permitted by law.
+*/
+#ifndef SRC_ROSTER_H_
+#define SRC_ROSTER_H_
+
+#ifdef _WIN32
+#	include "exports/character_exports.h"
+#else
+#	define CHARACTER_EXPORT
+#endif
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "character.h"
+#include "population.h"
+
+/* the first four bytes of every roster file */
+#define ROSTER_MAGIC            "ORPR"
+
+/* the version of the roster format written by RosterWriter */
+#define ROSTER_VERSION          1
+
+namespace ORPG {
+    /**
+     * A roster file is a compact binary save of many characters. Every value
+     * is little-endian, and the file is laid out so that it can be mapped in
+     * to memory and used in place, without parsing:
+     *
+     *  [RosterHeader][RosterRecord * recordCount][string table]
+     *
+     * The string table is every name, NUL terminated, back to back. It always
+     * starts with an empty string, so a name offset of 0 means "no name".
+     **/
+    struct CHARACTER_EXPORT RosterHeader {
+        char magic[4];              // ROSTER_MAGIC
+        uint16 version;             // ROSTER_VERSION
+        uint16 headerSize;          // sizeof(RosterHeader)
+        uint32 recordCount;         // the number of RosterRecords
+        uint32 recordSize;          // sizeof(RosterRecord)
+        uint32 recordsOffset;       // where the first RosterRecord starts
+        uint32 stringsOffset;       // where the string table starts
+        uint32 stringsSize;         // the length of the string table in bytes
+        uint32 reserved;            // always 0
+    };
+
+    /**
+     * A RosterRecord is a single character within a roster file. The fields
+     * are ordered largest first, so the record has no padding and can be read
+     * directly out of the file.
+     **/
+    struct CHARACTER_EXPORT RosterRecord {
+        uint64 skillProfs;                  // 2 bits per EnumSkill, see Skill::get_prof()
+        uint32 raceID;                      // the Race::ID
+        uint32 classID;                     // the CharacterClass::ID
+        uint32 backgroundID;                // the Background::ID
+        uint32 firstName;                   // offset in to the string table
+        uint32 lastName;                    // offset in to the string table
+        int32 currHP;                       // current hit points
+        int32 maxHP;                        // maximum hit points
+        int32 tempHP;                       // temporary hit points
+        int32 exp;                          // current experience
+        uint32 languages;                   // bit N set if the Language N is known
+        uint8 scores[ABILITY_SCORE_COUNT];  // final ability scores, by EnumAbilityScore
+        uint8 saveProfs;                    // bit N set if proficient in EnumAbilityScore N saves
+        uint8 level;                        // character level, 1 - 20
+
+        /**
+         * @desc returns the proficiency level this record has in the given skill
+         *
+         * @param EnumSkill skill - the skill to query
+         *
+         * @return uint8 - the proficiency level (see Skill::get_prof())
+         **/
+        uint8 skill_prof(EnumSkill skill) const { return (skillProfs >> (2 * skill)) & 3; };
+    };
+
+    /**
+     * A RosterWriter collects characters in memory, interning their names,
+     * and writes them all out as a roster file with save().
+     **/
+    class CHARACTER_EXPORT RosterWriter {
+    private:
+        std::vector<RosterRecord> records;
+        std::string strings;
+        std::unordered_map<std::string, uint32> stringOffsets;
+
+        uint32 intern(const std::string& str);
+
+    public:
+        RosterWriter();
+
+        /**
+         * @desc returns the number of characters added so far
+         *
+         * @return size_t - the number of characters
+         **/
+        size_t size() const { return records.size(); };
+
+        /**
+         * @desc reserves space for the given number of characters
+         *
+         * @param size_t count - the number of characters to reserve space for
+         **/
+        void reserve(size_t count) { records.reserve(count); };
+
+        /**
+         * @desc adds the given Character to the roster
+         *
+         * @param Character& character - the character to add
+         **/
+        void add(Character& character);
+
+        /**
+         * @desc adds a member of a Population to the roster
+         *
+         * @param const Population& population - the population to read from
+         * @param Population::Index member - the member to add
+         **/
+        void add(const Population& population, Population::Index member);
+
+        /**
+         * @desc writes every character added so far to a roster file at path,
+         * replacing it if it exists
+         *
+         * @param const std::string& path - the file to write
+         * @param std::string* error - set to a description of the problem on
+         * failure, may be nullptr
+         *
+         * @return bool - true if the file was written
+         **/
+        bool save(const std::string& path, std::string* error = nullptr) const;
+    };
+
+    /**
+     * A RosterReader maps a roster file in to memory and hands out its records
+     * in place. Opening a file only checks the header, so it takes the same
+     * time no matter how many characters the roster holds; the pages holding
+     * the records are read in by the OS as they are touched.
+     *
+     * NOTE(incomingstick): the records are used as they are in the file, which
+     * only works on little-endian hosts. open() refuses on big-endian hosts.
+     **/
+    class CHARACTER_EXPORT RosterReader {
+    private:
+        const void* mapping;
+        size_t mappingSize;
+
+        const RosterHeader* header;
+        const RosterRecord* records;
+        const char* strings;
+
+        std::string errorStr;
+
+        bool fail(const std::string& msg);
+
+    public:
+        RosterReader();
+        ~RosterReader();
+
+        RosterReader(const RosterReader&) = delete;
+        RosterReader& operator=(const RosterReader&) = delete;
+
+        /**
+         * @desc maps the roster file at path and checks its header. Any roster
+         * that was already open is closed first.
+         *
+         * @param const std::string& path - the roster file to open
+         *
+         * @return bool - true if the file is a roster this reader understands,
+         * otherwise false, and get_error() describes why
+         **/
+        bool open(const std::string& path);
+
+        /**
+         * @desc unmaps the current roster file, if any. Any record or name
+         * handed out by this reader is no longer valid afterwards.
+         **/
+        void close();
+
+        bool is_open() const { return header != nullptr; };
+        const std::string& get_error() const { return errorStr; };
+
+        /**
+         * @desc returns the number of records in the open roster
+         *
+         * @return size_t - the number of records, 0 if nothing is open
+         **/
+        size_t size() const { return header == nullptr ? 0 : header->recordCount; };
+
+        /**
+         * @desc returns the format version of the open roster
+         *
+         * @return uint16 - the roster version, 0 if nothing is open
+         **/
+        uint16 version() const { return header == nullptr ? 0 : header->version; };
+
+        /* direct, zero-copy access to the records of the open roster */
+        const RosterRecord& operator[](size_t i) const { return records[i]; };
+        const RosterRecord* begin() const { return records; };
+        const RosterRecord* end() const { return records + size(); };
+
+        /**
+         * @desc returns the string at the given offset of the string table.
+         * Offsets outside of the table return an empty string.
+         *
+         * @param uint32 offset - the offset of the string
+         *
+         * @return const char* - the NUL terminated string, pointing in to the file
+         **/
+        const char* string_at(uint32 offset) const;
+
+        const char* first_name(size_t i) const { return string_at(records[i].firstName); };
+        const char* last_name(size_t i) const { return string_at(records[i].lastName); };
+
+        /**
+         * @desc creates a new Character from the given record. The caller owns
+         * the returned Character and must delete it.
+         *
+         * @param size_t i - the index of the record to convert
+         *
+         * @return Character* - a pointer to the new Character, nullptr if the
+         * record has an ID that does not match a known Race, class, or Background
+         **/
+        Character* to_character(size_t i) const;
+    };
+}
+
+#endif /* SRC_ROSTER_H_ */
@@ -0,0 +1,142 @@
+/*
+characters - sheet.h
+Created on: Oct 18, 2026
+
+OpenRPG Software License - Version 1.0 - February 10th, 2017 <https://openrpg.io/about/license/>
+This is free software: you are free to change and redistribute it.
+There is NO WARRANTY, to the extent permitted by law.
+*/
+#ifndef SRC_SHEET_H_
+#define SRC_SHEET_H_
+
+#ifdef _WIN32
+#	include "exports/character_exports.h"
+#else
+#	define CHARACTER_EXPORT
+#endif
+
+#include <string>
+#include <vector>
+
+#include "skills.h"
+
+/* the character sheet template used by Character::to_ascii_sheet() */
+#define ASCII_SHEET_TEMPLATE    "character_sheets/ASCII Character Sheet.txt"
+
+namespace ORPG {
+    /**
+     * An enum of every value a SheetTemplate placeholder may refer to. The
+     * name used in a template is given beside each.
+     **/
+    enum CHARACTER_EXPORT SheetField {
+        SHEET_FIRST_NAME,           // first_name
+        SHEET_LAST_NAME,            // last_name
+        SHEET_RACE,                 // race
+        SHEET_BACKGROUND,           // background
+        SHEET_CLASS,                // class
+        SHEET_LEVEL,                // level
+        SHEET_EXP,                  // exp, i.e "300/900"
+        SHEET_HP,                   // hp, i.e "7/10"
+        SHEET_PROF,                 // prof
+        SHEET_STR, SHEET_STR_MOD,   // str, str_mod
+        SHEET_DEX, SHEET_DEX_MOD,   // dex, dex_mod
+        SHEET_CON, SHEET_CON_MOD,   // con, con_mod
+        SHEET_INT, SHEET_INT_MOD,   // int, int_mod
+        SHEET_WIS, SHEET_WIS_MOD,   // wis, wis_mod
+        SHEET_CHA, SHEET_CHA_MOD,   // cha, cha_mod
+        SHEET_SKILL,                // acr, anm, ... sur, one per EnumSkill in order
+        SHEET_PASSIVE_PERCEPTION = SHEET_SKILL + SKILL_COUNT,   // passive_perception
+        SHEET_FIELD_COUNT
+    };
+
+    /**
+     * A SheetValue is the rendered text of a single SheetField. It does not
+     * own its characters, so filling in a sheet does not allocate.
+     **/
+    struct CHARACTER_EXPORT SheetValue {
+        const char* data;
+        size_t length;
+    };
+
+    /**
+     * A SheetTemplate is a character sheet layout, compiled once in to a list
+     * of literal spans and field slots so it can be rendered many times
+     * without parsing it again. Placeholders in the source look like:
+     *
+     *  {{name:width}}   the value, padded with spaces on the right to width
+     *  {{name:>width}}  the value, padded with spaces on the left to width
+     *
+     * where name is one of the names listed beside SheetField. Values longer
+     * than their width are not cut short.
+     **/
+    class CHARACTER_EXPORT SheetTemplate {
+    private:
+        struct Span {
+            uint32 offset;      // where the literal text starts in literals
+            uint32 length;      // the length of the literal text
+            int16 field;        // the SheetField that follows the text, -1 if none
+            uint16 width;       // the minimum width of the field
+            bool alignRight;    // pad the field on the left rather than the right
+        };
+
+        std::string literals;
+        std::vector<Span> spans;
+        size_t sizeHint;
+        std::string errorStr;
+
+    public:
+        SheetTemplate();
+
+        /**
+         * @desc compiles the given template source, replacing anything that
+         * was compiled before
+         *
+         * @param const std::string& source - the template text
+         *
+         * @return bool - true on success, otherwise false and get_error()
+         * describes the problem
+         **/
+        bool compile(const std::string& source);
+
+        /**
+         * @desc reads and compiles the template found at the given path
+         *
+         * @param const std::string& path - the template file to load
+         *
+         * @return bool - true on success, otherwise false and get_error()
+         * describes the problem
+         **/
+        bool load_file(const std::string& path);
+
+        const std::string& get_error() const { return errorStr; };
+
+        /**
+         * @desc returns the size of a rendered sheet when no value overflows
+         * its width, which is a good amount to reserve before render()
+         *
+         * @return size_t - the expected size of a rendered sheet in bytes
+         **/
+        size_t size_hint() const { return sizeHint; };
+
+        /**
+         * @desc appends the template to out, filling every placeholder from
+         * values. out is reserved up front, so rendering in to a reused
+         * buffer does not allocate.
+         *
+         * @param const SheetValue* values - SHEET_FIELD_COUNT values, by SheetField
+         * @param std::string& out - the buffer to append the sheet to
+         **/
+        void render(const SheetValue* values, std::string& out) const;
+    };
+
+    /**
+     * @desc returns the ASCII_SHEET_TEMPLATE from the data directory, compiled
+     * the first time it is asked for. If it could not be loaded the returned
+     * template is empty, and an error is printed to stderr once.
+     *
+     * @return const SheetTemplate& - the compiled default template
+     **/
+    CHARACTER_EXPORT const SheetTemplate& ascii_sheet_template();
+}
+
+#endif /* SRC_SHEET_H_ */
@@ -15,15 +15,20 @@ There is NO WARRANTY, to the extent permitted by law.
 #	define CHARACTER_EXPORT
 #endif
 
-#include <map>
+#include <string>
 
 #include "core/types.h"
 
+#include "ability-scores.h"
+
 #define UNPROFICIENT            0
 #define PROFICIENT              1
 #define DOUBLE_PROFICIENT       2
 #define HALF_PROFICIENT         3
 
+/* the number of entries in EnumSkill */
+#define SKILL_COUNT             18
+
 namespace ORPG {
     /**
      * An Skill represents the modifier bonus of some skill. A modifier (mod)
@@ -98,7 +103,7 @@ namespace ORPG {
          *
          * @return int8 - the modifier bonus of the queried skill
          **/
-        int8 get_mod();
+        int8 get_mod() const;
 
         /**
          * @desc Get the proficiency bonus level that is to be used when
@@ -113,7 +118,7 @@ namespace ORPG {
          * @return uint8 - the proficiency bonus level that is used when calculating
          * the amount proficiency to add to this skills modifier bonus
          **/
-        uint8 get_prof();
+        uint8 get_prof() const;
 
         /**
          * @desc Converts this Skills data to std::string format. It is retruned in the
@@ -124,7 +129,7 @@ namespace ORPG {
          *
          * @return string - a string 
          **/
-        std::string to_string();
+        std::string to_string() const;
     };
 
     /**
@@ -154,24 +159,37 @@ namespace ORPG {
     };
 
     /**
-     * Skills is a class to assist in working with the Skill class. It creates
-     * a map, pairing EnumSkill's to Skill's.
+     * the EnumAbilityScore that governs each EnumSkill, indexed by EnumSkill.
+     * i.e SKILL_ABILITY[ACR] == DEX
+     **/
+    extern const EnumAbilityScore CHARACTER_EXPORT SKILL_ABILITY[SKILL_COUNT];
+
+    /**
+     * Skills is a class to assist in working with the Skill class. It stores
+     * one Skill per EnumSkill in a flat array indexed by the enum, so it is
+     * trivially copyable and never allocates.
+     *
+     * Handing out a Skill via get() marks the bit (1 << EnumSkill) in a dirty
+     * mask, as the caller may change its proficiency.
      * 
      * This currently assumes 5e. What can we do to abstract outside of
      * that space?
      **/
     class CHARACTER_EXPORT Skills {
     private:
-        /* a std::map that maps EnumSkill's to Skill pointers */
-        std::map <EnumSkill, Skill*> skillsMap;
-        
+        /* the Skill for each EnumSkill, indexed by the enum */
+        Skill skills[SKILL_COUNT];
+
+        /* a bit per EnumSkill that may have changed since the last clear_dirty() */
+        uint32 dirty = (1 << SKILL_COUNT) - 1;
+
         /* this is a pointer to our container (likely a character, however
             we cannot assume it is) that expects a function named
             get_proficiency_bonus that returns an integer */
         void* container;
 
         /* to_string method used internally for iterative purposes */
-        static std::string internal_to_string(std::pair<EnumSkill, Skill*>);
+        static std::string internal_to_string(EnumSkill eskill, const Skill& skill);
 
     public:
         /**
@@ -191,12 +209,6 @@ namespace ORPG {
          **/
         Skills(void* owner);
 
-        /**
-         * @desc Desctructor function for the Skills class that ensures
-         * the internal std::map skillsMap is deleted
-         **/
-        ~Skills();
-
         /**
          * @desc set_owner takes a pointer to an object to set as the container,
          * as it expects access to its owners proficiency bonus via a function that
@@ -206,7 +218,8 @@ namespace ORPG {
 
         /**
          * @desc Getter function that returns a pointed to the Skill object
-         * of the given EnumSkill skill.
+         * of the given EnumSkill skill. As the pointer allows the Skill to be
+         * changed, the skill is marked dirty.
          *
          * @param EnumSkill skill - the skill to query
          *
@@ -214,7 +227,37 @@ namespace ORPG {
          * EnumSkill
          **/
         Skill* get(EnumSkill skill) {
-            return skillsMap[skill];
+            dirty |= 1 << skill;
+            return &skills[skill];
+        };
+
+        /**
+         * @desc Sets the ability modifier portion of the given skill. This is
+         * derived data, so unlike get() it does not mark the skill dirty.
+         *
+         * @param EnumSkill skill - the skill to set
+         * @param int8 mod - the new ability modifier
+         **/
+        void set_mod(EnumSkill skill, int8 mod) {
+            skills[skill].set_mod(mod);
+        };
+
+        /**
+         * @desc Accessor method for the dirty mask. Bit (1 << EnumSkill) is set
+         * for every Skill handed out by get() since the last call to clear_dirty().
+         *
+         * @return uint32 - the dirty mask
+         **/
+        uint32 dirty_mask() const {
+            return dirty;
+        };
+
+        /**
+         * @desc Clears the dirty mask. This should be called by whoever
+         * consumes the mask, once every derived value is up to date.
+         **/
+        void clear_dirty() {
+            dirty = 0;
         };
 
         /**
@@ -242,8 +285,8 @@ namespace ORPG {
          * @return uint8 - the proficiency bonus level that is used when calculating
          * the amount proficiency to add to the given skills modifier bonus
          **/
-        uint8 get_prof_bonus(EnumSkill skill) {
-            return skillsMap[skill]->get_prof();
+        uint8 get_prof_bonus(EnumSkill skill) const {
+            return skills[skill].get_prof();
         };
 
         /**
@@ -255,7 +298,7 @@ namespace ORPG {
          *
          * @return string - a string 
          **/
-        std::string to_string();
+        std::string to_string() const;
     };
 }
 
@@ -0,0 +1,80 @@
+/*
+openrpg - buffered-reader.h
+Created on: Oct 18, 2026
+
+OpenRPG Software License - Version 1.0 - February 10th, 2017 <https://openrpg.io/about/license/>
+This is free software: you are free to change and redistribute it.
+There is NO WARRANTY, to the extent permitted by law.
+ */
+#ifndef SRC_BUFFERED_READER_H_
+#define SRC_BUFFERED_READER_H_
+
+#ifdef _WIN32
+#   define WIN32_LEAN_AND_MEAN
+#   include "exports/core_exports.h"
+#else
+#   define CORE_EXPORT
+#endif
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "platform.h"
+
+namespace ORPG {
+    namespace Core {
+        /**
+         * A BufferedReader is the other half of a BufferedWriter. It pulls
+         * input from the underlying FILE in large blocks and hands it back a
+         * line at a time, without copying the line out of its buffer, so a
+         * program can work through millions of requests from a pipe.
+         *
+         * NOTE(incomingstick): a BufferedReader is not thread safe.
+         **/
+        class CORE_EXPORT BufferedReader {
+        private:
+            FILE* in;
+            std::vector<char> buffer;
+            size_t begin;       // the start of the unread bytes in buffer
+            size_t end;         // one past the last byte read in to buffer
+            bool done;          // true once in has nothing more to give
+
+        public:
+            /**
+             * @desc creates a BufferedReader that reads from the given FILE
+             *
+             * @param FILE* file - the FILE to read from, defaults to stdin
+             * @param size_t capacity - the starting size of the buffer in bytes.
+             * The buffer grows to fit any line longer than this.
+             **/
+            BufferedReader(FILE* file = stdin, size_t capacity = 1 << 16);
+
+            BufferedReader(const BufferedReader&) = delete;
+            BufferedReader& operator=(const BufferedReader&) = delete;
+
+            /**
+             * @desc finds the next line of input, without its line ending
+             * ("\n" or "\r\n"). The last line need not end in a newline.
+             *
+             * @param const char*& line - set to the start of the line. It is only
+             * valid until the next call, and is not NUL terminated.
+             * @param size_t& len - set to the length of the line
+             *
+             * @return bool - false once there are no more lines
+             **/
+            bool next_line(const char*& line, size_t& len);
+
+            /**
+             * @desc copies the next line of input in to line, see next_line()
+             *
+             * @param std::string& line - the string to copy the line in to
+             *
+             * @return bool - false once there are no more lines
+             **/
+            bool read_line(std::string& line);
+        };
+    }
+}
+
+#endif /* SRC_BUFFERED_READER_H_ */
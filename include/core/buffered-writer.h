@@ -0,0 +1,93 @@
+/*
+openrpg - buffered-writer.h
+Created on: Oct 18, 2026
+
+OpenRPG Software License - Version 1.0 - February 10th, 2017 <https://openrpg.io/about/license/>
+This is free software: you are free to change and redistribute it.
+There is NO WARRANTY, to the extent permitted by law.
+ */
+#ifndef SRC_BUFFERED_WRITER_H_
+#define SRC_BUFFERED_WRITER_H_
+
+#ifdef _WIN32
+#   define WIN32_LEAN_AND_MEAN
+#   include "exports/core_exports.h"
+#else
+#   define CORE_EXPORT
+#endif
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "platform.h"
+
+namespace ORPG {
+    namespace Core {
+        /**
+         * A BufferedWriter collects output in a fixed size buffer and hands it
+         * to the underlying FILE in large blocks, rather than one printf per
+         * line. This matters when streaming tens of thousands of records.
+         *
+         * NOTE(incomingstick): a BufferedWriter is not thread safe. Build output
+         * on the worker threads, and write it from a single thread.
+         **/
+        class CORE_EXPORT BufferedWriter {
+        private:
+            FILE* out;
+            std::vector<char> buffer;
+            size_t used;
+            size_t written;     // total bytes handed to out so far
+
+        public:
+            /**
+             * @desc creates a BufferedWriter that writes to the given FILE
+             *
+             * @param FILE* file - the FILE to write to, defaults to stdout
+             * @param size_t capacity - the size of the buffer in bytes
+             **/
+            BufferedWriter(FILE* file = stdout, size_t capacity = 1 << 16);
+
+            /**
+             * @desc flushes any remaining buffered output
+             **/
+            ~BufferedWriter();
+
+            BufferedWriter(const BufferedWriter&) = delete;
+            BufferedWriter& operator=(const BufferedWriter&) = delete;
+
+            /**
+             * @desc appends the given bytes to the buffer, flushing first if
+             * they do not fit. Writes larger than the buffer go straight out.
+             *
+             * @param const char* data - the bytes to write
+             * @param size_t len - the number of bytes to write
+             **/
+            void write(const char* data, size_t len);
+
+            /**
+             * @desc appends the given string to the buffer
+             *
+             * @param const std::string& str - the string to write
+             **/
+            void write(const std::string& str) { write(str.data(), str.size()); };
+
+            /**
+             * @desc writes everything buffered so far to the underlying FILE
+             *
+             * @return bool - false if the underlying FILE reported an error
+             **/
+            bool flush();
+
+            /**
+             * @desc returns the total number of bytes written, including
+             * anything still sitting in the buffer
+             *
+             * @return size_t - the number of bytes written
+             **/
+            size_t bytes_written() const { return written + used; };
+        };
+    }
+}
+
+#endif /* SRC_BUFFERED_WRITER_H_ */
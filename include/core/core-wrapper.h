@@ -16,6 +16,33 @@ There is NO WARRANTY, to the extent permitted by law.
 
 namespace ORPGJS {
     void ORPG_VERSION(const v8::FunctionCallbackInfo<v8::Value>& args);
+
+    /**
+     * AddonData holds everything one instance of the addon needs between
+     * calls. Node makes a new instance for every thread that loads the addon
+     * (the main thread and each worker_thread), each in its own isolate, so
+     * nothing in here is ever shared between threads. It is handed to the
+     * functions that need it as their v8::External data, and deleted when
+     * its environment shuts down.
+     **/
+    class AddonData {
+    private:
+        static void DeleteInstance(void* data);
+
+    public:
+        explicit AddonData(v8::Isolate* isolate);
+
+        v8::Global<v8::Function> dieConstructor;
+        v8::Global<v8::Function> expressionTreeConstructor;
+        v8::Global<v8::Function> nameGeneratorConstructor;
+
+        /**
+         * @desc returns the AddonData a function was made with
+         * @param const v8::FunctionCallbackInfo<v8::Value>& args - the arguments of a call
+         * @return AddonData* - the data of the addon instance the call was made in
+         **/
+        static AddonData* From(const v8::FunctionCallbackInfo<v8::Value>& args);
+    };
 }
 
 #endif /* SRC_CORE_WRAPPER_H_*/
\ No newline at end of file
@@ -31,5 +31,25 @@ void CORE_EXPORT InitPlatform();
 std::string CORE_EXPORT EXEC_PATH();
 std::string CORE_EXPORT CALL_PATH(void* func_ptr);
 
+/**
+ * @desc maps the whole of the file at path in to memory, read only. The
+ * mapping stays valid until it is passed to MEMORY_UNMAP_FILE, even after the file
+ * itself is closed.
+ *
+ * @param const std::string& path - the file to map
+ * @param size_t& size - set to the length of the mapping in bytes
+ * @return const void* - the start of the mapping, or nullptr if the file
+ * could not be mapped or is empty
+ **/
+const void* CORE_EXPORT MEMORY_MAP_FILE(const std::string& path, size_t& size);
+
+/**
+ * @desc releases a mapping returned by MEMORY_MAP_FILE
+ *
+ * @param const void* data - the start of the mapping
+ * @param size_t size - the length of the mapping in bytes
+ **/
+void CORE_EXPORT MEMORY_UNMAP_FILE(const void* data, size_t size);
+
 #endif /* _WIN32 */
 #endif /* SRC_WIN32_H_ */
@@ -0,0 +1,111 @@
+/*
+openrpg - thread-pool.h
+Created on: Oct 18, 2026
+
+OpenRPG Software License - Version 1.0 - February 10th, 2017 <https://openrpg.io/about/license/>
+This is free software: you are free to change and redistribute it.
+There is NO WARRANTY, to the extent permitted by law.
+ */
+#ifndef SRC_THREAD_POOL_H_
+#define SRC_THREAD_POOL_H_
+
+#ifdef _WIN32
+#   define WIN32_LEAN_AND_MEAN
+#   include "exports/core_exports.h"
+#else
+#   define CORE_EXPORT
+#endif
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "platform.h"
+
+namespace ORPG {
+    namespace Core {
+        /**
+         * @desc returns the number of worker threads to use when the caller
+         * asked for 0 (i.e "pick for me"). This is the hardware concurrency
+         * reported by the platform, or 1 if the platform does not know.
+         *
+         * @return unsigned int - the default number of worker threads
+         **/
+        unsigned int CORE_EXPORT default_thread_count();
+
+        /**
+         * A ThreadPool owns a fixed set of worker threads that are started once
+         * and reused for every parallel_for() call, so callers that run many small
+         * batches do not pay for thread creation each time.
+         *
+         * Work is handed out one index at a time from a shared atomic counter.
+         * Jobs of uneven cost (i.e a directory of large and small files) balance
+         * themselves across the workers without any up front partitioning.
+         *
+         * NOTE(incomingstick): parallel_for() blocks until every index has been
+         * processed, and the calling thread works through indices alongside the
+         * pool. A ThreadPool of 1 thread therefore runs everything on the caller.
+         * Only one thread may call parallel_for() on a given pool at a time.
+         **/
+        class CORE_EXPORT ThreadPool {
+        private:
+            std::vector<std::thread> workers;
+
+            std::mutex lock;
+            std::condition_variable wake;       // signaled when a new batch is posted
+            std::condition_variable done;       // signaled when a worker leaves a batch
+
+            const std::function<void(size_t)>* job;
+            size_t jobCount;
+            std::atomic<size_t> nextIndex;
+            size_t generation;                  // incremented for every posted batch
+            size_t active;                      // workers still inside the current batch
+            bool stopping;
+
+            void worker_loop();
+            void run_batch();
+
+        public:
+            /**
+             * @desc creates a pool of the given size. A size of 0 uses
+             * default_thread_count(). The calling thread counts as one of
+             * the threads, so a pool of N threads starts N - 1 workers.
+             *
+             * @param unsigned int threads - the total number of threads to use
+             **/
+            ThreadPool(unsigned int threads = 0);
+
+            /**
+             * @desc stops and joins every worker thread
+             **/
+            ~ThreadPool();
+
+            ThreadPool(const ThreadPool&) = delete;
+            ThreadPool& operator=(const ThreadPool&) = delete;
+
+            /**
+             * @desc returns the total number of threads in this pool, including
+             * the thread that calls parallel_for()
+             *
+             * @return unsigned int - the number of threads in the pool
+             **/
+            unsigned int size() const { return (unsigned int)workers.size() + 1; };
+
+            /**
+             * @desc calls job(i) once for every i in [0, count), spread across
+             * the threads of this pool. This function does not return until every
+             * call has finished. Calls may happen in any order, so job must only
+             * write to state owned by its own index.
+             *
+             * @param size_t count - the number of indices to process
+             * @param const std::function<void(size_t)>& job - the function to run per index
+             **/
+            void parallel_for(size_t count, const std::function<void(size_t)>& job);
+        };
+    }
+}
+
+#endif /* SRC_THREAD_POOL_H_ */
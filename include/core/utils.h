@@ -10,6 +10,7 @@ There is NO WARRANTY, to the extent permitted by law.
 #define SRC_UTILS_H_
 
 #include <iostream>
+#include <random>
 
 #ifdef _WIN32
 #   define WIN32_LEAN_AND_MEAN
@@ -129,6 +130,18 @@ namespace ORPG {
          **/
         std::string CORE_EXPORT rightpad(std::string str, int len = 0, char ch = ' ');
 
+        /* the pseudo random engine used throughout OpenRPG */
+        typedef std::mt19937 RandomEngine;
+
+        /**
+         * @desc returns a reference to the calling threads RandomEngine. Each
+         * thread gets its own engine, seeded once from a std::random_device the
+         * first time it is used, so threads never share state or need a lock.
+         *
+         * @return RandomEngine& - the calling threads random engine
+         **/
+        RandomEngine CORE_EXPORT & thread_engine();
+
         int CORE_EXPORT randomInt(int min, int max);
 
         bool CORE_EXPORT randomBool();
@@ -83,9 +83,9 @@ namespace ORPG {
             XMLNode(XMLDocument* doc);
 
             /**
-             * TODO doc comments
+             * @desc deletes this XMLNode along with all of its children
              **/
-            ~XMLNode();
+            virtual ~XMLNode();
 
             /**
              * @desc returns a pointer to the XMLDocument that contains this XMLNode
@@ -140,6 +140,20 @@ namespace ORPG {
              **/
             XMLNode* last_child() { return lastChild; };
 
+            /**
+             * @desc returns a pointer to the sibling XMLNode following this node
+             *
+             * @return XMLNode* - the next sibling, nullptr if this is the last child
+             **/
+            XMLNode* next_sibling() { return nextSib; };
+
+            /**
+             * @desc returns a pointer to the sibling XMLNode proceeding this node
+             *
+             * @return XMLNode* - the previous sibling, nullptr if this is the first child
+             **/
+            XMLNode* prev_sibling() { return prevSib; };
+
             /**
              * @desc adds a node into the document as the last child
              * of this XMLNode. It will return the node argument if sucessful,
@@ -354,6 +368,9 @@ namespace ORPG {
              **/
             XMLAttribute* root;
 
+            // the text found between this elements opening and closing tags
+            std::string text;
+
             /**
              * closingType allows for canonical checking of an XMLElements tag type:
              *      OPEN        i.e <foo>
@@ -389,6 +406,63 @@ namespace ORPG {
              **/
             void add_attribute(std::string name, std::string value, int line);
 
+            /**
+             * @desc returns the first attribute in this elements attribute list.
+             * Use XMLAttribute::get_next() to walk the rest of the list.
+             *
+             * @return XMLAttribute* - the first attribute, nullptr if there are none
+             **/
+            XMLAttribute* first_attribute() { return root; };
+
+            /**
+             * @desc searches this elements attribute list for the given name
+             *
+             * @param std::string name - the name of the attribute to find
+             *
+             * @return XMLAttribute* - the matching attribute, nullptr if not found
+             **/
+            XMLAttribute* find_attribute(const std::string& name);
+
+            /**
+             * @desc returns the value of the named attribute, or def if this
+             * element does not have an attribute by that name.
+             *
+             * @param std::string name - the name of the attribute to read
+             * @param std::string def - the value to return if it is missing
+             *
+             * @return std::string - the attribute value, or def
+             **/
+            std::string attribute(const std::string& name, const std::string& def = "");
+
+            /**
+             * @desc returns the text found between this elements opening and
+             * closing tags, with entities decoded. Text split up by child
+             * elements is joined together.
+             *
+             * @return std::string - the text contents of this element
+             **/
+            std::string get_text() { return text; };
+
+            /**
+             * @desc returns the first child element of this element. If a name
+             * is given, the first child element with that name is returned instead.
+             *
+             * @param std::string name - the element name to match, or empty for any
+             *
+             * @return XMLElement* - the matching child, nullptr if there is none
+             **/
+            XMLElement* first_child_element(const std::string& name = "");
+
+            /**
+             * @desc returns the next sibling element of this element. If a name
+             * is given, the next sibling element with that name is returned instead.
+             *
+             * @param std::string name - the element name to match, or empty for any
+             *
+             * @return XMLElement* - the matching sibling, nullptr if there is none
+             **/
+            XMLElement* next_sibling_element(const std::string& name = "");
+
             /**
              * TODO doc comments
              **/
@@ -407,6 +481,12 @@ namespace ORPG {
         private:
             XMLElement* root;
             int currLine = 0;
+
+            std::string errorStr;   // a description of the last load error
+            int errorLine = 0;      // the line the last load error occured on
+
+            void clear();
+            bool set_error(std::string message, int line);
         public:
             /**
              * TODO doc comments
@@ -414,14 +494,64 @@ namespace ORPG {
             XMLDocument();
 
             /**
-             * TODO doc comments
+             * @desc deletes every XMLNode owned by this document
              **/
             ~XMLDocument();
 
+            XMLDocument(const XMLDocument&) = delete;
+            XMLDocument& operator=(const XMLDocument&) = delete;
+
             /**
-             * TODO doc comments
+             * @desc reads the given file and parses it into this document. Any
+             * previously loaded content is discarded. On failure get_error() and
+             * get_error_line() describe what went wrong.
+             *
+             * @param std::string filename - the path of the file to load
+             *
+             * @return bool - true if the file was loaded and parsed, false otherwise
              **/
             bool load_file(std::string filename);
+
+            /**
+             * @desc parses the given XML string into this document. Any
+             * previously loaded content is discarded. On failure get_error() and
+             * get_error_line() describe what went wrong.
+             *
+             * @param const std::string& xml - the XML text to parse
+             *
+             * @return bool - true if the text was parsed, false otherwise
+             **/
+            bool parse(const std::string& xml);
+
+            /**
+             * @desc returns the root element of the document
+             *
+             * @return XMLElement* - the root element, nullptr if nothing is loaded
+             **/
+            XMLElement* get_root() { return root; };
+
+            /**
+             * @desc returns true if the last load or parse failed
+             *
+             * @return bool - true if there was an error, false otherwise
+             **/
+            bool has_error() { return !errorStr.empty(); };
+
+            /**
+             * @desc returns a description of the last load or parse error
+             *
+             * @return std::string - the error message, empty if there was no error
+             **/
+            std::string get_error() { return errorStr; };
+
+            /**
+             * @desc returns the line number the last load or parse error was
+             * found on. Lines start at 1, 0 means the error has no line (i.e the
+             * file could not be opened).
+             *
+             * @return int - the line of the last error
+             **/
+            int get_error_line() { return errorLine; };
         };
     }
 }
@@ -12,22 +12,24 @@ There is NO WARRANTY, to the extent permitted by law.
 #include <node.h>
 #include <node_object_wrap.h>
 
+#include "core/core-wrapper.h"
 #include "names.h"
 
 namespace ORPGJS {
     void race_is_gendered(const v8::FunctionCallbackInfo<v8::Value>& args);
     void race_has_last(const v8::FunctionCallbackInfo<v8::Value>& args);
 
+    /**
+     * Like ExpressionTreeWrapper, each NameGenerator made from JavaScript
+     * wraps a generator of its own.
+     **/
     class NameGeneratorWrapper : public ORPG::NameGenerator, public node::ObjectWrap {
         private:
-            static ORPG::NameGenerator wrappedGenerator;
-
             explicit NameGeneratorWrapper(std::string _race = "dwarf", std::string _gender = "");
             explicit NameGeneratorWrapper(std::string _race, std::string _gender, std::string _location);
             ~NameGeneratorWrapper();
 
             static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
-            static v8::Persistent<v8::Function> constructor;
 
             static void get_race(const v8::FunctionCallbackInfo<v8::Value>& args);
             static void get_gender(const v8::FunctionCallbackInfo<v8::Value>& args);
@@ -38,8 +40,16 @@ namespace ORPGJS {
             static void make_name(const v8::FunctionCallbackInfo<v8::Value>& args);
             static void make_first(const v8::FunctionCallbackInfo<v8::Value>& args);
             static void make_last(const v8::FunctionCallbackInfo<v8::Value>& args);
+
+            /**
+             * @desc makeNames(count) returns an array of count full names, made
+             * natively in one batch. Each line of a name list becomes a V8
+             * string once, internalized, and every name that uses it shares it.
+             * Throws a RangeError if count is not a whole number.
+             **/
+            static void make_names(const v8::FunctionCallbackInfo<v8::Value>& args);
         public:
-            static void Init(v8::Local<v8::Object> exports);
+            static void Init(v8::Local<v8::Object> exports, AddonData* data);
     };
 }
 
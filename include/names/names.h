@@ -15,6 +15,12 @@ There is NO WARRANTY, to the extent permitted by law.
 #   define NAMES_EXPORT
 #endif
 
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/types.h"
+
 namespace ORPG {
     namespace Names {
         /**
@@ -72,6 +78,30 @@ namespace ORPG {
      **/
     bool NAMES_EXPORT race_is_gendered(std::string race);
 
+    /**
+     * A NameBatch is many names made at once by NameGenerator::make_names().
+     * Rather than a string for every name, it holds the lists the names were
+     * drawn from and which line of each list every name used, so names that
+     * share a first or last name share its string.
+     **/
+    struct NAMES_EXPORT NameBatch {
+        std::shared_ptr<const std::vector<std::string>> firsts;   // the list the first names were drawn from
+        std::shared_ptr<const std::vector<std::string>> lasts;    // the list the last names were drawn from
+        std::vector<uint32> first;  // the line of firsts each name used, empty if firsts was empty
+        std::vector<uint32> last;   // the line of lasts each name used, empty if lasts was empty
+        size_t count;               // the number of names
+
+        size_t size() const { return count; };
+
+        /**
+         * @desc puts name n together the same way make_name() does
+         *
+         * @param size_t n - the name to put together, less than size()
+         * @return std::string - the full name
+         **/
+        std::string name(size_t n) const;
+    };
+
     /**
      * A NameGenerator allows for the random generation of names. A name is
      * determined by a given race and optionally a gender and produces a name
@@ -111,6 +141,12 @@ namespace ORPG {
          * NameGenerator to ensure we conform to the naming of know races
          **/
         void Initialize();
+
+        /* the list make_first() draws from, choosing a gender first if it must */
+        std::string first_list();
+
+        /* the list make_last() draws from, empty if the race has no last names */
+        std::string last_list();
     public:
         /**
          * @desc Constructor for NameGenerator that is passed two optional
@@ -217,6 +253,17 @@ namespace ORPG {
          * produced it will return an empty string.
          **/
         std::string make_last();
+
+        /**
+         * @desc Generates count full names at once. Each list is looked up
+         * only once for the whole batch, and every name is just a pair of
+         * random lines, so this is much cheaper than calling make_name()
+         * count times.
+         *
+         * @param size_t count - the number of names to generate
+         * @return NameBatch - the names, see NameBatch::name()
+         **/
+        NameBatch make_names(size_t count);
     };
 }
 
@@ -10,5 +10,6 @@ There is NO WARRANTY, to the extent permitted by law.
 #define ROLL_H
 
 #include "roll/roll-parser.h"
+#include "roll/expression-cache.h"
 
 #endif /* ROLL_H */
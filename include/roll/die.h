@@ -36,17 +36,21 @@ namespace ORPG {
             /**
              * @desc randomly generate an int between 1 and _MAX, where MAX is the value
              * that was passed to the Die when it was constructed. The result is generated
-             * by using a random_device to seed a Mersenne Twister engine that generates 
-             * uniformly distributed integers between 1 and _MAX.
-             * between 1 and _MAX
+             * by the calling threads Mersenne Twister engine (see Utils::thread_engine)
+             * as uniformly distributed integers between 1 and _MAX.
              * @return int - a pesudo random integer between 1 and _MAX
              */
-            int roll() {
-                std::random_device rd;
-                std::mt19937 mt(rd());
+            int roll() const { return roll(Utils::thread_engine()); }
+
+            /**
+             * @desc the same as roll(), but drawing from the given engine
+             * @param Utils::RandomEngine& engine - the engine to roll with
+             * @return int - a pesudo random integer between 1 and _MAX
+             */
+            int roll(Utils::RandomEngine& engine) const {
                 std::uniform_int_distribution<int> dist(1, _MAX);
 
-                auto ret = dist(mt);
+                auto ret = dist(engine);
 
                 /* verbosely prints die rolls in the form "dX -> N" */
                 if(Core::VB_FLAG) printf("d%i -> %i\n", _MAX, ret);
@@ -59,7 +63,7 @@ namespace ORPG {
              * the max value that could potentially be rolled.
              * @return int - the maximum value that could be returned by this die
              */
-            const int MAX() { return _MAX; }
+            const int MAX() const { return _MAX; }
     };
 }
 
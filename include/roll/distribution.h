@@ -0,0 +1,95 @@
+/*
+roll - distribution.h
+Created on: Oct 18, 2026
+
+OpenRPG Software License - Version 1.0 - February 10th, 2017 <https://openrpg.io/about/license/>
+This is free software: you are free to change and redistribute it.
+There is NO WARRANTY, to the extent permitted by law.
+*/
+#ifndef SRC_DISTRIBUTION_H_
+#define SRC_DISTRIBUTION_H_
+
+#ifdef _WIN32
+#   include "roll/exports/parser_exports.h"
+#else
+#   define ROLL_PARSER_EXPORT
+#endif
+
+#include <vector>
+
+namespace ORPG {
+    /**
+     * A Distribution is the chance of every total a roll can come up with.
+     * probability[n] is the chance of rolling lowest + n, so a 2d6 has a
+     * lowest of 2 and 11 probabilities.
+     **/
+    struct ROLL_PARSER_EXPORT Distribution {
+        int lowest;                         // the lowest total that can be rolled
+        std::vector<double> probability;    // the chance of each total, from lowest up
+
+        /**
+         * @desc returns the highest total that can be rolled
+         *
+         * @return int - the highest total
+         **/
+        int highest() const { return lowest + (int)probability.size() - 1; };
+
+        /**
+         * @desc returns the chance of rolling exactly the given total
+         *
+         * @param int total - the total to query
+         *
+         * @return double - the chance of the total, 0.0 - 1.0
+         **/
+        double chance(int total) const;
+
+        /**
+         * @desc returns the chance of rolling the given total or higher
+         *
+         * @param int total - the total to query
+         *
+         * @return double - the chance of meeting or beating the total, 0.0 - 1.0
+         **/
+        double at_least(int total) const;
+
+        double mean() const;
+        double stddev() const;
+    };
+
+    namespace Roll {
+        /**
+         * @desc computes exactly how the sum of the highest keep of dice
+         * sides-sided dice, plus bonus, is distributed. i.e (4, 6, 3, 0) is
+         * 4d6 drop the lowest, and (2, 6, 2, 6) is 2d6+6.
+         *
+         * Rather than walk every one of the sides^dice outcomes, this walks each
+         * way of sorting the dice into faces once and weighs it by how many
+         * outcomes sort that way, so 4d6 takes 126 steps rather than 1296.
+         *
+         * @param int dice - the number of dice rolled, at least 1
+         * @param int sides - the number of sides on each die, at least 2
+         * @param int keep - the number of highest dice kept, 1 - dice
+         * @param int bonus - added to the kept dice
+         *
+         * @return Distribution - the chance of every total
+         **/
+        ROLL_PARSER_EXPORT Distribution keep_highest(int dice, int sides, int keep, int bonus = 0);
+
+        /**
+         * @desc computes exactly how the sum of dice sides-sided dice, plus
+         * bonus, is distributed. i.e (3, 6, 0) is 3d6. This is the same as
+         * keeping every die, but adds one die at a time with a running sum over
+         * the last sides totals, so 100d100 takes about a million steps rather
+         * than walking every way of sorting the dice.
+         *
+         * @param int dice - the number of dice rolled, at least 1
+         * @param int sides - the number of sides on each die, at least 2
+         * @param int bonus - added to the dice
+         *
+         * @return Distribution - the chance of every total
+         **/
+        ROLL_PARSER_EXPORT Distribution dice_sum(int dice, int sides, int bonus = 0);
+    }
+}
+
+#endif /* SRC_DISTRIBUTION_H_ */
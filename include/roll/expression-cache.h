@@ -0,0 +1,126 @@
+/*
+roll - expression-cache.h
+Created on: Oct 18, 2026
+
+OpenRPG Software License - Version 1.0 - February 10th, 2017 <https://openrpg.io/about/license/>
+This is free software: you are free to change and redistribute it.
+There is NO WARRANTY, to the extent permitted by law.
+*/
+#ifndef SRC_EXPRESSION_CACHE_H_
+#define SRC_EXPRESSION_CACHE_H_
+
+#ifdef _WIN32
+#   include "roll/exports/parser_exports.h"
+#else
+#   define ROLL_PARSER_EXPORT
+#endif
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "core/types.h"
+#include "roll/expression.h"
+
+/* the most parsed expressions ExpressionCache::shared() holds at once */
+#define EXPRESSION_CACHE_CAPACITY   4096
+
+/* the number of independently locked pieces a cache is split in to */
+#define EXPRESSION_CACHE_SHARDS     16
+
+namespace ORPG {
+    /**
+     * An ExpressionCache maps roll expressions to compiled Expressions, so an
+     * expression that comes up again is not parsed again. Expressions are
+     * normalized first (see normalize()), so "1d20 + 5" and "1d20+5" share one.
+     *
+     * The cache is split in to shards by the hash of the expression, each
+     * with its own lock and least recently used list, so threads rolling
+     * different expressions rarely wait on each other. Once a shard is full
+     * its least recently used Expression is dropped; anyone still holding it
+     * keeps it alive until they are done.
+     **/
+    class ROLL_PARSER_EXPORT ExpressionCache {
+    private:
+        typedef std::shared_ptr<const Expression> Entry;
+        typedef std::list<std::pair<std::string, Entry>> Order;
+
+        struct Shard {
+            std::mutex lock;
+            Order order;                                                // most recently used first
+            std::unordered_map<std::string, Order::iterator> index;     // where each expression is in order
+            uint64 hits = 0;
+            uint64 misses = 0;
+        };
+
+        std::unique_ptr<Shard[]> shards;
+        size_t shardCount;
+        size_t shardCapacity;
+
+        Shard& shard_for(const std::string& key) const;
+
+    public:
+        /**
+         * @desc creates an empty cache
+         *
+         * @param size_t capacity - the most Expressions to hold, spread evenly over the shards
+         * @param size_t shards - the number of independently locked shards
+         **/
+        ExpressionCache(size_t capacity = EXPRESSION_CACHE_CAPACITY,
+                        size_t shards = EXPRESSION_CACHE_SHARDS);
+
+        ExpressionCache(const ExpressionCache&) = delete;
+        ExpressionCache& operator=(const ExpressionCache&) = delete;
+
+        /**
+         * @desc returns the compiled form of an expression, parsing it only if
+         * it is not already held. Expressions that do not parse are not held.
+         *
+         * @param const std::string& exp - the expression to look up
+         *
+         * @return std::shared_ptr<const Expression> - the expression, or nullptr
+         * if exp is not a valid expression
+         **/
+        std::shared_ptr<const Expression> get(const std::string& exp);
+
+        /**
+         * @desc drops every Expression held by the cache, and resets the counters
+         **/
+        void clear();
+
+        /* the number of lookups that found an Expression, and that had to parse one */
+        uint64 hits() const;
+        uint64 misses() const;
+
+        /* the number of Expressions held, and the most that can be */
+        size_t size() const;
+        size_t capacity() const { return shardCount * shardCapacity; };
+
+        /**
+         * @desc returns the key an expression is cached under: the expression
+         * with whitespace between tokens removed, and every '[' or '{' written as '(' and
+         * ']' or '}' as ')'. The parser treats all of these the same, so long as
+         * each group closes the way it opened; if one does not, the brackets are
+         * left as they are so the expression still fails to parse. Whitespace
+         * that splits what would otherwise be one token, i.e "1 2" or "> =",
+         * is kept as a single space, so those fail to parse as well.
+         *
+         * @param const std::string& exp - the expression to normalize
+         *
+         * @return std::string - the normalized expression
+         **/
+        static std::string normalize(const std::string& exp);
+
+        /**
+         * @desc returns the cache shared by everything in this process, which
+         * is what the REPL, roll, orpgd, and the Node and C APIs parse through
+         *
+         * @return ExpressionCache& - the shared cache
+         **/
+        static ExpressionCache& shared();
+    };
+}
+
+#endif /* SRC_EXPRESSION_CACHE_H_ */
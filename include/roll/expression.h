@@ -0,0 +1,145 @@
+/*
+roll - expression.h
+Created on: Oct 18, 2026
+
+OpenRPG Software License - Version 1.0 - February 10th, 2017 <https://openrpg.io/about/license/>
+This is free software: you are free to change and redistribute it.
+There is NO WARRANTY, to the extent permitted by law.
+*/
+#ifndef SRC_EXPRESSION_H_
+#define SRC_EXPRESSION_H_
+
+#ifdef _WIN32
+#   include "roll/exports/parser_exports.h"
+#else
+#   define ROLL_PARSER_EXPORT
+#endif
+
+#include <string>
+#include <vector>
+
+#include "core/types.h"
+#include "core/utils.h"
+#include "roll/distribution.h"
+
+/* the most times a reroll whose chances can not be worked out rolls again */
+#define EXPRESSION_REROLL_LIMIT     10000
+
+/* the most dice a single evaluation may roll, counting every reroll it may try */
+#define EXPRESSION_MAX_DICE         (1 << 20)
+
+/* the most sides a die may have */
+#define EXPRESSION_MAX_SIDES        (1 << 20)
+
+/* the deepest an expression may nest, so parsing and rolling it can not overflow the stack */
+#define EXPRESSION_MAX_DEPTH        256
+
+namespace ORPG {
+    /**
+     * An Expression is a roll expression that has been parsed and compiled,
+     * ready to be rolled. It holds nothing but the compiled expression, laid
+     * out flat in one array, and never changes once made: evaluate() is const
+     * and draws every die from the engine it is given. Any number of threads
+     * may evaluate one Expression at once, each with its own engine, with no
+     * locking.
+     *
+     * Expressions are made by parsing, see Expression::parse() and
+     * ExpressionTree::compile(), and shared through ExpressionCache.
+     *
+     * A reroll (>, >=, <, <=, or !) keeps rolling its left side until the
+     * result meets the limit on its right. Where the chance of every result of
+     * the left side can be worked out when the Expression is made, i.e 1d100>98
+     * or 4d6h3>=8, the result is drawn straight from the totals that meet the
+     * limit instead, with one random number rather than ~50 rolls. A reroll
+     * that can never be met fails to parse, and any other is retried at most
+     * EXPRESSION_REROLL_LIMIT times, or fewer if those tries would roll more
+     * than EXPRESSION_MAX_DICE dice. A reroll that runs out of tries evaluates
+     * to 0, the same as an error node, never to a result that breaks its limit.
+     *
+     * An Expression that could roll more than EXPRESSION_MAX_DICE dice in one
+     * evaluation, or a die with more than EXPRESSION_MAX_SIDES sides, fails to
+     * parse, so no input can make evaluate() run for ever or exhaust memory.
+     **/
+    class ROLL_PARSER_EXPORT Expression {
+    public:
+        /* a single operation of the expression, in the same terms as a parse_node */
+        struct Node {
+            short int op;       // node type, one of the OP_ defines in roll-parser.h
+            int value;          // node value
+            int32 left;         // index of the left operand in nodes, -1 for none
+            int32 right;        // index of the right operand in nodes, -1 for none
+            int32 table;        // index in to tables a reroll draws from, -1 to roll it out
+            int32 tries;        // the most times a reroll rolls again before giving up
+        };
+
+    private:
+        /* every total the left side of a reroll can come up with, to draw from */
+        struct Table {
+            int lowest;                 // the lowest total
+            std::vector<double> cdf;    // cdf[n] is the chance of lowest + n or less
+        };
+
+        std::vector<Node> nodes;    // nodes[0] is the top of the expression
+        std::vector<Table> tables;  // see Node::table
+        std::string text;           // the expression this was parsed from
+
+        int evaluate_node(int32 index, Utils::RandomEngine& engine) const;
+        int reroll(const Node& curr, Utils::RandomEngine& engine) const;
+
+        bool distribution_of(int32 index, Distribution& out) const;
+        bool prepare();
+        bool budget();
+
+        friend class ExpressionTree;
+
+    public:
+        /**
+         * @desc makes an empty Expression, which always evaluates to 0
+         **/
+        Expression() = default;
+
+        /**
+         * @desc parses exp in to an Expression. The parser is only needed while
+         * parsing, so none of its state is kept.
+         *
+         * @param const std::string& exp - the expression to parse, i.e "4d6h3"
+         * @param Expression& out - set to the parsed expression if it is valid
+         *
+         * @return bool - false if exp is not a valid expression
+         **/
+        static bool parse(const std::string& exp, Expression& out);
+
+        /**
+         * @desc rolls the expression once
+         *
+         * @param Utils::RandomEngine& engine - the engine every die is drawn from
+         *
+         * @return int - the result of the expression
+         **/
+        int evaluate(Utils::RandomEngine& engine) const {
+            return nodes.empty() ? 0 : evaluate_node(0, engine);
+        };
+
+        /**
+         * @desc rolls the expression once with the calling threads engine
+         * (see Utils::thread_engine)
+         *
+         * @return int - the result of the expression
+         **/
+        int evaluate() const { return evaluate(Utils::thread_engine()); };
+
+        /**
+         * @desc returns the expression this was parsed from
+         * @return const std::string& - the expression
+         **/
+        const std::string& get_input_string() const { return text; };
+
+        /**
+         * @desc returns the number of operations in the compiled expression
+         * @return size_t - the number of nodes
+         **/
+        size_t size() const { return nodes.size(); };
+    };
+}
+
+#endif /* SRC_EXPRESSION_H_ */
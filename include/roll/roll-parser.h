@@ -15,7 +15,12 @@ There is NO WARRANTY, to the extent permitted by law.
 #   define ROLL_PARSER_EXPORT
 #endif
 
+#include <memory>
+#include <string>
+#include <vector>
+
 #include "roll/die.h"
+#include "roll/expression.h"
 
 #define FUDGE_DIE       -2 // represents a fudge die
 
@@ -75,24 +80,47 @@ namespace ORPG {
         int value;                  // node value
     };
 
+    /**
+     * An ExpressionTree is a roll expression parsed in to a tree of parse_nodes.
+     * The tree owns every node it allocates, and frees them when it is
+     * destroyed or given a new expression.
+     *
+     * The tree is the parser. To roll a parsed expression many times, or from
+     * many threads, compile() it in to an Expression and drop the tree.
+     **/
     class ROLL_PARSER_EXPORT ExpressionTree {
     private:
+        /* the lexer and precedence climbing parser behind build_expression_tree(),
+            only defined in roll-parser.cpp */
+        class Parser;
+
         parse_node* allocate_node();
-        parse_node* new_number(struct parse_node* cur, int* numBytesToRead = 0);
-        parse_node* new_op(struct parse_node* cur, short int op);
-        parse_node* new_die(struct parse_node* cur);
         parse_node* node_error(struct parse_node* node);
         
-        int parse_input_string(std::string* buff, int* numBytesRead, int maxBytesToRead);
-        int parse_tree(struct parse_node* node);
         bool build_expression_tree();
+        bool compile_expression();
+        int32 compile_node(const struct parse_node* node);
         
-        std::string tree_string(struct parse_node* node, int indent, std::string pre = "head->");
-        
-        int globalReadOffset = 0;
+        std::string tree_string(struct parse_node* node, int indent, std::string pre = "head->") const;
+
+        /* every node allocate_node() has made, so a half built tree is freed
+            along with a finished one. The first used of them make up the current
+            expression, and the rest are kept to be reused by the next one */
+        std::vector<std::unique_ptr<parse_node>> nodes;
+        size_t used = 0;
+
         struct parse_node* head = allocate_node();
         std::string inputString = "1d20";
+
+        /* the current expression compiled, which is what parse_expression() rolls */
+        Expression compiled;
     public:
+        ExpressionTree() = default;
+
+        /* the nodes belong to a single tree, so it may not be copied */
+        ExpressionTree(const ExpressionTree&) = delete;
+        ExpressionTree& operator=(const ExpressionTree&) = delete;
+
         /**
          * @desc sets the input string to be scanned and parsed equal to the string exp
          * @param const std::string exp - the string to become the input string
@@ -100,10 +128,17 @@ namespace ORPG {
         bool set_expression(const std::string exp);
         
         /**
-         * @desc parses the parse_node tree and returns the end result of the expression
+         * @desc rolls the current expression and returns the end result
          * @return int - the end result of the expression
          */
-        int parse_expression() { return parse_tree(head); };
+        int parse_expression() const { return compiled.evaluate(); };
+
+        /**
+         * @desc returns the current expression compiled in to an Expression,
+         * which holds none of the parsers state and may be shared between threads
+         * @return Expression - the compiled expression, empty if none is set
+         */
+        Expression compile() const { return compiled; };
         
         /**
          * @desc outputs an error with ERROR_CODE if there
@@ -112,7 +147,7 @@ namespace ORPG {
          * @param int op2 - an integer to be added
          * @return int - op1 + op2
          */
-        int checked_sum(int op1, int op2);
+        int checked_sum(int op1, int op2) const;
 
         /**
          * @desc outputs an error with ERROR_CODE if there
@@ -121,14 +156,14 @@ namespace ORPG {
          * @param int op2 - an integer to be multiply by
          * @return int - op1 * op2
          */
-        int checked_multiplication(int op1, int op2);
+        int checked_multiplication(int op1, int op2) const;
         
         /**
          * @desc returns a string of the tree starting with
          *     the top node node and taking precidence over the left node
          * @return string - a string representation of the current tree
          */
-        std::string to_string() { 
+        std::string to_string() const { 
             if(head->op == 0) {
                 return "expression not yet set";
             }
@@ -144,7 +179,7 @@ namespace ORPG {
          * @desc returns the input string that was give to the parser
          * @return string - the string that was give as input to the parser
          */
-        std::string get_input_string() { return inputString; }
+        std::string get_input_string() const { return inputString; }
 
         // TODO sanatize input - lets not get people (or ourselves) hacked!
         static bool is_expression_valid(const std::string exp);
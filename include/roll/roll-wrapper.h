@@ -12,6 +12,7 @@ There is NO WARRANTY, to the extent permitted by law.
 #include <node.h>
 #include <node_object_wrap.h>
 
+#include "core/core-wrapper.h"
 #include "roll.h"
 
 namespace ORPGJS {
@@ -21,21 +22,22 @@ namespace ORPGJS {
             ~DieWrapper();
 
             static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
-            static v8::Persistent<v8::Function> constructor;
 
             static void roll(const v8::FunctionCallbackInfo<v8::Value>& args);
 
             static void MAX(const v8::FunctionCallbackInfo<v8::Value>& args);
         public:
-            static void Init(v8::Local<v8::Object> exports);
+            static void Init(v8::Local<v8::Object> exports, AddonData* data);
     };
 
+    /**
+     * Each ExpressionTree made from JavaScript wraps a tree of its own, so
+     * trees never see each others expressions, and trees made on different
+     * worker_threads never touch the same memory.
+     **/
     class ExpressionTreeWrapper : public ORPG::ExpressionTree, public node::ObjectWrap {
     private:
-        static ORPG::ExpressionTree wrappedTree;
-
         static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
-        static v8::Persistent<v8::Function> constructor;
 
         /**
          * @desc sets the input string to be scanned and parsed equal to the string exp
@@ -67,8 +69,26 @@ namespace ORPGJS {
 
         static void is_exppression_valid(const v8::FunctionCallbackInfo<v8::Value>& args);
     public:
-        static void Init(v8::Local<v8::Object> exports);
+        static void Init(v8::Local<v8::Object> exports, AddonData* data);
     };
+
+    /**
+     * @desc rollMany(expression, count) rolls a roll expression count times on
+     * a libuv worker thread, so the event loop is free while it runs. It
+     * returns a Promise for an Int32Array of every result, backed by the memory
+     * they were rolled into rather than a copy of it. The Promise is rejected
+     * if the expression does not parse or count is not a whole number.
+     **/
+    void roll_many(const v8::FunctionCallbackInfo<v8::Value>& args);
+
+    /**
+     * @desc simulate(expression, trials) rolls a roll expression trials times on
+     * a libuv worker thread, like rollMany(), but only keeps how often each
+     * total came up. It returns a Promise for an object with the lowest total,
+     * a Float64Array of counts starting at that total, the number of trials,
+     * and their mean.
+     **/
+    void simulate(const v8::FunctionCallbackInfo<v8::Value>& args);
 }
 
 #endif /* SRC_DIE_WRAPPER_H_*/
@@ -0,0 +1,258 @@
+/*
+capi - orpg.cpp
+Created on: Oct 18, 2026
+
+OpenRPG Software License - Version 1.0 - February 10th, 2017 <https://openrpg.io/about/license/>
+This is free software: you are free to change and redistribute it.
+There is NO WARRANTY, to the extent permitted by law.
+*/
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <string>
+
+#include "core/config.h"
+#include "core/utils.h"
+#include "character/character.h"
+#include "character/ability-generation.h"
+#include "names/names.h"
+#include "roll/expression-cache.h"
+#include "roll/roll-parser.h"
+
+#include "capi/orpg.h"
+
+using namespace std;
+using namespace ORPG;
+
+/**
+ * The handles handed out by the C API. They are only ever seen as opaque
+ * pointers on the other side, so what they hold is free to change.
+ **/
+struct orpg_roll {
+    shared_ptr<const Expression> expression;    // shared with ExpressionCache::shared()
+};
+
+struct orpg_names {
+    NameGenerator generator;
+
+    orpg_names(const string& race, const string& gender, const string& location):
+        generator(race, gender, location) {}
+};
+
+/* why the last call on this thread failed, see orpg_last_error() */
+static thread_local string LAST_ERROR;
+
+/* records why a call failed and returns status, so failures read as one line */
+static int fail(int status, const string& why) {
+    LAST_ERROR = why;
+
+    return status;
+}
+
+/* writes str in to out snprintf() style, returning the length of str */
+static int write_string(const string& str, char* out, size_t size) {
+    if(size > 0) {
+        const size_t len = min(str.size(), size - 1);
+
+        memcpy(out, str.data(), len);
+        out[len] = '\0';
+    }
+
+    return (int)min<size_t>(str.size(), INT32_MAX);
+}
+
+/*
+ * Nothing may throw across the C boundary, so every entry point that could
+ * allocate catches and reports failure instead.
+ */
+extern "C" {
+    const char* orpg_version(void) {
+        return VERSION;
+    }
+
+    int orpg_api_version(void) {
+        return ORPG_C_API_VERSION;
+    }
+
+    const char* orpg_last_error(void) {
+        return LAST_ERROR.c_str();
+    }
+
+    orpg_roll* orpg_roll_compile(const char* expression) {
+        if(expression == nullptr) {
+            fail(ORPG_ERROR_ARGUMENT, "orpg_roll_compile: expression is NULL");
+            return nullptr;
+        }
+
+        try {
+            auto compiled = ExpressionCache::shared().get(expression);
+
+            if(compiled == nullptr) {
+                fail(ORPG_ERROR_EXPRESSION, string("Invalid expression - ") + expression);
+                return nullptr;
+            }
+
+            return new orpg_roll{ compiled };
+        } catch(const exception& e) {
+            fail(ORPG_ERROR_ARGUMENT, e.what());
+            return nullptr;
+        }
+    }
+
+    void orpg_roll_free(orpg_roll* roll) {
+        delete roll;
+    }
+
+    int orpg_roll_eval(orpg_roll* roll, int32_t* out) {
+        return orpg_roll_eval_batch(roll, out, 1);
+    }
+
+    int orpg_roll_eval_batch(orpg_roll* roll, int32_t* out, size_t count) {
+        if(roll == nullptr || (out == nullptr && count > 0)) {
+            return fail(ORPG_ERROR_ARGUMENT, "orpg_roll_eval_batch: roll or out is NULL");
+        }
+
+        try {
+            Utils::RandomEngine& engine = Utils::thread_engine();
+
+            for(size_t i = 0; i < count; i++) out[i] = roll->expression->evaluate(engine);
+        } catch(const bad_alloc&) {
+            return fail(ORPG_ERROR_MEMORY, "orpg_roll_eval_batch: out of memory");
+        } catch(const exception& e) {
+            return fail(ORPG_ERROR_ARGUMENT, e.what());
+        }
+
+        return ORPG_OK;
+    }
+
+    orpg_names* orpg_names_create(const char* race, const char* gender, const char* data_dir) {
+        if(race == nullptr) {
+            fail(ORPG_ERROR_ARGUMENT, "orpg_names_create: race is NULL");
+            return nullptr;
+        }
+
+        try {
+            const string location = data_dir == nullptr ? Core::DATA_LOCATION() : string(data_dir);
+
+            return new orpg_names(race, gender == nullptr ? "" : gender, location);
+        } catch(const exception& e) {
+            fail(ORPG_ERROR_ARGUMENT, e.what());
+            return nullptr;
+        }
+    }
+
+    void orpg_names_free(orpg_names* names) {
+        delete names;
+    }
+
+    int orpg_names_make(orpg_names* names, char* out, size_t size) {
+        if(names == nullptr || (out == nullptr && size > 0)) {
+            return fail(ORPG_ERROR_ARGUMENT, "orpg_names_make: names or out is NULL");
+        }
+
+        try {
+            return write_string(names->generator.make_name(), out, size);
+        } catch(const exception& e) {
+            return fail(ORPG_ERROR_ARGUMENT, e.what());
+        }
+    }
+
+    int64_t orpg_names_make_batch(orpg_names* names, size_t count, char* out, size_t size, size_t* offsets) {
+        if(names == nullptr || (count > 0 && offsets == nullptr) || (out == nullptr && size > 0)) {
+            return fail(ORPG_ERROR_ARGUMENT, "orpg_names_make_batch: names, out, or offsets is NULL");
+        }
+
+        try {
+            NameBatch batch = names->generator.make_names(count);
+
+            // size everything up first, so a short buffer is left untouched
+            size_t needed = 0;
+
+            for(size_t n = 0; n < batch.size(); n++) {
+                if(!batch.first.empty()) needed += (*batch.firsts)[batch.first[n]].size();
+                if(!batch.last.empty()) needed += 1 + (*batch.lasts)[batch.last[n]].size();
+
+                needed++;
+            }
+
+            if(needed > size) return (int64_t)needed;
+
+            size_t pos = 0;
+
+            for(size_t n = 0; n < batch.size(); n++) {
+                offsets[n] = pos;
+
+                if(!batch.first.empty()) {
+                    const string& first = (*batch.firsts)[batch.first[n]];
+
+                    memcpy(out + pos, first.data(), first.size());
+                    pos += first.size();
+                }
+
+                if(!batch.last.empty()) {
+                    const string& last = (*batch.lasts)[batch.last[n]];
+
+                    out[pos++] = ' ';
+                    memcpy(out + pos, last.data(), last.size());
+                    pos += last.size();
+                }
+
+                out[pos++] = '\0';
+            }
+
+            return (int64_t)needed;
+        } catch(const exception& e) {
+            return fail(ORPG_ERROR_ARGUMENT, e.what());
+        }
+    }
+
+    int orpg_character_generate(orpg_format format, char* out, size_t size) {
+        if(out == nullptr && size > 0) {
+            return fail(ORPG_ERROR_ARGUMENT, "orpg_character_generate: out is NULL");
+        }
+
+        if(format != ORPG_FORMAT_TEXT && format != ORPG_FORMAT_JSON && format != ORPG_FORMAT_SHEET) {
+            return fail(ORPG_ERROR_FORMAT, "Unknown format - " + to_string((int)format) +
+                                           " (expects ORPG_FORMAT_TEXT, ORPG_FORMAT_JSON, or ORPG_FORMAT_SHEET)");
+        }
+
+        try {
+            unique_ptr<Character> character(Characters::new_random_character());
+            string str;
+
+            if(format == ORPG_FORMAT_JSON) str = character->to_json();
+            else if(format == ORPG_FORMAT_SHEET) character->to_ascii_sheet(str);
+            else str = character->to_string();
+
+            return write_string(str, out, size);
+        } catch(const exception& e) {
+            return fail(ORPG_ERROR_ARGUMENT, e.what());
+        }
+    }
+
+    int orpg_scores_generate(const char* method, size_t count, uint8_t* out) {
+        if(method == nullptr || (out == nullptr && count > 0)) {
+            return fail(ORPG_ERROR_ARGUMENT, "orpg_scores_generate: method or out is NULL");
+        }
+
+        try {
+            ScoreMethod scoreMethod(method);
+
+            if(!scoreMethod.is_valid()) return fail(ORPG_ERROR_EXPRESSION, scoreMethod.get_error());
+
+            ScoreColumns columns = scoreMethod.generate(count);
+
+            for(size_t n = 0; n < count; n++) {
+                for(int ability = 0; ability < ABILITY_SCORE_COUNT; ability++) {
+                    out[n * ABILITY_SCORE_COUNT + ability] = columns.scores[ability][n];
+                }
+            }
+
+            return ORPG_OK;
+        } catch(const exception& e) {
+            return fail(ORPG_ERROR_ARGUMENT, e.what());
+        }
+    }
+}
@@ -0,0 +1,347 @@
+/*
+characters - ability-generation.cpp
+Created on: Oct 18, 2026
+
+OpenRPG Software License - Version 1.0 - February 10th, 2017 <https://openrpg.io/about/license/>
+This is free software: you are free to change and redistribute it.
+There is NO WARRANTY, to the extent permitted by law.
+*/
+#include <algorithm>
+#include <cctype>
+#include <memory>
+#include <random>
+#include <unordered_map>
+
+#include "core/thread-pool.h"
+#include "core/utils.h"
+#include "roll/expression-cache.h"
+#include "roll/roll-parser.h"
+#include "character/checks.h"
+#include "character/ability-generation.h"
+
+/* the number of characters each block of generate() rolls side by side */
+#define SCORE_BLOCK_SIZE        4096
+
+/* the most dice the DICE_SCORES kernel will roll for a single score */
+#define SCORE_MAX_DICE          16
+
+using namespace std;
+
+namespace ORPG {
+    /* the scores the standard array deals out */
+    static const uint8 STANDARD_ARRAY_SCORES[ABILITY_SCORE_COUNT] = { 15, 14, 13, 12, 10, 8 };
+
+    const int POINT_BUY_COST[POINT_BUY_MAX - POINT_BUY_MIN + 1] = { 0, 1, 2, 3, 4, 5, 7, 9 };
+
+    /* reads an unsigned number from str at pos, returning -1 if there is none */
+    static int read_number(const string& str, size_t& pos) {
+        if(pos >= str.size() || !isdigit(str[pos])) return -1;
+
+        int ret = 0;
+
+        while(pos < str.size() && isdigit(str[pos]) && ret < 10000) {
+            ret = ret * 10 + (str[pos] - '0');
+            pos++;
+        }
+
+        return ret;
+    }
+
+    ScoreMethod::ScoreMethod(const string& methodStr): method(EXPRESSION_SCORES), text(methodStr),
+                                                       dice(0), sides(0), keep(0), bonus(0) {
+        string str;
+
+        for(auto c : methodStr) {
+            if(!isspace(c)) str += (char)tolower(c);
+        }
+
+        if(str == "standard" || str == "standard-array" || str == "array") {
+            method = STANDARD_ARRAY;
+            return;
+        }
+
+        if(str == "point-buy" || str == "pointbuy" || str == "buy") {
+            method = POINT_BUY;
+            return;
+        }
+
+        // NdS, NdS+B, or NdShK+B
+        size_t pos = 0;
+        int number = read_number(str, pos);
+
+        dice = number < 0 ? 1 : number;
+
+        if(pos < str.size() && str[pos] == 'd') {
+            pos++;
+            sides = read_number(str, pos);
+            keep = dice;
+
+            if(pos < str.size() && str[pos] == 'h') {
+                pos++;
+                keep = read_number(str, pos);
+            }
+
+            if(pos < str.size() && (str[pos] == '+' || str[pos] == '-')) {
+                const int sign = str[pos] == '-' ? -1 : 1;
+
+                pos++;
+                number = read_number(str, pos);
+                bonus = number < 0 ? 0 : sign * number;
+
+                if(number < 0) pos = 0;
+            }
+
+            if(pos == str.size() && dice >= 1 && dice <= SCORE_MAX_DICE &&
+               sides >= 2 && sides <= 255 && keep >= 1 && keep <= dice) {
+                method = DICE_SCORES;
+                return;
+            }
+        }
+
+        if(ExpressionCache::shared().get(methodStr) == nullptr) {
+            errorStr = "'" + methodStr + "' is not a roll expression, 'standard', or 'point-buy'";
+        }
+    }
+
+    void ScoreMethod::generate_range(ScoreColumns& out, size_t begin, size_t end) const {
+        auto& engine = Utils::thread_engine();
+
+        switch(method) {
+        case DICE_SCORES: {
+            const Die die(sides);
+            vector<uint8> rolls((size_t)dice * SCORE_BLOCK_SIZE);
+            vector<uint8> lowest(SCORE_BLOCK_SIZE);
+            vector<int> totals(SCORE_BLOCK_SIZE);
+
+            for(size_t done = begin; done < end; done += SCORE_BLOCK_SIZE) {
+                const size_t block = min<size_t>(SCORE_BLOCK_SIZE, end - done);
+
+                for(int ability = 0; ability < ABILITY_SCORE_COUNT; ability++) {
+                    // die d of row n is at rolls[d * block + n], so each pass below
+                    // walks straight down every die at once
+                    Characters::roll_dice(die, (size_t)dice * block, rolls.data(), engine);
+
+                    uint8* column = out.scores[ability].data() + done;
+                    fill(totals.begin(), totals.begin() + block, bonus);
+
+                    for(int d = 0; d < dice; d++) {
+                        const uint8* row = rolls.data() + d * block;
+
+                        for(size_t n = 0; n < block; n++) totals[n] += row[n];
+                    }
+
+                    if(keep == dice - 1) {
+                        // drop the lowest, the common case (4d6h3)
+                        copy(rolls.begin(), rolls.begin() + block, lowest.begin());
+
+                        for(int d = 1; d < dice; d++) {
+                            const uint8* row = rolls.data() + d * block;
+
+                            for(size_t n = 0; n < block; n++) lowest[n] = min(lowest[n], row[n]);
+                        }
+
+                        for(size_t n = 0; n < block; n++) totals[n] -= lowest[n];
+                    } else if(keep < dice) {
+                        uint8 row[SCORE_MAX_DICE];
+
+                        for(size_t n = 0; n < block; n++) {
+                            for(int d = 0; d < dice; d++) row[d] = rolls[d * block + n];
+
+                            sort(row, row + dice);
+                            for(int d = 0; d < dice - keep; d++) totals[n] -= row[d];
+                        }
+                    }
+
+                    for(size_t n = 0; n < block; n++) column[n] = (uint8)max(0, min(255, totals[n]));
+                }
+            }
+        } break;
+
+        case EXPRESSION_SCORES: {
+            auto expression = ExpressionCache::shared().get(text);
+
+            for(int ability = 0; ability < ABILITY_SCORE_COUNT; ability++) {
+                for(size_t n = begin; n < end; n++) {
+                    out.scores[ability][n] = (uint8)max(0, min(255, expression->evaluate(engine)));
+                }
+            }
+        } break;
+
+        case STANDARD_ARRAY: {
+            uint8 scores[ABILITY_SCORE_COUNT];
+
+            for(size_t n = begin; n < end; n++) {
+                copy(STANDARD_ARRAY_SCORES, STANDARD_ARRAY_SCORES + ABILITY_SCORE_COUNT, scores);
+                shuffle(scores, scores + ABILITY_SCORE_COUNT, engine);
+
+                for(int ability = 0; ability < ABILITY_SCORE_COUNT; ability++) {
+                    out.scores[ability][n] = scores[ability];
+                }
+            }
+        } break;
+
+        case POINT_BUY: {
+            uint8 scores[ABILITY_SCORE_COUNT];
+            int affordable[ABILITY_SCORE_COUNT];
+
+            for(size_t n = begin; n < end; n++) {
+                fill(scores, scores + ABILITY_SCORE_COUNT, POINT_BUY_MIN);
+                int points = POINT_BUY_BUDGET;
+
+                while(true) {
+                    int count = 0;
+
+                    for(int ability = 0; ability < ABILITY_SCORE_COUNT; ability++) {
+                        const int level = scores[ability] - POINT_BUY_MIN;
+
+                        if(level < POINT_BUY_MAX - POINT_BUY_MIN &&
+                           POINT_BUY_COST[level + 1] - POINT_BUY_COST[level] <= points) {
+                            affordable[count++] = ability;
+                        }
+                    }
+
+                    if(count == 0) break;
+
+                    const int ability = affordable[uniform_int_distribution<int>(0, count - 1)(engine)];
+                    const int level = scores[ability] - POINT_BUY_MIN;
+
+                    points -= POINT_BUY_COST[level + 1] - POINT_BUY_COST[level];
+                    scores[ability]++;
+                }
+
+                for(int ability = 0; ability < ABILITY_SCORE_COUNT; ability++) {
+                    out.scores[ability][n] = scores[ability];
+                }
+            }
+        } break;
+        }
+    }
+
+    ScoreColumns ScoreMethod::generate(size_t count, unsigned int threads) const {
+        ScoreColumns ret;
+
+        if(!is_valid()) return ret;
+
+        for(auto& column : ret.scores) column.resize(count);
+
+        if(count == 0) return ret;
+
+        Core::ThreadPool pool(threads);
+
+        // whole blocks per task, a few tasks per thread
+        const size_t blocks = (count + SCORE_BLOCK_SIZE - 1) / SCORE_BLOCK_SIZE;
+        const size_t taskCount = min<size_t>(blocks, pool.size() * 4);
+
+        pool.parallel_for(taskCount, [&](size_t task) {
+            const size_t begin = blocks * task / taskCount * SCORE_BLOCK_SIZE;
+            const size_t end = min(count, blocks * (task + 1) / taskCount * SCORE_BLOCK_SIZE);
+
+            generate_range(ret, begin, end);
+        });
+
+        return ret;
+    }
+
+    Distribution ScoreMethod::distribution() const {
+        Distribution ret;
+
+        switch(method) {
+        case DICE_SCORES: {
+            ret = Roll::keep_highest(dice, sides, keep, bonus);
+        } break;
+
+        case EXPRESSION_SCORES: {
+            ScoreColumns samples = generate(SCORE_METHOD_SAMPLES / ABILITY_SCORE_COUNT);
+            vector<double> counts(256, 0.0);
+            double total = 0.0;
+
+            for(auto& column : samples.scores) {
+                for(auto score : column) counts[score]++;
+
+                total += column.size();
+            }
+
+            // trim the scores that never came up from both ends
+            size_t lowest = 0;
+            size_t highest = counts.size() - 1;
+
+            while(lowest < highest && counts[lowest] == 0) lowest++;
+            while(highest > lowest && counts[highest] == 0) highest--;
+
+            ret.lowest = (int)lowest;
+            ret.probability.assign(counts.begin() + lowest, counts.begin() + highest + 1);
+
+            for(auto& p : ret.probability) p /= total > 0 ? total : 1.0;
+        } break;
+
+        case STANDARD_ARRAY: {
+            ret.lowest = STANDARD_ARRAY_SCORES[ABILITY_SCORE_COUNT - 1];
+            ret.probability.assign(STANDARD_ARRAY_SCORES[0] - ret.lowest + 1, 0.0);
+
+            for(auto score : STANDARD_ARRAY_SCORES) {
+                ret.probability[score - ret.lowest] += 1.0 / ABILITY_SCORE_COUNT;
+            }
+        } break;
+
+        case POINT_BUY: {
+            // every purchase spends at least 1 point, so each state is reached only
+            // from states that spent less. Each state packs the level bought of
+            // every ability 3 bits apiece, and is walked once in order of spending.
+            vector<unordered_map<uint32, double>> spent(POINT_BUY_BUDGET + 1);
+            spent[0][0] = 1.0;
+
+            ret.lowest = POINT_BUY_MIN;
+            ret.probability.assign(POINT_BUY_MAX - POINT_BUY_MIN + 1, 0.0);
+
+            for(int points = 0; points <= POINT_BUY_BUDGET; points++) {
+                for(auto& state : spent[points]) {
+                    int affordable[ABILITY_SCORE_COUNT];
+                    int count = 0;
+
+                    for(int ability = 0; ability < ABILITY_SCORE_COUNT; ability++) {
+                        const int level = (state.first >> (3 * ability)) & 7;
+
+                        if(level < POINT_BUY_MAX - POINT_BUY_MIN &&
+                           POINT_BUY_COST[level + 1] - POINT_BUY_COST[level] <= POINT_BUY_BUDGET - points) {
+                            affordable[count++] = ability;
+                        }
+                    }
+
+                    if(count == 0) {
+                        // every ability is alike, so each is equally likely to be any of these
+                        for(int ability = 0; ability < ABILITY_SCORE_COUNT; ability++) {
+                            const int level = (state.first >> (3 * ability)) & 7;
+
+                            ret.probability[level] += state.second / ABILITY_SCORE_COUNT;
+                        }
+
+                        continue;
+                    }
+
+                    for(int i = 0; i < count; i++) {
+                        const int level = (state.first >> (3 * affordable[i])) & 7;
+                        const int cost = POINT_BUY_COST[level + 1] - POINT_BUY_COST[level];
+
+                        spent[points + cost][state.first + (1 << (3 * affordable[i]))] += state.second / count;
+                    }
+                }
+
+                spent[points].clear();
+            }
+        } break;
+        }
+
+        return ret;
+    }
+
+    vector<uint8> ability_score_vector(const ScoreMethod& method) {
+        ScoreColumns columns = method.generate(1, 1);
+        vector<uint8> ret;
+
+        for(auto& column : columns.scores) {
+            if(!column.empty()) ret.push_back(column[0]);
+        }
+
+        return ret;
+    }
+}
@@ -32,6 +32,37 @@ namespace ORPG {
             }
             }
         }
+
+        /**
+         * @desc This function takes in an integer, ideally a Background::ID,
+         * and returns a pointer to the shared Background registered under that
+         * ID. If an ID less than 0 is passed we instead will randomly select a
+         * Background type to return.
+         *
+         * NOTE(incomingstick): function statics are initialized exactly once, even
+         * across threads, so each Background is built the first time it is asked
+         * for and lives until the program exits.
+         *
+         * @param const int identifier - the Background::ID of the background to look up
+         *
+         * @return const Background* - a pointer to the shared Background, or
+         * nullptr if the ID is unknown
+         **/
+        const Background* select_background(const int identifier) {
+            const auto id = (identifier < 0) ?
+                random_bg_id() : identifier;
+
+            switch(id) {
+            case Acolyte::ID : {
+                static const Acolyte acolyte;
+                return &acolyte;
+            }
+
+            default: {
+                return nullptr;
+            }
+            }
+        }
     }
 
     Acolyte::Acolyte() {
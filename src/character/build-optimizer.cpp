@@ -0,0 +1,257 @@
+/*
+characters - build-optimizer.cpp
+Created on: Oct 18, 2026
+
+OpenRPG Software License - Version 1.0 - February 10th, 2017 <https://openrpg.io/about/license/>
+This is free software: you are free to change and redistribute it.
+There is NO WARRANTY, to the extent permitted by law.
+*/
+#include <algorithm>
+#include <limits>
+
+#include "core/thread-pool.h"
+#include "character/character.h"
+#include "character/build-optimizer.h"
+
+/* the number of scores a point buy can choose between for each ability */
+#define POINT_BUY_LEVELS        (POINT_BUY_MAX - POINT_BUY_MIN + 1)
+
+using namespace std;
+
+namespace ORPG {
+    /* the value of a branch that can never produce a build */
+    static const double IMPOSSIBLE = -numeric_limits<double>::infinity();
+
+    BuildGoal::BuildGoal(): hitPoints(0.0), level(1) {
+        fill(weights, weights + ABILITY_SCORE_COUNT, 0.0);
+        fill(minimum, minimum + ABILITY_SCORE_COUNT, 0);
+    }
+
+    /* returns true if build a ranks before build b, see optimize_point_buy() */
+    static bool ranks_before(const Build& a, const Build& b) {
+        if(a.value != b.value) return a.value > b.value;
+        if(a.pointsSpent != b.pointsSpent) return a.pointsSpent < b.pointsSpent;
+
+        return lexicographical_compare(a.base, a.base + ABILITY_SCORE_COUNT,
+                                       b.base, b.base + ABILITY_SCORE_COUNT);
+    }
+
+    /**
+     * BuildSearch holds everything a search needs to know about a goal that
+     * does not change from one branch to the next, and the best builds it
+     * has found so far.
+     **/
+    struct BuildSearch {
+        const BuildGoal& goal;
+        uint8 bonus[ABILITY_SCORE_COUNT];       // the racial bonus of each ability
+        int hitDie;
+        size_t count;                           // the number of builds to keep
+
+        vector<Build> best;                     // the best builds so far, best first
+
+        BuildSearch(const Race& race, const CharacterClass& cClass, const BuildGoal& buildGoal, size_t keep):
+            goal(buildGoal), hitDie(cClass.HIT_DIE_MAX()), count(keep) {
+
+            AbilityScores bonuses(0);
+            race.applyRacialBonus(&bonuses);
+
+            for(int ability = 0; ability < ABILITY_SCORE_COUNT; ability++) {
+                bonus[ability] = bonuses.get_score((EnumAbilityScore)ability);
+            }
+        }
+
+        /* returns what a base score is worth to the goal in the given ability,
+            or IMPOSSIBLE if its final score falls under the minimum */
+        double worth(int ability, int base) const {
+            const int score = base + bonus[ability];
+
+            if(score < goal.minimum[ability]) return IMPOSSIBLE;
+
+            const int mod = modifier(score);
+            double ret = goal.weights[ability] * mod;
+
+            if(ability == CON && goal.hitPoints != 0.0) {
+                // the first level is the most the hit die can roll, every one after the average
+                const int first = max(1, hitDie + mod);
+                const int after = max(1, hitDie / 2 + 1 + mod);
+
+                ret += goal.hitPoints * (first + (max(1, goal.level) - 1) * after);
+            }
+
+            return ret;
+        }
+
+        /* returns the lowest value a build must beat to make the top, IMPOSSIBLE
+            until there are count builds */
+        double threshold() const {
+            return best.size() < count ? IMPOSSIBLE : best.back().value;
+        }
+
+        /* considers a finished build for the top */
+        void offer(const uint8* base, int pointsSpent, double value) {
+            Build build;
+
+            for(int ability = 0; ability < ABILITY_SCORE_COUNT; ability++) {
+                build.base[ability] = base[ability];
+                build.scores[ability] = base[ability] + bonus[ability];
+            }
+
+            build.pointsSpent = pointsSpent;
+            build.value = value;
+
+            if(goal.accept && !goal.accept(build.scores)) return;
+            if(best.size() >= count && !ranks_before(build, best.back())) return;
+
+            best.insert(upper_bound(best.begin(), best.end(), build, ranks_before), build);
+            if(best.size() > count) best.pop_back();
+        }
+    };
+
+    /**
+     * PointBuySearch walks every point buy one ability at a time, using
+     * precomputed tables of what each score is worth and what the remaining
+     * abilities could possibly add, so each branch costs a few lookups.
+     **/
+    struct PointBuySearch : public BuildSearch {
+        double value[ABILITY_SCORE_COUNT][POINT_BUY_LEVELS];
+
+        /* bound[a][points] is the most abilities a and after can add with points left */
+        double bound[ABILITY_SCORE_COUNT + 1][POINT_BUY_BUDGET + 1];
+
+        uint8 base[ABILITY_SCORE_COUNT];
+
+        PointBuySearch(const Race& race, const CharacterClass& cClass, const BuildGoal& buildGoal, size_t keep):
+            BuildSearch(race, cClass, buildGoal, keep) {
+
+            for(int ability = 0; ability < ABILITY_SCORE_COUNT; ability++) {
+                for(int level = 0; level < POINT_BUY_LEVELS; level++) {
+                    value[ability][level] = worth(ability, POINT_BUY_MIN + level);
+                }
+            }
+
+            fill(bound[ABILITY_SCORE_COUNT], bound[ABILITY_SCORE_COUNT] + POINT_BUY_BUDGET + 1, 0.0);
+
+            for(int ability = ABILITY_SCORE_COUNT - 1; ability >= 0; ability--) {
+                for(int points = 0; points <= POINT_BUY_BUDGET; points++) {
+                    double most = IMPOSSIBLE;
+
+                    for(int level = 0; level < POINT_BUY_LEVELS && POINT_BUY_COST[level] <= points; level++) {
+                        most = max(most, value[ability][level] + bound[ability + 1][points - POINT_BUY_COST[level]]);
+                    }
+
+                    bound[ability][points] = most;
+                }
+            }
+        }
+
+        void search(int ability, int points, double sum) {
+            if(ability == ABILITY_SCORE_COUNT) {
+                offer(base, POINT_BUY_BUDGET - points, sum);
+                return;
+            }
+
+            for(int level = POINT_BUY_LEVELS - 1; level >= 0; level--) {
+                if(POINT_BUY_COST[level] > points) continue;
+
+                const double next = sum + value[ability][level];
+                const double most = next + bound[ability + 1][points - POINT_BUY_COST[level]];
+
+                // ties may still win on points spent, so only a lower bound is dropped
+                if(most == IMPOSSIBLE || most < threshold()) continue;
+
+                base[ability] = (uint8)(POINT_BUY_MIN + level);
+                search(ability + 1, points - POINT_BUY_COST[level], next);
+            }
+        }
+    };
+
+    namespace Characters {
+        vector<Build> optimize_point_buy(const Race& race, const CharacterClass& cClass,
+                                         const BuildGoal& goal, size_t count, unsigned int threads) {
+            if(count == 0) return vector<Build>();
+
+            // one task for each pair of scores the first two abilities can be bought at
+            const size_t taskCount = POINT_BUY_LEVELS * POINT_BUY_LEVELS;
+            vector<vector<Build>> partials(taskCount);
+
+            Core::ThreadPool pool(threads);
+
+            pool.parallel_for(taskCount, [&](size_t task) {
+                PointBuySearch search(race, cClass, goal, count);
+
+                const int first = (int)(task / POINT_BUY_LEVELS);
+                const int second = (int)(task % POINT_BUY_LEVELS);
+                const int points = POINT_BUY_BUDGET - POINT_BUY_COST[first] - POINT_BUY_COST[second];
+
+                if(points < 0) return;
+
+                search.base[0] = (uint8)(POINT_BUY_MIN + first);
+                search.base[1] = (uint8)(POINT_BUY_MIN + second);
+                search.search(2, points, search.value[0][first] + search.value[1][second]);
+
+                partials[task] = search.best;
+            });
+
+            vector<Build> ret;
+
+            for(auto& partial : partials) ret.insert(ret.end(), partial.begin(), partial.end());
+
+            sort(ret.begin(), ret.end(), ranks_before);
+            if(ret.size() > count) ret.resize(count);
+
+            return ret;
+        }
+
+        /* assigns the unused scores to abilities ability and after */
+        static void search_assignment(BuildSearch& search, const vector<uint8>& scores, int ability,
+                                      uint32 used, uint8* base, double sum) {
+            if(ability == ABILITY_SCORE_COUNT) {
+                search.offer(base, 0, sum);
+                return;
+            }
+
+            // the most the rest could add is each ability taking its favourite unused score
+            double most = sum;
+
+            for(int next = ability; next < ABILITY_SCORE_COUNT && most != IMPOSSIBLE; next++) {
+                double favourite = IMPOSSIBLE;
+
+                for(size_t i = 0; i < scores.size(); i++) {
+                    if(!(used & (1 << i))) favourite = max(favourite, search.worth(next, scores[i]));
+                }
+
+                most += favourite;
+            }
+
+            if(most == IMPOSSIBLE || most < search.threshold()) return;
+
+            for(size_t i = 0; i < scores.size(); i++) {
+                // scores is sorted, so a repeated score would only repeat a branch
+                if(used & (1 << i)) continue;
+                if(i > 0 && scores[i] == scores[i - 1] && !(used & (1 << (i - 1)))) continue;
+
+                const double value = search.worth(ability, scores[i]);
+                if(value == IMPOSSIBLE) continue;
+
+                base[ability] = scores[i];
+                search_assignment(search, scores, ability + 1, used | (1 << i), base, sum + value);
+            }
+        }
+
+        vector<Build> optimize_assignment(const vector<uint8>& scores, const Race& race,
+                                          const CharacterClass& cClass, const BuildGoal& goal,
+                                          size_t count) {
+            if(count == 0 || scores.size() != ABILITY_SCORE_COUNT) return vector<Build>();
+
+            BuildSearch search(race, cClass, goal, count);
+
+            vector<uint8> sorted(scores);
+            sort(sorted.begin(), sorted.end(), greater<uint8>());
+
+            uint8 base[ABILITY_SCORE_COUNT];
+            search_assignment(search, sorted, 0, 0, base, 0.0);
+
+            return search.best;
+        }
+    }
+}
@@ -6,11 +6,19 @@ OpenRPG Software License - Version 1.0 - February 10th, 2017 <https://openrpg.io
 This is free software: you are free to change and redistribute it.
 There is NO WARRANTY, to the extent permitted by law.
 */
+#include <algorithm>
 #include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <thread>
 #include <vector>
 #include <string>
 
 #include "openrpg.h"
+#include "core/buffered-writer.h"
+#include "core/thread-pool.h"
 #include "character.h"
 
 using namespace std;
@@ -25,6 +33,82 @@ bool RANDOM_FLAG = false;
     we should be use the fancy character sheet */
 bool SHEET_FLAG = false;
 
+/* Directory of character files to import, empty if
+    we are not importing a directory */
+string IMPORT_DIR = "";
+
+/* Roster file to load and print, empty if
+    we are not loading a roster */
+string LOAD_FILE = "";
+
+/* Roster file to save generated characters to, empty
+    if we are printing them instead */
+string ROSTER_FILE = "";
+
+/* Number of threads to use for bulk work, 0 lets the
+    thread pool pick one per core */
+unsigned int THREAD_COUNT = 0;
+
+/* --threads may ask for at most this many threads per core,
+    more than that only adds contention */
+#define MAX_THREADS_PER_CORE    8
+
+/* Number of random characters to generate in bulk, 0
+    if we are only building a single character */
+size_t COUNT = 0;
+
+/* Global bool to help determine whether we should
+    print the hit point progression report */
+bool PROGRESSION_FLAG = false;
+
+/* Number of characters simulated per class and Constitution
+    modifier by the progression report, unless --count is given */
+#define PROGRESSION_SAMPLES     1000000
+
+/* Ability score generation method to report on, empty
+    if we are not printing the method report */
+string SCORE_METHOD = "";
+
+/* Number of characters whose scores are generated by the
+    method report, unless --count is given */
+#define METHOD_SAMPLES          1000000
+
+/* The output formats supported when generating in bulk */
+enum OutputFormat {
+    TEXT,
+    NDJSON,
+    SHEET
+};
+
+/* Global format to help determine how bulk
+    generated characters are written out */
+OutputFormat FORMAT = TEXT;
+
+/**
+ * @desc parses arg as a whole, unsigned, base 10 number no larger than max.
+ * Unlike stoi this never throws, so a number too large to hold is reported
+ * the same way as one that is not a number at all.
+ *
+ * @param const char* arg - the argument to parse
+ * @param unsigned long long max - the largest number to accept
+ * @param unsigned long long& out - set to the number if it parsed
+ * @return bool - true if arg was a number no larger than max
+ **/
+static bool parse_number(const char* arg, unsigned long long max, unsigned long long& out) {
+    // strtoull would quietly negate a leading '-', so only digits may start it
+    if(!isdigit((unsigned char)arg[0])) return false;
+
+    char* end = nullptr;
+
+    errno = 0;
+    const unsigned long long number = strtoull(arg, &end, 10);
+
+    if(errno == ERANGE || *end != '\0' || number > max) return false;
+
+    out = number;
+    return true;
+}
+
 /**
  * @desc This function parses all cla's passed to argv from the command line.
  * This function may terminate the program.
@@ -44,21 +128,62 @@ int parse_args(int argc, char* argv[], Character* &character) {
 
     /* these are the long cla's and their corresponding chars */
     static struct Core::option long_opts[] = {
-        {"help",    no_argument,        0,  'h'},
-        {"import",  required_argument,  0,  'i'},
-        {"random",  no_argument,        0,  'r'},
-        {"sheet",   no_argument,        0,  's'},
-        {"verbose", no_argument,        0,  'v'},
-        {"version", no_argument,        0,  'V'},
+        {"count",       required_argument,  0,  'c'},
+        {"import-dir",  required_argument,  0,  'd'},
+        {"format",      required_argument,  0,  'f'},
+        {"help",        no_argument,        0,  'h'},
+        {"import",      required_argument,  0,  'i'},
+        {"load",        required_argument,  0,  'l'},
+        {"method",      required_argument,  0,  'm'},
+        {"roster",      required_argument,  0,  'o'},
+        {"progression", no_argument,        0,  'p'},
+        {"random",      no_argument,        0,  'r'},
+        {"sheet",       no_argument,        0,  's'},
+        {"threads",     required_argument,  0,  't'},
+        {"verbose",     no_argument,        0,  'v'},
+        {"version",     no_argument,        0,  'V'},
         /* NULL row to terminate struct */
         {0,         0,                  0,   0}
     };
 
-    while ((opt = Core::getopt_long(argc, argv, "hi:rsvV",
+    while ((opt = Core::getopt_long(argc, argv, "c:d:f:hi:l:m:o:prst:vV",
                                long_opts, &opt_ind)) != EOF &&
                                status != EXIT_FAILURE) {
 
         switch (opt) {
+        /* -c --count */
+        case 'c': {
+            unsigned long long count = 0;
+
+            if(parse_number(Core::optarg, SIZE_MAX, count) && count > 0) {
+                COUNT = (size_t)count;
+            } else {
+                fprintf(stderr, "Error: --count expects a positive number\n");
+                status = EXIT_FAILURE;
+            }
+        } break;
+
+        /* -d --import-dir */
+        case 'd': {
+            IMPORT_DIR = (string)Core::optarg;
+        } break;
+
+        /* -f --format */
+        case 'f': {
+            string format = (string)Core::optarg;
+
+            if(format == "text") {
+                FORMAT = TEXT;
+            } else if(format == "ndjson") {
+                FORMAT = NDJSON;
+            } else if(format == "sheet") {
+                FORMAT = SHEET;
+            } else {
+                fprintf(stderr, "Error: --format expects one of text, ndjson, or sheet\n");
+                status = EXIT_FAILURE;
+            }
+        } break;
+
         /* -h --help */
         case 'h': {
             print_help_flag();
@@ -71,12 +196,34 @@ int parse_args(int argc, char* argv[], Character* &character) {
 
                 //TODO(incomingstick): import a character sheet from a file given the provided path
                 character = import_character((string)Core::optarg);
+
+                if(character == nullptr) status = EXIT_FAILURE;
             } else {
                 fprintf(stderr, "Error: invalid number of args (expects 1)\n");
                 Core::PRINT_HELP_FLAG();
             }
         } break;
 
+        /* -l --load */
+        case 'l': {
+            LOAD_FILE = (string)Core::optarg;
+        } break;
+
+        /* -m --method */
+        case 'm': {
+            SCORE_METHOD = (string)Core::optarg;
+        } break;
+
+        /* -o --roster */
+        case 'o': {
+            ROSTER_FILE = (string)Core::optarg;
+        } break;
+
+        /* -p --progression */
+        case 'p': {
+            PROGRESSION_FLAG = true;
+        } break;
+
         /* -r --random */
         case 'r': {
             RANDOM_FLAG = true;
@@ -84,7 +231,23 @@ int parse_args(int argc, char* argv[], Character* &character) {
 
         /* -s --sheet */
         case 's': {
+            // bulk output follows FORMAT, so a sheet there too
             SHEET_FLAG = true;
+            FORMAT = SHEET;
+        } break;
+
+        /* -t --threads */
+        case 't': {
+            const unsigned int cores = max(thread::hardware_concurrency(), 1u);
+            const unsigned int most = cores * MAX_THREADS_PER_CORE;
+            unsigned long long threads = 0;
+
+            if(parse_number(Core::optarg, most, threads)) {
+                THREAD_COUNT = (unsigned int)threads;
+            } else {
+                fprintf(stderr, "Error: --threads expects a number no larger than %u\n", most);
+                status = EXIT_FAILURE;
+            }
         } break;
 
         /* -v --verbose */
@@ -115,6 +278,267 @@ int parse_args(int argc, char* argv[], Character* &character) {
     return status;
 }
 
+/**
+ * @desc imports every character file in IMPORT_DIR, printing each character
+ * that loaded to stdout and each file that did not to stderr, followed by a
+ * summary of how long the import took.
+ *
+ * @return int - EXIT_SUCCESS if every file imported, EXIT_FAILURE otherwise
+ **/
+int import_dir() {
+    auto start = chrono::steady_clock::now();
+    auto result = import_directory(IMPORT_DIR, THREAD_COUNT);
+    auto elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    size_t imported = 0;
+
+    for(auto character : result.characters) {
+        if(character == nullptr) continue;
+
+        imported++;
+
+        SHEET_FLAG ?
+            printf("%s\n", character->to_ascii_sheet().c_str()) :
+            printf("%s\n", character->to_string().c_str());
+
+        delete character;
+    }
+
+    for(auto error : result.errors) {
+        fprintf(stderr, "%s:%i: %s\n", error.file.c_str(), error.line, error.message.c_str());
+    }
+
+    fprintf(stderr, "Imported %zu of %zu characters in %.3fs\n",
+            imported, result.files.size(), elapsed);
+
+    return result.errors.empty() ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/**
+ * @desc renders a character in the requested FORMAT in to out, including the
+ * trailing newline that separates it from the next character. Sheets are
+ * rendered straight in to out, reusing its capacity.
+ *
+ * @param Character* character - the character to render
+ * @param string& out - the buffer to render the character in to
+ **/
+void render(Character* character, string& out) {
+    switch(FORMAT) {
+    case NDJSON: out = character->to_json(); break;
+    case SHEET:  character->to_ascii_sheet(out); break;
+    default:     out = character->to_string(); break;
+    }
+
+    out += "\n";
+}
+
+/**
+ * @desc generates COUNT fully random characters across THREAD_COUNT threads,
+ * streaming each one to stdout in FORMAT as it is finished. Characters are
+ * built and rendered in parallel in fixed size chunks, then each chunk is
+ * written out in order through a single BufferedWriter, so the output is
+ * never interleaved and memory use does not grow with COUNT. A summary of
+ * the throughput is printed to stderr.
+ *
+ * @return int - EXIT_SUCCESS if every character was written, EXIT_FAILURE otherwise
+ **/
+int generate_batch() {
+    const size_t CHUNK_SIZE = 1024;
+
+    auto start = chrono::steady_clock::now();
+
+    // locate the data once, before the threads go looking for name lists
+    Core::DATA_LOCATION();
+
+    Core::ThreadPool pool(THREAD_COUNT);
+    Core::BufferedWriter out(stdout);
+
+    RosterWriter roster;
+
+    vector<string> rendered(min(COUNT, CHUNK_SIZE));
+    vector<Character*> characters(min(COUNT, CHUNK_SIZE));
+
+    for(size_t done = 0; done < COUNT; done += rendered.size()) {
+        rendered.resize(min(COUNT - done, CHUNK_SIZE));
+        characters.resize(rendered.size());
+
+        pool.parallel_for(rendered.size(), [&](size_t i) {
+            characters[i] = new_random_character();
+
+            if(ROSTER_FILE.empty()) render(characters[i], rendered[i]);
+        });
+
+        // the roster is not thread safe, so it is filled in order here
+        for(size_t i = 0; i < characters.size(); i++) {
+            if(ROSTER_FILE.empty()) out.write(rendered[i]);
+            else roster.add(*characters[i]);
+
+            delete characters[i];
+        }
+    }
+
+    bool ok = out.flush();
+
+    string error;
+    if(!ROSTER_FILE.empty() && !roster.save(ROSTER_FILE, &error)) {
+        fprintf(stderr, "Error: %s\n", error.c_str());
+        ok = false;
+    }
+
+    auto elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    fprintf(stderr, "Generated %zu characters in %.3fs (%.0f characters/sec) on %u threads\n",
+            COUNT, elapsed, elapsed > 0 ? COUNT / elapsed : 0.0, pool.size());
+
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/**
+ * @desc maps the roster file LOAD_FILE and prints every character in it to
+ * stdout in FORMAT, followed by a summary of how long the load took on stderr.
+ *
+ * @return int - EXIT_SUCCESS if the roster loaded, EXIT_FAILURE otherwise
+ **/
+int load_roster() {
+    RosterReader roster;
+
+    auto start = chrono::steady_clock::now();
+    bool opened = roster.open(LOAD_FILE);
+    auto elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    if(!opened) {
+        fprintf(stderr, "Error: %s\n", roster.get_error().c_str());
+        return EXIT_FAILURE;
+    }
+
+    fprintf(stderr, "Loaded %zu characters (roster version %u) in %.3fms\n",
+            roster.size(), (unsigned)roster.version(), elapsed * 1000);
+
+    int status = EXIT_SUCCESS;
+    Core::BufferedWriter out(stdout);
+    string rendered;
+
+    for(size_t i = 0; i < roster.size(); i++) {
+        Character* character = roster.to_character(i);
+
+        if(character == nullptr) {
+            fprintf(stderr, "%s: record %zu has an unknown race, class, or background\n",
+                    LOAD_FILE.c_str(), i);
+            status = EXIT_FAILURE;
+            continue;
+        }
+
+        render(character, rendered);
+        out.write(rendered);
+
+        delete character;
+    }
+
+    return out.flush() ? status : EXIT_FAILURE;
+}
+
+/**
+ * @desc simulates every class leveling from 1 to 20 for a range of Constitution
+ * modifiers, and prints how their maximum hit points are spread at each level.
+ * COUNT characters are simulated per class and modifier, or PROGRESSION_SAMPLES
+ * if no count was given.
+ *
+ * @return int - always EXIT_SUCCESS
+ **/
+int progression_report() {
+    const int MIN_CON_MOD = -1;
+    const int MAX_CON_MOD = 5;
+
+    const uint64 samples = COUNT != 0 ? COUNT : PROGRESSION_SAMPLES;
+
+    auto start = chrono::steady_clock::now();
+
+    for(auto classID : character_class_ids()) {
+        const CharacterClass* cClass = select_character_class(classID);
+        vector<HitPointDistribution> results;
+
+        for(int conMod = MIN_CON_MOD; conMod <= MAX_CON_MOD; conMod++) {
+            results.push_back(simulate_hit_points(*cClass, conMod, samples, THREAD_COUNT));
+        }
+
+        printf("%s (d%d), %llu characters per Constitution modifier\n\n",
+               cClass->to_string().c_str(), cClass->HIT_DIE_MAX(), (unsigned long long)samples);
+
+        printf("Mean maximum hit points\nLevel");
+        for(auto& result : results) printf("   CON %+d", result.conMod);
+        printf("\n");
+
+        for(int level = 1; level <= CHARACTER_MAX_LEVEL; level++) {
+            printf("%5d", level);
+            for(auto& result : results) printf("  %7.2f", result.mean(level));
+            printf("\n");
+        }
+
+        printf("\nMaximum hit points at level %d\n"
+               "CON      min     5%%  median    95%%     max  std dev\n", CHARACTER_MAX_LEVEL);
+
+        for(auto& result : results) {
+            printf(" %+d  %6d  %6d  %6d  %6d  %6d  %7.2f\n", result.conMod,
+                   result.lowest(CHARACTER_MAX_LEVEL),
+                   result.percentile(CHARACTER_MAX_LEVEL, 0.05),
+                   result.percentile(CHARACTER_MAX_LEVEL, 0.5),
+                   result.percentile(CHARACTER_MAX_LEVEL, 0.95),
+                   result.highest(CHARACTER_MAX_LEVEL),
+                   result.stddev(CHARACTER_MAX_LEVEL));
+        }
+
+        printf("\n");
+    }
+
+    auto elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    const uint64 total = samples * character_class_ids().size() * (MAX_CON_MOD - MIN_CON_MOD + 1);
+
+    fprintf(stderr, "Simulated %llu characters in %.3fs (%.0f characters/sec)\n",
+            (unsigned long long)total, elapsed, elapsed > 0 ? total / elapsed : 0.0);
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ * @desc prints exactly how SCORE_METHOD spreads a single ability score, then
+ * generates the scores of COUNT characters (or METHOD_SAMPLES if no count was
+ * given) with it to measure how fast it is.
+ *
+ * @return int - EXIT_SUCCESS if SCORE_METHOD is a method, EXIT_FAILURE otherwise
+ **/
+int method_report() {
+    ScoreMethod method(SCORE_METHOD);
+
+    if(!method.is_valid()) {
+        fprintf(stderr, "Error: %s\n", method.get_error().c_str());
+        return EXIT_FAILURE;
+    }
+
+    Distribution spread = method.distribution();
+
+    printf("%s, %s distribution of a single ability score\n\n"
+           "Score  Mod   Chance  At least\n", method.to_string().c_str(),
+           method.is_exact() ? "exact" : "estimated");
+
+    for(int score = spread.highest(); score >= spread.lowest; score--) {
+        printf("%5d  %+3d  %6.2f%%   %6.2f%%\n", score, modifier(score),
+               spread.chance(score) * 100, spread.at_least(score) * 100);
+    }
+
+    printf("\nMean %.4f, standard deviation %.4f\n", spread.mean(), spread.stddev());
+
+    const size_t samples = COUNT != 0 ? COUNT : METHOD_SAMPLES;
+
+    auto start = chrono::steady_clock::now();
+    ScoreColumns scores = method.generate(samples, THREAD_COUNT);
+    auto elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    fprintf(stderr, "Generated the scores of %zu characters in %.3fs (%.0f characters/sec)\n",
+            scores.size(), elapsed, elapsed > 0 ? scores.size() / elapsed : 0.0);
+
+    return EXIT_SUCCESS;
+}
+
 /**
  * @desc entry point for the character-generator program. This contains the
  * main logic for creating a character via the character-generator. All
@@ -129,13 +553,37 @@ int main(int argc, char* argv[]) {
     
     int status = parse_args(argc, argv, character); // may exit
 
-    if(character == nullptr) {
+    if(status != EXIT_FAILURE && !IMPORT_DIR.empty()) {
+        return import_dir();
+    }
+
+    if(status != EXIT_FAILURE && !LOAD_FILE.empty()) {
+        return load_roster();
+    }
+
+    if(status != EXIT_FAILURE && PROGRESSION_FLAG) {
+        return progression_report();
+    }
+
+    if(status != EXIT_FAILURE && !SCORE_METHOD.empty()) {
+        return method_report();
+    }
+
+    if(status != EXIT_FAILURE && COUNT != 0) {
+        if(!RANDOM_FLAG) {
+            fprintf(stderr, "Error: --count requires --random\n");
+            return EXIT_FAILURE;
+        }
+
+        return generate_batch();
+    }
+
+    if(character == nullptr && status != EXIT_FAILURE) {
         /* begin creating the character here */
         RANDOM_FLAG = RANDOM_FLAG ? RANDOM_FLAG : request_is_random();
 
         auto race       = RANDOM_FLAG ? new_random_race() : request_race();
-        //TODO(incomingstick): randomly generate ability scores, not an empty set
-        auto scores     = RANDOM_FLAG ? new AbilityScores : request_scores();
+        auto scores     = RANDOM_FLAG ? new_random_ability_scores() : request_scores();
         auto bg         = RANDOM_FLAG ? random_bg_id() : request_background();
         auto charClass  = RANDOM_FLAG ? new_random_character_class() : request_class();
         auto skills     = RANDOM_FLAG ? new Skills : request_skills();
@@ -151,7 +599,17 @@ int main(int argc, char* argv[]) {
         }
     }
 
-    if(status != EXIT_FAILURE) {
+    if(status != EXIT_FAILURE && !ROSTER_FILE.empty()) {
+        RosterWriter roster;
+        string error;
+
+        roster.add(*character);
+
+        if(!roster.save(ROSTER_FILE, &error)) {
+            fprintf(stderr, "Error: %s\n", error.c_str());
+            status = EXIT_FAILURE;
+        }
+    } else if(status != EXIT_FAILURE) {
         SHEET_FLAG ? 
             printf("%s", character->to_ascii_sheet().c_str()) :
             printf("%s", character->to_string().c_str());
@@ -9,16 +9,23 @@ There is NO WARRANTY, to the extent permitted by law.
 #include <string>
 #include <vector>
 #include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <filesystem>
+#include <type_traits>
 
 #include "core/config.h"
+#include "core/thread-pool.h"
 #include "core/xml.h"
+#include "character/sheet.h"
 #include "roll.h"
-#include "names.h"
 #include "character.h"
 
 using namespace std;
 using namespace ORPG;
 
+namespace fs = std::filesystem;
+
 namespace ORPG {
     namespace Characters {
         /**
@@ -46,9 +53,18 @@ namespace ORPG {
                 "This is free software: you are free to change and redistribute it.\n"
                 "There is NO WARRANTY, to the extent permitted by law.\n\n"
                 "Usage: character-generator [options] RACE GENDER\n"
+                        "\t-c --count=N                Generates N random characters in bulk (requires -r).\n"
+                        "\t-d --import-dir=DIR         Imports every .xml character file found under DIR.\n"
+                        "\t-f --format=FORMAT          Bulk output format: text, ndjson, or sheet (defaults to text).\n"
                         "\t-h --help                   Print this help screen.\n"
+                        "\t-i --import=FILE            Imports a character from an .xml character file.\n"
+                        "\t-l --load=FILE              Loads and prints every character in a binary roster FILE.\n"
+                        "\t-m --method=METHOD          Reports how METHOD (i.e 4d6h3, standard, or point-buy) spreads ability scores.\n"
+                        "\t-o --roster=FILE            Saves the generated character(s) to a binary roster FILE instead of printing them.\n"
+                        "\t-p --progression            Simulates leveling every class to 20 and reports their hit points (-c sets the sample size).\n"
                         "\t-r --random                 Skips the character creator and generates a fully random character.\n"
-                        "\t-s --sheet                  Prints a fancy character sheet when done building the character.\n"
+                        "\t-s --sheet                  Prints a fancy character sheet, the same as --format=sheet.\n"
+                        "\t-t --threads=N              Number of threads to use for bulk work (defaults to one per core).\n"
                         "\t-v --verbose                Verbose program output.\n"
                         "\t-V --version                Print version info.\n"
                 "\n"
@@ -82,9 +98,18 @@ namespace ORPG {
                 "This is free software: you are free to change and redistribute it.\n"
                 "There is NO WARRANTY, to the extent permitted by law.\n\n"
                 "Usage: character-generator [options] RACE GENDER\n"
+                        "\t-c --count=N                Generates N random characters in bulk (requires -r).\n"
+                        "\t-d --import-dir=DIR         Imports every .xml character file found under DIR.\n"
+                        "\t-f --format=FORMAT          Bulk output format: text, ndjson, or sheet (defaults to text).\n"
                         "\t-h --help                   Print this help screen\n"
+                        "\t-i --import=FILE            Imports a character from an .xml character file.\n"
+                        "\t-l --load=FILE              Loads and prints every character in a binary roster FILE.\n"
+                        "\t-m --method=METHOD          Reports how METHOD (i.e 4d6h3, standard, or point-buy) spreads ability scores.\n"
+                        "\t-o --roster=FILE            Saves the generated character(s) to a binary roster FILE instead of printing them.\n"
+                        "\t-p --progression            Simulates leveling every class to 20 and reports their hit points (-c sets the sample size).\n"
                         "\t-r --random                 Skips the character creator and generates a fully random character\n"
-                        "\t-s --sheet                  Prints a fancy character sheet when done building the character.\n"
+                        "\t-s --sheet                  Prints a fancy character sheet, the same as --format=sheet.\n"
+                        "\t-t --threads=N              Number of threads to use for bulk work (defaults to one per core).\n"
                         "\t-v --verbose                Verbose program output\n"
                         "\t-V --version                Print version info\n"
                 "\n"
@@ -330,9 +355,9 @@ namespace ORPG {
          * via stdin. It repeats this process for the subrace, and will continue prompting
          * until no other race types could possibly be chosen.
          * 
-         * @return Race* - a pointer to a new Race determined by the RaceSelector
+         * @return const Race* - a pointer to the shared Race determined by the RaceSelector
          **/
-        Race* request_race() {
+        const Race* request_race() {
             RaceSelector selector;
 
             printf("Choose Race:\n");
@@ -492,6 +517,16 @@ namespace ORPG {
             return ret;
         }
 
+        AbilityScores* new_random_ability_scores() {
+            AbilityScores* ret = new AbilityScores;
+
+            for(int i = 0; i < ABILITY_SCORE_COUNT; i++) {
+                ret->set_score((EnumAbilityScore)i, gen_stat());
+            }
+
+            return ret;
+        }
+
         /**
          * @desc This function prompts the user via stdout for a name, and reading
          * from stdin the input. We use the safeGetline funtion via the ORPG::Utils
@@ -530,11 +565,11 @@ namespace ORPG {
          *
          * TODO(incomingstick): Add more character classes
          *
-         * @return CharacterClass* - always will return a pointer to a Wizard
+         * @return const CharacterClass* - always will return a pointer to the shared Wizard
          **/
-        CharacterClass* request_class() {
+        const CharacterClass* request_class() {
             printf("Wizard Class Automatically Chosen\n");
-            return new Wizard;
+            return select_character_class(Wizard::ID);
         }
 
         /**
@@ -556,7 +591,7 @@ namespace ORPG {
          *
          * @return bool - always will return true
          **/
-        bool request_hitpoints(CharacterClass* classPtr) {
+        bool request_hitpoints(const CharacterClass* classPtr) {
             printf("Hit points\n");
             return true;
         }
@@ -585,18 +620,237 @@ namespace ORPG {
         Character* import_character(string file) {
             if(file.empty()) return new Character;
 
+            ImportError error;
+            Character* ret = import_character(file, &error);
+
+            if(ret == nullptr) {
+                fprintf(stderr, "%s:%i: %s\n", error.file.c_str(), error.line, error.message.c_str());
+            }
+
+            return ret;
+        }
+
+        /**
+         * @desc fills in the given ImportError, if there is one, and returns
+         * nullptr so import_character can bail out in a single line
+         **/
+        static Character* import_failed(ImportError* error, const string& file,
+                                        int line, const string& message) {
+            if(error != nullptr) {
+                error->file = file;
+                error->line = line;
+                error->message = message;
+            }
+
+            return nullptr;
+        }
+
+        /**
+         * @desc reads the named attribute of the given element as an integer
+         * in the range [min, max]. Numbers may be written in decimal or, with
+         * a leading 0x, in hex.
+         *
+         * @param Core::XMLElement* element - the element to read from
+         * @param const string& name - the attribute to read
+         * @param long min - the smallest value allowed
+         * @param long max - the largest value allowed
+         * @param long& out - set to the parsed value on success
+         * @param string& why - set to a description of the problem on failure
+         * @param int& line - set to the line of the problem on failure
+         *
+         * @return bool - true if the attribute exists and is a valid number
+         **/
+        static bool read_number(Core::XMLElement* element, const string& name,
+                                long min, long max, long& out,
+                                string& why, int& line) {
+            Core::XMLAttribute* attr = element->find_attribute(name);
+
+            if(attr == nullptr) {
+                why = "<" + element->get_name() + "> is missing the " + name + " attribute";
+                line = element->get_line_number();
+                return false;
+            }
+
+            const string value = attr->get_value();
+            char* end = nullptr;
+
+            // decimal, so a leading zero is not octal, unless it starts with 0x
+            const bool hex = value.size() > 1 && value[0] == '0' && (value[1] == 'x' || value[1] == 'X');
+
+            errno = 0;
+            out = strtol(value.c_str(), &end, hex ? 16 : 10);
+
+            if(value.empty() || *end != '\0' || errno == ERANGE || out < min || out > max) {
+                why = name + "=\"" + value + "\" is not a number between " +
+                      std::to_string(min) + " and " + std::to_string(max);
+                line = attr->get_line_number();
+                return false;
+            }
+
+            return true;
+        }
+
+        Character* import_character(string file, ImportError* error) {
             // create the container for the XML file to be opened
             Core::XMLDocument document;
 
-            // TODO(incomingstick): check whether the file is XML or not
-            if (document.load_file(file)) {
-                //TODO: create a character based on the imported XML file
-            } else {
-                /* TODO: Raise an exception here, if an asset file
-                 cannot be opened then something serious has gone wrong. */
+            if(!document.load_file(file)) {
+                return import_failed(error, file, document.get_error_line(), document.get_error());
+            }
+
+            Core::XMLElement* root = document.get_root();
+
+            if(root->get_name() != "character") {
+                return import_failed(error, file, root->get_line_number(),
+                    "expected a <character> root element, found <" + root->get_name() + ">");
+            }
+
+            string why;
+            int line = 0;
+            long raceID, classID, bgID;
+
+            if(!read_number(root, "race", 0, UINT_MAX, raceID, why, line) ||
+               !read_number(root, "class", 0, UINT_MAX, classID, why, line) ||
+               !read_number(root, "background", 0, UINT_MAX, bgID, why, line)) {
+                return import_failed(error, file, line, why);
+            }
+
+            const string name = root->attribute("name");
+            if(name.empty()) {
+                return import_failed(error, file, root->get_line_number(),
+                    "<character> is missing the name attribute");
+            }
+
+            long level = 1, exp = 0;
+            if((root->find_attribute("level") != nullptr &&
+                    !read_number(root, "level", 1, 20, level, why, line)) ||
+               (root->find_attribute("exp") != nullptr &&
+                    !read_number(root, "exp", 0, INT_MAX, exp, why, line))) {
+                return import_failed(error, file, line, why);
+            }
+
+            Core::XMLElement* abilities = root->first_child_element("abilities");
+            if(abilities == nullptr) {
+                return import_failed(error, file, root->get_line_number(),
+                    "<character> is missing an <abilities> element");
+            }
+
+            static const struct {
+                const char* attr;
+                EnumAbilityScore ability;
+            } scoreAttrs[] = {
+                { "str", STR }, { "dex", DEX }, { "con", CON },
+                { "int", INT }, { "wis", WIS }, { "cha", CHA }
+            };
+
+            long scores[6];
+            for(int i = 0; i < 6; i++) {
+                if(!read_number(abilities, scoreAttrs[i].attr, 1, 30, scores[i], why, line)) {
+                    return import_failed(error, file, line, why);
+                }
+            }
+
+            long hp[3] = { 0, 0, 0 };
+            Core::XMLElement* hitpoints = root->first_child_element("hitpoints");
+            if(hitpoints != nullptr) {
+                if(!read_number(hitpoints, "current", INT_MIN, INT_MAX, hp[0], why, line) ||
+                   !read_number(hitpoints, "max", 1, INT_MAX, hp[1], why, line) ||
+                   (hitpoints->find_attribute("temp") != nullptr &&
+                        !read_number(hitpoints, "temp", 0, INT_MAX, hp[2], why, line))) {
+                    return import_failed(error, file, line, why);
+                }
+            }
+
+            // make sure all of our ID's are real before building anything
+            const Race* race = select_race((int)raceID);
+            if(race == nullptr) {
+                return import_failed(error, file, root->find_attribute("race")->get_line_number(),
+                    "unknown race ID " + root->attribute("race"));
+            }
+
+            const CharacterClass* cClass = select_character_class((int)classID);
+            if(cClass == nullptr) {
+                return import_failed(error, file, root->find_attribute("class")->get_line_number(),
+                    "unknown class ID " + root->attribute("class"));
+            }
+
+            if(select_background((int)bgID) == nullptr) {
+                return import_failed(error, file, root->find_attribute("background")->get_line_number(),
+                    "unknown background ID " + root->attribute("background"));
+            }
+
+            Character* ret = new Character(race, new AbilityScores, cClass, (int)bgID, new Skills, name);
+
+            for(int i = 0; i < 6; i++) {
+                ret->set_ability_score(scoreAttrs[i].ability, (uint8)scores[i]);
+            }
+
+            ret->set_level((int)level);
+            ret->set_exp((int)exp);
+
+            if(hitpoints != nullptr) {
+                ret->set_hit_points((int)hp[0], (int)hp[1], (int)hp[2]);
+            } else if(level > 1) {
+                // every level past the first takes the fixed average of the hit die
+                const int gain = std::max(1, cClass->HIT_DIE_MAX() / 2 + 1 + ret->CON_MOD());
+                const int maximum = ret->get_max_hp() + gain * ((int)level - 1);
+
+                ret->set_hit_points(maximum, maximum, 0);
+            }
+
+            return ret;
+        }
+
+        ImportResult import_directory(string path, unsigned int threads) {
+            ImportResult result;
+            error_code err;
+
+            fs::recursive_directory_iterator dir(path, fs::directory_options::skip_permission_denied, err);
+
+            if(err) {
+                result.errors.push_back({ path, 0, "unable to open directory: " + err.message() });
+                return result;
+            }
+
+            for(; dir != fs::recursive_directory_iterator(); dir.increment(err)) {
+                if(err) break;
+
+                if(dir->is_regular_file(err) && dir->path().extension() == ".xml") {
+                    result.files.push_back(dir->path().string());
+                }
+            }
+
+            if(err) {
+                result.errors.push_back({ path, 0, "unable to read directory: " + err.message() });
+            }
+
+            // sort so the results do not depend on the order the filesystem hands them to us
+            sort(result.files.begin(), result.files.end());
+
+            const size_t count = result.files.size();
+
+            // every file gets its own slot so the workers never share a write
+            result.characters.assign(count, nullptr);
+            vector<ImportError> fileErrors(count);
+
+            Core::ThreadPool pool(threads);
+            pool.parallel_for(count, [&](size_t i) {
+                result.characters[i] = import_character(result.files[i], &fileErrors[i]);
+            });
+
+            for(size_t i = 0; i < count; i++) {
+                if(result.characters[i] == nullptr) {
+                    result.errors.push_back(fileErrors[i]);
+                }
             }
 
-            return new Character();
+            return result;
+        }
+
+        Character* new_random_character(NameProvider* names) {
+            return new Character(new_random_race(), new_random_ability_scores(),
+                                 new_random_character_class(), random_bg_id(),
+                                 new Skills, "", names);
         }
     }
 
@@ -623,6 +877,34 @@ namespace ORPG {
         355000        // Level 20
     };
 
+    /* the ability that governs each skill, in EnumSkill order */
+    const EnumAbilityScore SKILL_ABILITY[SKILL_COUNT] = {
+        DEX,    // Acrobatics
+        WIS,    // Animal Handling
+        INT,    // Arcana
+        STR,    // Athletics
+        CHA,    // Deception
+        INT,    // History
+        WIS,    // Insight
+        CHA,    // Intimidation
+        INT,    // Investigation
+        WIS,    // Medicine
+        INT,    // Nature
+        WIS,    // Perception
+        CHA,    // Performance
+        CHA,    // Persuasion
+        INT,    // Religion
+        DEX,    // Sleight of Hand
+        DEX,    // Stealth
+        WIS     // Survival
+    };
+
+    /* Both of these are copied around by value and must stay flat */
+    static_assert(std::is_trivially_copyable<AbilityScores>::value,
+                  "AbilityScores must be trivially copyable");
+    static_assert(std::is_trivially_copyable<Skills>::value,
+                  "Skills must be trivially copyable");
+
     /**
      * mod is what is added to rolls
      * Prof is number of proficiencies, 0 if unproficient, 1 if proficient, 2 if doubly proficient
@@ -684,7 +966,7 @@ namespace ORPG {
      *
      * @return int8 - the modifier bonus of the queried skill
      **/
-    int8 Skill::get_mod() {
+    int8 Skill::get_mod() const {
         return this->mod;
     }
 
@@ -701,7 +983,7 @@ namespace ORPG {
      * @return uint8 - the proficiency bonus level that is used when calculating
      * the amount proficiency to add to this skills modifier bonus
      **/
-    unsigned char Skill::get_prof() {
+    unsigned char Skill::get_prof() const {
         return this->profBonus;
     }
 
@@ -714,7 +996,7 @@ namespace ORPG {
      *
      * @return string - a string 
      **/
-    std::string Skill::to_string() {
+    std::string Skill::to_string() const {
         string ret = "";
 
         if(mod > 0) ret = "+";
@@ -727,27 +1009,8 @@ namespace ORPG {
      * their respective EnumSkill, with a modifier of 0 and proficiency
      * bonus level of 0.
      **/
-    Skills::Skills() {
-        this->skillsMap = {
-            { ACR, new Skill(0, 0) },    // Acrobatics       (DEX)
-            { ANM, new Skill(0, 0) },    // Animal Handling  (WIS)
-            { ARC, new Skill(0, 0) },    // Arcana           (INT)
-            { ATH, new Skill(0, 0) },    // Athletics        (STR)
-            { DEC, new Skill(0, 0) },    // Deception        (CHA)
-            { HIS, new Skill(0, 0) },    // History          (INT)
-            { INS, new Skill(0, 0) },    // Insight          (WIS)
-            { ITM, new Skill(0, 0) },    // Intimidation     (CHA)
-            { INV, new Skill(0, 0) },    // Investigation    (INT)
-            { MED, new Skill(0, 0) },    // Medicine         (WIS)
-            { NAT, new Skill(0, 0) },    // Nature           (INT)
-            { PRC, new Skill(0, 0) },    // Perception       (WIS)
-            { PRF, new Skill(0, 0) },    // Performance      (CHA)
-            { PRS, new Skill(0, 0) },    // Persuasion       (CHA)
-            { REL, new Skill(0, 0) },    // Religion         (INT)
-            { SLE, new Skill(0, 0) },    // Sleight of Hand  (DEX)
-            { STL, new Skill(0, 0) },    // Stealth          (DEX)
-            { SUR, new Skill(0, 0) }     // Survival         (WIS)
-        };
+    Skills::Skills():container(nullptr) {
+        /* every Skill default constructs to a modifier of 0, unproficient */
     };
 
     /**
@@ -756,34 +1019,7 @@ namespace ORPG {
      * bonus level of 0.
      **/
     Skills::Skills(void* owner):container(owner) {
-        this->skillsMap = {
-            { ACR, new Skill(0, 0) },    // Acrobatics       (DEX)
-            { ANM, new Skill(0, 0) },    // Animal Handling  (WIS)
-            { ARC, new Skill(0, 0) },    // Arcana           (INT)
-            { ATH, new Skill(0, 0) },    // Athletics        (STR)
-            { DEC, new Skill(0, 0) },    // Deception        (CHA)
-            { HIS, new Skill(0, 0) },    // History          (INT)
-            { INS, new Skill(0, 0) },    // Insight          (WIS)
-            { ITM, new Skill(0, 0) },    // Intimidation     (CHA)
-            { INV, new Skill(0, 0) },    // Investigation    (INT)
-            { MED, new Skill(0, 0) },    // Medicine         (WIS)
-            { NAT, new Skill(0, 0) },    // Nature           (INT)
-            { PRC, new Skill(0, 0) },    // Perception       (WIS)
-            { PRF, new Skill(0, 0) },    // Performance      (CHA)
-            { PRS, new Skill(0, 0) },    // Persuasion       (CHA)
-            { REL, new Skill(0, 0) },    // Religion         (INT)
-            { SLE, new Skill(0, 0) },    // Sleight of Hand  (DEX)
-            { STL, new Skill(0, 0) },    // Stealth          (DEX)
-            { SUR, new Skill(0, 0) }     // Survival         (WIS)
-        };
-    }
-
-    /**
-     * @desc Desctructor function for the Skills class that ensures
-     * the internal std::map skillsMap is deleted
-     **/
-    Skills::~Skills() {
-        delete[] &skillsMap;
+        /* every Skill default constructs to a modifier of 0, unproficient */
     }
 
     /**
@@ -797,19 +1033,18 @@ namespace ORPG {
     int8 Skills::get_mod(EnumSkill skill) {
         int finalProf = 0;
         auto currProf = ((Character*)container)->get_proficiency_bonus();
-        auto profRank = skillsMap[skill]->get_prof();
+        auto profRank = skills[skill].get_prof();
 
         if(profRank == PROFICIENT) finalProf = currProf;
         else if(profRank == HALF_PROFICIENT) finalProf = currProf / 2;
         else if(profRank == DOUBLE_PROFICIENT) finalProf = currProf * 2;
 
-        return skillsMap[skill]->get_mod() + finalProf;
+        return skills[skill].get_mod() + finalProf;
     };
 
     /* to_string method used internally for iterative purposes */
-    std::string Skills::internal_to_string(std::pair<EnumSkill, Skill*> skill) {
+    std::string Skills::internal_to_string(EnumSkill eskill, const Skill& skill) {
         string ret = "";
-        auto eskill = skill.first;
 
         switch(eskill) {
         case ACR: { ret = "ACR: "; } break;   // Acrobatics       (DEX)
@@ -835,7 +1070,7 @@ namespace ORPG {
         }
         }
 
-        ret += skill.second->to_string() +"\n";
+        ret += skill.to_string() +"\n";
 
         return ret;
     };
@@ -849,11 +1084,11 @@ namespace ORPG {
      *
      * @return string - a string 
      **/
-    string Skills::to_string() {
+    string Skills::to_string() const {
         string ret = "";
 
-        for (std::map<EnumSkill, Skill*>::iterator it = skillsMap.begin(); it != skillsMap.end(); ++it) {
-            ret += internal_to_string(*it);
+        for(int skill = 0; skill < SKILL_COUNT; skill++) {
+            ret += internal_to_string((EnumSkill)skill, skills[skill]);
         }
 
         return ret;
@@ -882,14 +1117,6 @@ namespace ORPG {
         this->prof = is_prof;
     }
 
-    /**
-     * @desc Deconstructor for AbilityScore that is passed no arguments.
-     * Currently does nothing, and the compiler handles deconstruction.
-     */
-    AbilityScore::~AbilityScore() {
-        // TODO
-    }
-
     /**
      * @desc Setter method for score and is_prof. is_prof is a boolean
      * representation of whether or not a proficiency bonus should be added to
@@ -930,7 +1157,7 @@ namespace ORPG {
      *
      * @return uint8 - an unsigned 8-bit integer of the AbilityScore's score
      */
-    uint8 AbilityScore::get_score() {
+    uint8 AbilityScore::get_score() const {
         return this->score;
     }
 
@@ -942,7 +1169,7 @@ namespace ORPG {
      *
      * @return int8 - an 8-bit integer of the AbilityScore's modifier
      */
-    int8 AbilityScore::get_mod() {
+    int8 AbilityScore::get_mod() const {
         return modifier(this->score);
     }
 
@@ -955,7 +1182,7 @@ namespace ORPG {
      * @return bool - a boolean value denoting whether or not a proficiency
      * bonus should be added to the save of this AbilityScore
      */
-    bool AbilityScore::is_prof() {
+    bool AbilityScore::is_prof() const {
         return this->prof;
     }
 
@@ -966,70 +1193,38 @@ namespace ORPG {
      * 
      * @param uint8 def - the default value to use for all Ability scores
      */
-    AbilityScores::AbilityScores(uint8 def) {
-        this->scoresMap = {
-            { STR, new AbilityScore(def, false) },
-            { DEX, new AbilityScore(def, false) },
-            { CON, new AbilityScore(def, false) },
-            { INT, new AbilityScore(def, false) },
-            { WIS, new AbilityScore(def, false) },
-            { CHA, new AbilityScore(def, false) }
-        };
+    AbilityScores::AbilityScores(uint8 def):
+        scores{
+            AbilityScore(def, false),   // STR
+            AbilityScore(def, false),   // DEX
+            AbilityScore(def, false),   // CON
+            AbilityScore(def, false),   // INT
+            AbilityScore(def, false),   // WIS
+            AbilityScore(def, false)    // CHA
+        } {
+        /* Does nothing else currently */
     }
 
     /**
      * @desc Operator overload for adding two AbilityScores objects together.
      *
-     * @param const AbilityScores obj - the LHS AbilityScores object during the
+     * @param const AbilityScores& obj - the RHS AbilityScores object during the
      * addition operator.
      *
-     * @return AbilityScores& - an AbilityScores object containing the addition of
+     * @return AbilityScores - an AbilityScores object containing the addition of
      * the calling object and the passed AbilityScores object
      **/
-    AbilityScores AbilityScores::operator+(AbilityScores obj) {
+    AbilityScores AbilityScores::operator+(const AbilityScores& obj) const {
         AbilityScores ret;
 
-        ret.set(EnumAbilityScore::STR,
-                scoresMap[EnumAbilityScore::STR]->get_score()
-                + obj.get_score(EnumAbilityScore::STR),
-                scoresMap[EnumAbilityScore::STR]->is_prof() || obj.is_prof(EnumAbilityScore::STR));
-
-        ret.set(EnumAbilityScore::DEX,
-                scoresMap[EnumAbilityScore::DEX]->get_score()
-                + obj.get_score(EnumAbilityScore::DEX),
-                scoresMap[EnumAbilityScore::DEX]->is_prof() || obj.is_prof(EnumAbilityScore::DEX));
-
-        ret.set(EnumAbilityScore::CON,
-                scoresMap[EnumAbilityScore::CON]->get_score()
-                + obj.get_score(EnumAbilityScore::CON),
-                scoresMap[EnumAbilityScore::CON]->is_prof() || obj.is_prof(EnumAbilityScore::CON));
-
-        ret.set(EnumAbilityScore::INT,
-                scoresMap[EnumAbilityScore::INT]->get_score()
-                + obj.get_score(EnumAbilityScore::INT),
-                scoresMap[EnumAbilityScore::INT]->is_prof() || obj.is_prof(EnumAbilityScore::INT));
-
-        ret.set(EnumAbilityScore::WIS,
-                scoresMap[EnumAbilityScore::WIS]->get_score()
-                + obj.get_score(EnumAbilityScore::WIS),
-                scoresMap[EnumAbilityScore::WIS]->is_prof() || obj.is_prof(EnumAbilityScore::WIS));
-
-        ret.set(EnumAbilityScore::CHA,
-                scoresMap[EnumAbilityScore::CHA]->get_score()
-                + obj.get_score(EnumAbilityScore::CHA),
-                scoresMap[EnumAbilityScore::CHA]->is_prof() || obj.is_prof(EnumAbilityScore::CHA));
+        for(int ability = 0; ability < ABILITY_SCORE_COUNT; ability++) {
+            ret.scores[ability].set(scores[ability].get_score() + obj.scores[ability].get_score(),
+                                    scores[ability].is_prof() || obj.scores[ability].is_prof());
+        }
 
         return ret;
     }
 
-    /**
-     * @desc Deconstructor for AbilityScores that is passed no arguments.
-     * Currently does nothing, and the compiler handles deconstruction.
-     */
-    AbilityScores::~AbilityScores() {
-        // TODO
-    }
-
     /**
      * @desc Setter method for an AbilityScore's score and is_prof, denoted
      * by EnumAbilityScore ability. is_prof is a boolean representation of
@@ -1042,7 +1237,8 @@ namespace ORPG {
      * proficiency bonus should be added to the save of the given AbilityScore
      */
     void AbilityScores::set(EnumAbilityScore ability, uint8 newScore, bool is_prof) {
-        scoresMap[ability]->set(newScore, is_prof);
+        scores[ability].set(newScore, is_prof);
+        dirty |= 1 << ability;
     }
 
     /**
@@ -1056,7 +1252,8 @@ namespace ORPG {
      * EnumAbilityScore ability
      */
     AbilityScore* AbilityScores::get(EnumAbilityScore ability) {
-        return scoresMap[ability];
+        dirty |= 1 << ability;
+        return &scores[ability];
     }
 
     /**
@@ -1069,7 +1266,8 @@ namespace ORPG {
      * @param uint8 score - the unsigned 8-bit integer score value to set.
      */
     void AbilityScores::set_score(EnumAbilityScore ability, uint8 score) {
-        scoresMap[ability]->set_score(score);
+        scores[ability].set_score(score);
+        dirty |= 1 << ability;
     }
 
     /**
@@ -1083,7 +1281,8 @@ namespace ORPG {
      * proficiency bonus should be added to the save of the given AbilityScore
      */
     void AbilityScores::set_is_prof(EnumAbilityScore ability, bool is_prof) {
-        scoresMap[ability]->set_is_prof(is_prof);
+        scores[ability].set_is_prof(is_prof);
+        dirty |= 1 << ability;
     }
 
     /**
@@ -1095,73 +1294,42 @@ namespace ORPG {
      * set to true.
      */
     void AbilityScores::set_current_prof(uint8 newProf) {
-        curProf = newProf;
-    }
-
-    /**
-     * NOTE(incomingstick): Should this be accessable to the library at large?
-     **/
-    Background* background_selector(const int identifier = -1) {
-        const auto id = (identifier <= -1) ?
-            Characters::random_bg_id() : identifier;
-
-        switch(id) {
-        case Acolyte::ID : {
-            return new Acolyte();
-        }
-
-        default: {
-            return nullptr;
-        }
-        }
-    }
-
-    /**
-     * NOTE(incomingstick): Should this be accessable to the library at large?
-     **/
-    CharacterClass* class_selector(const int identifier = -1) {
-        const auto id = (identifier <= -1) ?
-            Characters::random_class_id() : identifier;
-
-        switch(id) {
-        case Wizard::ID : {
-            return new Wizard();
-        }
+        // every save, and every skill via its ability, depends on this
+        if(curProf != newProf) dirty = ALL_ABILITIES_DIRTY;
 
-        default: {
-            return nullptr;
-        }
-        }
+        curProf = newProf;
     }
 
-    Character::Character(Race* racePtr, AbilityScores* ab, CharacterClass* classPtr,
-                        const int bgID, Skills* sk, std::string name):
+    Character::Character(const Race* racePtr, AbilityScores* ab, const CharacterClass* classPtr,
+                        const int bgID, Skills* sk, std::string name, NameProvider* names):
                         race(racePtr), abils(ab), cClass(classPtr), skills(sk) {
-        bg = background_selector(bgID);
+        bg = Characters::select_background(bgID);
 
         if(name.empty()) {
-            NameGenerator ng(race->to_string());
+            if(names == nullptr) names = &Characters::default_name_provider();
 
-            firstName = ng.make_first();
-            lastName = ng.make_last();
+            names->make_name(*race, firstName, lastName);
         } else {
-            /* TODO make this work by parsing the name into a first and last */
-            firstName = name;
-            lastName = name;
+            /* NOTE(incomingstick): everything after the first space is the last name */
+            const size_t space = name.find(' ');
+
+            firstName = name.substr(0, space);
+            lastName = space == string::npos ? "" : name.substr(space + 1);
         }
 
         Initialize();
     }
 
     Character::~Character() {
-        // TODO nothing yet
+        // race, cClass and bg are shared, and are not ours to delete
+        delete abils;
+        delete skills;
     }
 
     void Character::Initialize() {
         race->applyRacialBonus(abils);
 
         /* Make some of our interals aware of who we are */
-        cClass->set_owner(this);
         skills->set_owner(this);
 
         max_hp = cClass->HIT_DIE_MAX() + CON_MOD(); // maximum hit points
@@ -1172,35 +1340,98 @@ namespace ORPG {
         curr_exp = 0;                               // current experience
         max_exp = EXP[level-1];                     // experience needed for next level
 
+        abils->set_current_prof(prof);
+
+        // nothing has been derived for this Character yet
+        abils->mark_dirty();
+
         // TODO Apply racial bonuses here? Or during the request process?
         update_skills();
     }
 
-    // TODO(incomingstick): Make this more efficient
+    void Character::set_ability_score(EnumAbilityScore ability, uint8 score) {
+        const int oldConMod = CON_MOD();
+
+        abils->set_score(ability, score);
+
+        // Constitution applies to hit points once per level
+        const int hpDelta = (CON_MOD() - oldConMod) * level;
+        max_hp += hpDelta;
+        curr_hp += hpDelta;
+    }
+
+    void Character::set_level(int newLevel) {
+        level = std::max(1, std::min(20, newLevel));
+        prof = 2 + (level - 1) / 4;
+        max_exp = EXP[std::min(level, 19) - 1];
+
+        abils->set_current_prof(prof);
+    }
+
+    int Character::level_up() {
+        if(level >= 20) return 0;
+
+        const int gain = std::max(1, cClass->roll_hit_die() + CON_MOD());
+
+        max_hp += gain;
+        curr_hp += gain;
+
+        set_level(level + 1);
+
+        return gain;
+    }
+
+    int Character::add_exp(int amount) {
+        const int oldLevel = level;
+
+        curr_exp += amount;
+
+        while(level < 20 && curr_exp >= max_exp) level_up();
+
+        return level - oldLevel;
+    }
+
+    void Character::set_hit_points(int current, int maximum, int temp) {
+        curr_hp = current;
+        max_hp = maximum;
+        temp_hp = temp;
+    }
+
+    /**
+     * NOTE(incomingstick): This walks the SKILL_ABILITY table rather than every skill
+     * by hand, and only touches the saves and skills whose ability (or proficiency)
+     * changed since the last call. When nothing is dirty it returns immediately.
+     **/
     void Character::update_skills() {
-        skills->get(ACR)->set_mod(DEX_MOD());    // Acrobatics       (DEX)
-        skills->get(ANM)->set_mod(WIS_MOD());    // Animal Handling  (WIS)
-        skills->get(ARC)->set_mod(INT_MOD());    // Arcana           (INT)
-        skills->get(ATH)->set_mod(STR_MOD());    // Athletics        (STR)
-        skills->get(DEC)->set_mod(CHA_MOD());    // Deception        (CHA)
-        skills->get(HIS)->set_mod(INT_MOD());    // History          (INT)
-        skills->get(INS)->set_mod(WIS_MOD());    // Insight          (WIS)
-        skills->get(ITM)->set_mod(CHA_MOD());    // Intimidation     (CHA)
-        skills->get(INV)->set_mod(INT_MOD());    // Investigation    (INT)
-        skills->get(MED)->set_mod(WIS_MOD());    // Medicine         (WIS)
-        skills->get(NAT)->set_mod(INT_MOD());    // Nature           (INT)
-        skills->get(PRC)->set_mod(WIS_MOD());    // Perception       (WIS)
-        skills->get(PRF)->set_mod(CHA_MOD());    // Performance      (CHA)
-        skills->get(PRS)->set_mod(CHA_MOD());    // Persuasion       (CHA)
-        skills->get(REL)->set_mod(INT_MOD());    // Religion         (INT)
-        skills->get(SLE)->set_mod(DEX_MOD());    // Sleight of Hand  (DEX)
-        skills->get(STL)->set_mod(DEX_MOD());    // Stealth          (DEX)
-        skills->get(SUR)->set_mod(WIS_MOD());    // Survival         (WIS)
+        const uint8 abilDirty = abils->dirty_mask();
+        const uint32 skillDirty = skills->dirty_mask();
+
+        if(abilDirty == 0 && skillDirty == 0) return;
+
+        for(int ability = 0; ability < ABILITY_SCORE_COUNT; ability++) {
+            if(abilDirty & (1 << ability)) {
+                saves[ability] = abils->get_save((EnumAbilityScore)ability);
+            }
+        }
+
+        for(int skill = 0; skill < SKILL_COUNT; skill++) {
+            const EnumAbilityScore ability = SKILL_ABILITY[skill];
+
+            if((abilDirty & (1 << ability)) || (skillDirty & (1 << skill))) {
+                skills->set_mod((EnumSkill)skill, abils->get_mod(ability));
+                checks[skill] = skills->get_mod((EnumSkill)skill);
+            }
+        }
+
+        abils->clear_dirty();
+        skills->clear_dirty();
     }
 
     string Character::to_string() {
         string ret("");
 
+        update_skills();
+
         ret += "First: "+ (firstName.empty() || firstName == "NULL" ? "" : firstName) +"\n";
         ret += "Last: " + (lastName.empty() || lastName == "NULL" ? "" : lastName) +"\n";
 
@@ -1240,150 +1471,136 @@ namespace ORPG {
         return ret;
     }
 
+    /* escapes the characters JSON does not allow inside of a string */
+    static string json_string(const string& str) {
+        string ret("\"");
+
+        for(char c : str) {
+            switch(c) {
+            case '"':  ret += "\\\""; break;
+            case '\\': ret += "\\\\"; break;
+            case '\n': ret += "\\n"; break;
+            case '\r': ret += "\\r"; break;
+            case '\t': ret += "\\t"; break;
+            default: {
+                if((unsigned char)c < 0x20) {
+                    char buff[8];
+                    snprintf(buff, sizeof(buff), "\\u%04x", (unsigned char)c);
+                    ret += buff;
+                } else {
+                    ret += c;
+                }
+            }
+            }
+        }
+
+        return ret + "\"";
+    }
+
+    string Character::to_json() {
+        static const char* abilityKeys[ABILITY_SCORE_COUNT] = {
+            "str", "dex", "con", "int", "wis", "cha"
+        };
+
+        string ret("{");
+
+        update_skills();
+
+        ret += "\"first\":" + json_string(firstName == "NULL" ? "" : firstName);
+        ret += ",\"last\":" + json_string(lastName == "NULL" ? "" : lastName);
+        ret += ",\"race\":" + json_string(race->to_string());
+        ret += ",\"background\":" + json_string(bg->to_string());
+        ret += ",\"class\":" + json_string(cClass->to_string());
+        ret += ",\"level\":" + std::to_string(level);
+        ret += ",\"exp\":" + std::to_string(curr_exp);
+        ret += ",\"hp\":{\"current\":" + std::to_string(curr_hp) +
+               ",\"max\":" + std::to_string(max_hp) +
+               ",\"temp\":" + std::to_string(temp_hp) + "}";
+        ret += ",\"proficiency\":" + std::to_string(prof);
+
+        ret += ",\"abilities\":{";
+        for(int i = 0; i < ABILITY_SCORE_COUNT; i++) {
+            if(i != 0) ret += ",";
+            ret += "\"" + string(abilityKeys[i]) + "\":" +
+                   std::to_string(abils->get_score((EnumAbilityScore)i));
+        }
+        ret += "}";
+
+        ret += ",\"passive_perception\":" + std::to_string(PASSIVE(EnumSkill::PRC));
+
+        return ret + "}";
+    }
+
     string Character::to_ascii_sheet() {
-        string ret("");
+        string ret;
+
+        to_ascii_sheet(ret);
+
+        return ret;
+    }
+
+    void Character::to_ascii_sheet(string& out) {
+        to_ascii_sheet(out, ascii_sheet_template());
+    }
 
-        const int SPACES_PER_MOD = 3;
+    void Character::to_ascii_sheet(string& out, const SheetTemplate& sheet) {
+        out.clear();
 
         update_skills();
 
-        //TODO A couple magic numbers in this function, possibly replace later
+        /* NOTE(incomingstick): the layout lives in ASCII_SHEET_TEMPLATE, here we only
+            format the values. Numbers are printed in to fixed scratch space, and the
+            strings are used in place, so nothing below allocates */
+        // room for the longest "%i/%i", "-2147483648/-2147483648"
+        char scratch[SHEET_FIELD_COUNT][24];
+        SheetValue values[SHEET_FIELD_COUNT];
 
-        //Second argument is 23 because there are 23 allotted spaces for the first name
-        string charFName = Utils::leftpad(firstName, 23, ' ');
+        auto text = [&](int field, const string& str) {
+            values[field] = { str.data(), str.size() };
+        };
 
-        //Second arg is 22 because thats how many spaces we alloted for last name
-        string charLName = Utils::leftpad(lastName, 22, ' ');
+        auto number = [&](int field, const char* format, int a, int b) {
+            int len = snprintf(scratch[field], sizeof(scratch[field]), format, a, b);
+            len = min(max(len, 0), (int)sizeof(scratch[field]) - 1);
+            values[field] = { scratch[field], (size_t)len };
+        };
 
-        //Second arg is 12 because thats how many spaces we alloted for backgrounds
-        string charBg = Utils::rightpad(bg->to_string(), 12, ' ');
+        auto mod = [&](int field, int value) {
+            number(field, value > 0 ? "+%i" : "%i", value, 0);
+        };
 
-        //Second arg is 12 because thats how many spaces we alloted for the race
-        string charRace = Utils::rightpad(race->to_string(), 14, ' ');
+        const string& raceStr = race->to_string();
+        const string& bgStr = bg->to_string();
+        const string& classStr = cClass->to_string();
 
-        string charEXP = std::to_string(curr_exp) + '/' + std::to_string(max_exp);
-        charEXP = Utils::rightpad(charEXP, 10, ' ');
+        text(SHEET_FIRST_NAME, firstName);
+        text(SHEET_LAST_NAME, lastName);
+        text(SHEET_RACE, raceStr);
+        text(SHEET_BACKGROUND, bgStr);
+        text(SHEET_CLASS, classStr);
 
-        string sProf = format_mod(prof, SPACES_PER_MOD);
+        number(SHEET_LEVEL, "%i", level, 0);
+        number(SHEET_EXP, "%i/%i", curr_exp, max_exp);
+        number(SHEET_HP, "%i/%i", curr_hp, max_hp);
+        mod(SHEET_PROF, prof);
 
-        string sSTR = Utils::rightpad(std::to_string(STR()), SPACES_PER_MOD, ' ');
-        string sSTRMod = format_mod(STR_MOD(), SPACES_PER_MOD);
-        
-        string sDEX = Utils::rightpad(std::to_string(DEX()), SPACES_PER_MOD, ' ');
-        string sDEXMod = format_mod(DEX_MOD(), SPACES_PER_MOD);
-        
-        string sCON = Utils::rightpad(std::to_string(DEX()), SPACES_PER_MOD, ' ');
-        string sCONMod = format_mod(CON_MOD(), SPACES_PER_MOD);
-        
-        string sINT = Utils::rightpad(std::to_string(INT()), SPACES_PER_MOD, ' ');
-        string sINTMod = format_mod(INT_MOD(), SPACES_PER_MOD);
-        
-        string sWIS = Utils::rightpad(std::to_string(WIS()), SPACES_PER_MOD, ' ');
-        string sWISMod = format_mod(WIS_MOD(), SPACES_PER_MOD);
-        
-        string sCHA = Utils::rightpad(std::to_string(CHA()), SPACES_PER_MOD, ' ');
-        string sCHAMod = format_mod(CHA_MOD(), SPACES_PER_MOD);
-
-        string sACR = format_mod(skills->get_mod(ACR), SPACES_PER_MOD);
-        string sANM = format_mod(skills->get_mod(ANM), SPACES_PER_MOD);
-        string sARC = format_mod(skills->get_mod(ARC), SPACES_PER_MOD);
-        string sATH = format_mod(skills->get_mod(ATH), SPACES_PER_MOD);
-        string sDEC = format_mod(skills->get_mod(DEC), SPACES_PER_MOD);
-        string sHIS = format_mod(skills->get_mod(HIS), SPACES_PER_MOD);
-        string sINS = format_mod(skills->get_mod(INS), SPACES_PER_MOD);
-        string sITM = format_mod(skills->get_mod(ITM), SPACES_PER_MOD);
-        string sINV = format_mod(skills->get_mod(INV), SPACES_PER_MOD);
-        string sMED = format_mod(skills->get_mod(MED), SPACES_PER_MOD);
-        string sNAT = format_mod(skills->get_mod(NAT), SPACES_PER_MOD);
-        string sPRC = format_mod(skills->get_mod(PRC), SPACES_PER_MOD);
-        string sPRF = format_mod(skills->get_mod(PRF), SPACES_PER_MOD);
-        string sPRS = format_mod(skills->get_mod(PRS), SPACES_PER_MOD);
-        string sREL = format_mod(skills->get_mod(REL), SPACES_PER_MOD);
-        string sSLE = format_mod(skills->get_mod(SLE), SPACES_PER_MOD);
-        string sSTL = format_mod(skills->get_mod(STL), SPACES_PER_MOD);
-        string sSUR = format_mod(skills->get_mod(SUR), SPACES_PER_MOD);
-
-        string passPRC = format_mod(passive_stat(skills->get_mod(SUR)), SPACES_PER_MOD);
-
-        //TODO pull this into its own files
-        //NOTE(var_username): To be fair, this is quite lazy on my part
-        /* NOTE(incomingstick): this likely should be put in its own file with tags in the file as
-        * placeholders for the different variables. That would pull this out from cluttering the
-        * source code, as well as allowing for people to create their own styles with our predefined tags
-        */
-
-        ret += "                         ╭────────────────────────────────────────────────────╮\n";
-        ret += " ────────────────────────┤                  "+ charBg +"                      │\n";
-        ret += " \\" + charFName +      "│Class & Level     Background      Player Name       │\n";
-        ret += "  \\"+ charLName +      "│                                                    │\n";
-        ret += "_ ───────────────────────┤"+ charRace +"                    "+charEXP+"        │\n";
-        ret += "__\\  Character Name      │Race              Alignment       Experience Points │\n";
-        ret += "                         ╰────────────────────────────────────────────────────╯\n";
-        ret += "╭───╮╭─────────────────────────────────────────────────────────────────────────\n";
-        ret += "│STR││╭───┬─────────────────╮╭───────────────────────╮╭───────────────────────╮\n";
-        ret += "│"+sSTR+"│││   │   Inspiration   ││  ╭───╮  ╭────╮  ╭───╮ ││╭─────────────────────╮│\n";
-        ret += "├───┤│╰───┴─────────────────╯│  │   │  │    │  │   │ │││                     ││\n";
-        ret += "│"+sSTRMod+"││                       │  ├───┤  ├────┤  ├───┤ │││                     ││\n";
-        ret += "╰───╯│╭───┬─────────────────╮│  │ AC│  │Init│  │SPD│ │││                     ││\n";
-        ret += "     ││"+sProf+"│   Proficiency   ││  ╰───╯  ╰────╯  ╰───╯ │││                     ││\n";
-        ret += "╭───╮│╰───┴─────────────────╯│                       │││                     ││\n";
-        ret += "│DEX││                       │  ╭──────────────────╮ │││  Personality Traits ││\n";
-        ret += "│"+sDEX+"││╭─┬───┬───────────────╮│  │                  │ ││├─────────────────────┤│\n";
-        ret += "├───┤││ │   │      STR      ││  │                  │ │││                     ││\n";
-        ret += "│"+sDEXMod+"│││ │   │      DEX      ││  │     Curr. HP     │ │││                     ││\n";
-        ret += "╰───╯││ │   │      CON      ││  ├──────────────────┤ │││        Ideals       ││\n";
-        ret += "     ││ │   │      INT      ││  │                  │ ││├─────────────────────┤│\n";
-        ret += "╭───╮││ │   │      WIS      ││  │     Temp. HP     │ │││                     ││\n";
-        ret += "│CON│││ │   │      CHA      ││  ╰──────────────────╯ │││                     ││\n";
-        ret += "│"+sCON+"││├─┴───┴───────────────┤│                       │││        Bonds        ││\n";
-        ret += "├───┤││    Saving throws    ││ ╭────────╮ ╭────────╮ ││├─────────────────────┤│\n";
-        ret += "│"+sCONMod+"││╰─────────────────────╯│ │        │ │S O-O-O │ │││                     ││\n";
-        ret += "╰───╯│                       │ ├────────┤ │F O-O-O │ │││                     ││\n";
-        ret += "     │╭─┬───┬───────────────╮│ │Hit Dice│ │ Saves  │ │││        Flaws        ││\n";
-        ret += "╭───╮││ │"+sACR+"│Acrobatics     ││ ╰────────╯ ╰────────╯ ││╰─────────────────────╯│\n";
-        ret += "│INT│││ │"+sANM+"│Animal Handling│╰───────────────────────╯╰───────────────────────╯\n";
-        ret += "│"+sINT+"│││ │"+sARC+"│Arcana         │╭────────┬─────┬────────╮╭───────────────────────╮\n";
-        ret += "├───┤││ │"+sATH+"│Athletics      ││Name    │ ATK │DMG Type││                       │\n";
-        ret += "│"+sINTMod+"│││ │"+sDEC+"│Deception      ││        │     │        ││                       │\n";
-        ret += "╰───╯││ │"+sHIS+"│History        ││        │     │        ││                       │\n";
-        ret += "     ││ │"+sINS+"│Insight        ││        │     │        ││                       │\n";
-        ret += "╭───╮││ │"+sITM+"│Intimidation   │├────────┴─────┴────────┤│                       │\n";
-        ret += "│WIS│││ │"+sINV+"│Investigation  ││                       ││                       │\n";
-        ret += "│"+sWIS+"│││ │"+sWISMod+"│Medicine       ││                       ││                       │\n";
-        ret += "├───┤││ │"+sNAT+"│Nature         ││                       ││                       │\n";
-        ret += "│"+sWISMod+"│││ │"+sPRC+"│Perception     ││                       ││                       │\n";
-        ret += "╰───╯││ │"+sPRF+"│Performance    ││                       ││                       │\n";
-        ret += "     ││ │"+sPRS+"│Persuassion    ││                       ││                       │\n";
-        ret += "╭───╮││ │"+sREL+"│Religion       ││                       ││                       │\n";
-        ret += "│CHA│││ │"+sSLE+"│Sleight of Hand││                       ││                       │\n";
-        ret += "│"+sCHA+"│││ │"+sSTL+"│Stealth        ││                       ││                       │\n";
-        ret += "├───┤││ │"+sSUR+"│Survival       ││                       ││                       │\n";
-        ret += "│"+sCHAMod+"││├─┴───┴───────────────┤├───────────────────────┤│                       │\n";
-        ret += "╰───╯││       Skills        ││  Attacks and Spells   ││                       │\n";
-        ret += "─────╯╰─────────────────────╯╰───────────────────────╯│                       │\n";
-        ret += "╭───┬───────────────────────╮╭──┬────┬───────────────╮│                       │\n";
-        ret += "│"+passPRC+"│    Passive Perception |│CP│    │               ││                       │\n";
-        ret += "╰───┴───────────────────────╯│SP│    │               ││                       │\n";
-        ret += "╭───────────────────────────╮│EP│    │               ││                       │\n";
-        ret += "│                           ││GP│    │               ││                       │\n";
-        ret += "│                           ││PP│    │               ││                       │\n";
-        ret += "│                           │├──┴────╯               ││                       │\n";
-        ret += "│                           ││                       ││                       │\n";
-        ret += "│                           ││                       ││                       │\n";
-        ret += "│                           ││                       ││                       │\n";
-        ret += "│                           ││                       ││                       │\n";
-        ret += "├───────────────────────────┤├───────────────────────┤├───────────────────────┤\n";
-        ret += "│    Other Proficiencies    ││       Equipment       ││  Features and Traits  │\n";
-        ret += "╰───────────────────────────╯╰───────────────────────╯╰───────────────────────╯\n";
+        for(int ability = 0; ability < ABILITY_SCORE_COUNT; ability++) {
+            number(SHEET_STR + 2 * ability, "%i", ABILITY_SCORE((EnumAbilityScore)ability), 0);
+            mod(SHEET_STR_MOD + 2 * ability, SCORE_MOD((EnumAbilityScore)ability));
+        }
 
-        return ret;
+        for(int skill = 0; skill < SKILL_COUNT; skill++) {
+            mod(SHEET_SKILL + skill, SKILL_MOD((EnumSkill)skill));
+        }
+
+        mod(SHEET_PASSIVE_PERCEPTION, PASSIVE(PRC));
+
+        sheet.render(values, out);
     }
 
     uint8 gen_stat() {
-        /*
-         * TODO accept different types of stat generation
-         * i.e 4d4+4 or 4d6h3+2
-         */
+        /* NOTE(incomingstick): other ways of generating scores (i.e 4d6h3,
+            4d4+4, or the standard array) are handled by ScoreMethod */
 
         Die d6(6);
 
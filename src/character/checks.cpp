@@ -0,0 +1,169 @@
+/*
+characters - checks.cpp
+Created on: Oct 18, 2026
+
+OpenRPG Software License - Version 1.0 - February 10th, 2017 <https://openrpg.io/about/license/>
+This is free software: you are free to change and redistribute it.
+There is NO WARRANTY, to the extent permitted by law.
+*/
+#include <algorithm>
+
+#include "character/checks.h"
+
+/* the number of raw engine draws each pass of roll_dice() works on */
+#define DICE_BLOCK_SIZE         1024
+
+/* how much of each 32 bit engine draw roll_dice() spends on rolls */
+#define DICE_DRAW_BITS          26
+
+using namespace std;
+
+namespace ORPG {
+    namespace Characters {
+        void roll_dice(const Die& die, size_t count, uint8* out, Utils::RandomEngine& engine) {
+            const int max = die.MAX();
+
+            // Die keeps at least 2 sides, but a die with fewer could only ever
+            // roll its sides, and would never leave the loop below
+            if(max < 2) {
+                fill(out, out + count, (uint8)std::max(max, 0));
+                return;
+            }
+
+            const uint32 sides = (uint32)max;
+
+            // split each 32 bit draw into as many rolls as fit in DICE_DRAW_BITS bits,
+            // i.e 6 rolls of a d20 from one draw, treating it as a base sides number
+            uint32 perDraw = 1;
+            uint64 range = sides;
+
+            while(range * sides <= (1ULL << DICE_DRAW_BITS)) {
+                range *= sides;
+                perDraw++;
+            }
+
+            // a draw whose low half falls under this would make some rolls a hair more
+            // likely than the rest, see Lemire's "Fast Random Integer Generation in an
+            // Interval". It is under 1 in 64 draws, so these are rerolled afterwards.
+            const uint32 threshold = (uint32)(0x100000000ULL % range);
+
+            uint32 values[DICE_BLOCK_SIZE];
+            uint8 biased[DICE_BLOCK_SIZE];
+
+            for(size_t done = 0; done < count; done += DICE_BLOCK_SIZE * perDraw) {
+                const size_t draws = min<size_t>(DICE_BLOCK_SIZE, (count - done + perDraw - 1) / perDraw);
+
+                for(size_t i = 0; i < draws; i++) values[i] = (uint32)engine();
+
+                size_t rerolls = 0;
+
+                for(size_t i = 0; i < draws; i++) {
+                    const uint64 scaled = (uint64)values[i] * range;
+
+                    values[i] = (uint32)(scaled >> 32);
+                    biased[i] = (uint32)scaled < threshold;
+                    rerolls += biased[i];
+                }
+
+                for(size_t i = 0; rerolls > 0 && i < draws; i++) {
+                    if(!biased[i]) continue;
+
+                    uint64 scaled;
+
+                    do {
+                        scaled = (uint64)(uint32)engine() * range;
+                    } while((uint32)scaled < threshold);
+
+                    values[i] = (uint32)(scaled >> 32);
+                }
+
+                for(size_t i = 0; i < draws; i++) {
+                    const size_t first = done + i * perDraw;
+                    const size_t last = min<size_t>(first + perDraw, count);
+                    uint32 value = values[i];
+
+                    for(size_t n = first; n < last; n++) {
+                        out[n] = (uint8)(value % sides + 1);
+                        value /= sides;
+                    }
+                }
+            }
+        }
+
+        void roll_d20s(size_t count, uint8* out, EnumRollMode mode) {
+            static const Die d20(20);
+            auto& engine = Utils::thread_engine();
+
+            roll_dice(d20, count, out, engine);
+
+            if(mode == NORMAL_ROLL) return;
+
+            vector<uint8> second(count);
+            roll_dice(d20, count, second.data(), engine);
+
+            if(mode == ADVANTAGE) {
+                for(size_t i = 0; i < count; i++) out[i] = max(out[i], second[i]);
+            } else {
+                for(size_t i = 0; i < count; i++) out[i] = min(out[i], second[i]);
+            }
+        }
+
+        CheckResult resolve_checks(const int8* mods, size_t count, int dc, EnumRollMode mode) {
+            CheckResult ret;
+
+            ret.count = count;
+            ret.passes = 0;
+            ret.passed.assign((count + 63) / 64, 0);
+            ret.totals.resize(count);
+
+            vector<uint8> rolls(count);
+            roll_d20s(count, rolls.data(), mode);
+
+            for(size_t i = 0; i < count; i++) ret.totals[i] = (int16)(rolls[i] + mods[i]);
+
+            // pack a word at a time, so the inner loop has no data dependent branches
+            for(size_t word = 0; word < ret.passed.size(); word++) {
+                const size_t begin = word * 64;
+                const size_t end = min(count, begin + 64);
+                uint64 bits = 0;
+
+                for(size_t i = begin; i < end; i++) {
+                    const uint64 pass = ret.totals[i] >= dc;
+
+                    bits |= pass << (i - begin);
+                    ret.passes += pass;
+                }
+
+                ret.passed[word] = bits;
+            }
+
+            return ret;
+        }
+
+        CheckResult roll_checks(const vector<Character*>& characters, EnumSkill skill,
+                                int dc, EnumRollMode mode) {
+            vector<int8> mods(characters.size());
+
+            for(size_t i = 0; i < characters.size(); i++) mods[i] = characters[i]->SKILL_MOD(skill);
+
+            return resolve_checks(mods.data(), mods.size(), dc, mode);
+        }
+
+        CheckResult roll_saves(const vector<Character*>& characters, EnumAbilityScore ability,
+                               int dc, EnumRollMode mode) {
+            vector<int8> mods(characters.size());
+
+            for(size_t i = 0; i < characters.size(); i++) mods[i] = characters[i]->SCORE_SAVE(ability);
+
+            return resolve_checks(mods.data(), mods.size(), dc, mode);
+        }
+
+        CheckResult roll_saves(const Population& population, EnumAbilityScore ability,
+                               int dc, EnumRollMode mode) {
+            vector<int8> mods(population.size());
+            population.saves(ability, mods.data());
+
+            return resolve_checks(mods.data(), mods.size(), dc, mode);
+        }
+    }
+}
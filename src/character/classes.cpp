@@ -33,23 +33,34 @@ namespace ORPG {
             }
         }
 
+        const std::vector<uint>& character_class_ids() {
+            static const std::vector<uint> ids = { Wizard::ID };
+            return ids;
+        }
+
         /**
          * @desc This function takes in an integer, ideally a CharacterClass::ID,
-         * creates a new CharacterClass of that ID type and returns a pointer to it.
-         * If an ID less than 0 is passed we instead will randomly select a 
+         * and returns a pointer to the shared CharacterClass registered under that
+         * ID. If an ID less than 0 is passed we instead will randomly select a
          * CharacterClass type to return.
+         *
+         * NOTE(incomingstick): function statics are initialized exactly once, even
+         * across threads, so each CharacterClass is built the first time it is
+         * asked for and lives until the program exits.
          * 
-         * @param const int identifier - the CharacterClass of the class to be generated
+         * @param const int identifier - the CharacterClass::ID of the class to look up
          * 
-         * @return CharacterClass* - a pointer to the newly created CharacterClass
+         * @return const CharacterClass* - a pointer to the shared CharacterClass,
+         * or nullptr if the ID is unknown
          **/
-        CharacterClass* select_character_class(const int identifier) {
+        const CharacterClass* select_character_class(const int identifier) {
             const auto id = (identifier < 0) ?
                 random_class_id() : identifier;
 
             switch(id) {
             case Wizard::ID : {
-                return new Wizard();
+                static const Wizard wizard;
+                return &wizard;
             }
 
             default: {
@@ -0,0 +1,245 @@
+/*
+characters - combat.cpp
+Created on: Oct 18, 2026
+
+OpenRPG Software License - Version 1.0 - February 10th, 2017 <https://openrpg.io/about/license/>
+This is free software: you are free to change and redistribute it.
+There is NO WARRANTY, to the extent permitted by law.
+*/
+#include <algorithm>
+#include <memory>
+#include <random>
+
+#include "core/thread-pool.h"
+#include "core/utils.h"
+#include "roll/expression-cache.h"
+#include "roll/roll-parser.h"
+#include "character/combat.h"
+
+using namespace std;
+
+namespace ORPG {
+    double EncounterResult::mean_rounds() const {
+        if(combats == 0) return 0.0;
+
+        double sum = 0.0;
+        for(size_t n = 0; n < rounds.size(); n++) sum += (double)n * rounds[n];
+
+        return sum / combats;
+    }
+
+    double EncounterResult::mean_party_hp() const {
+        if(combats == 0) return 0.0;
+
+        double sum = 0.0;
+        for(size_t n = 0; n < partyHP.size(); n++) sum += (double)n * partyHP[n];
+
+        return sum / combats;
+    }
+
+    void EncounterResult::merge(const EncounterResult& other) {
+        combats += other.combats;
+        partyWins += other.partyWins;
+        monsterWins += other.monsterWins;
+        draws += other.draws;
+
+        for(size_t n = 0; n < rounds.size() && n < other.rounds.size(); n++) rounds[n] += other.rounds[n];
+        for(size_t n = 0; n < partyHP.size() && n < other.partyHP.size(); n++) partyHP[n] += other.partyHP[n];
+        for(size_t n = 0; n < survivors.size() && n < other.survivors.size(); n++) survivors[n] += other.survivors[n];
+    }
+
+    /* returns an EncounterResult with every count zeroed for a party of the given size */
+    static EncounterResult empty_result(size_t partySize) {
+        EncounterResult ret;
+
+        ret.combats = 0;
+        ret.partyWins = 0;
+        ret.monsterWins = 0;
+        ret.draws = 0;
+        ret.rounds.assign(COMBAT_MAX_ROUNDS + 1, 0);
+        ret.partyHP.assign(101, 0);
+        ret.survivors.assign(partySize, 0);
+
+        return ret;
+    }
+
+    Combatant make_combatant(Character& character, int armorClass, const vector<Attack>& attacks) {
+        Combatant ret;
+
+        ret.name = character.get_first_name();
+        if(!character.get_last_name().empty()) ret.name += " " + character.get_last_name();
+
+        for(int ability = 0; ability < ABILITY_SCORE_COUNT; ability++) {
+            ret.scores[ability] = character.ABILITY_SCORE((EnumAbilityScore)ability);
+        }
+
+        ret.maxHP = character.get_max_hp();
+        ret.armorClass = armorClass;
+        ret.attacks = attacks;
+
+        return ret;
+    }
+
+    EncounterSimulator::EncounterSimulator(const vector<Combatant>& partyList,
+                                           const vector<Combatant>& monsterList):
+        party(partyList), monsters(monsterList) {
+
+        if(party.empty() || monsters.empty()) {
+            errorStr = "an encounter needs at least one combatant on each side";
+            return;
+        }
+
+        for(auto side : { &party, &monsters }) {
+            for(auto& combatant : *side) {
+                for(auto& attack : combatant.attacks) {
+                    if(ExpressionCache::shared().get(attack.damage) == nullptr) {
+                        errorStr = combatant.name + ": invalid damage roll '" +
+                                   attack.damage + "' for " + attack.name;
+                        return;
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * A CombatWorker holds everything one task needs to run combats on its
+     * own: every damage roll, and the state of each fighter. A compiled
+     * Expression never changes, so every worker shares the cached ones.
+     **/
+    struct CombatWorker {
+        struct Fighter {
+            const Combatant* block;     // the stat block this fighter was made from
+            int side;                   // 0 for the party, 1 for the monsters
+            int index;                  // position within its side
+            int hp;                     // hit points left this combat
+            int initiative;             // initiative rolled this combat
+            size_t firstAttack;         // index of this fighters first attack in damage
+        };
+
+        vector<Fighter> fighters;
+        vector<shared_ptr<const Expression>> damage;
+        vector<Fighter*> order;
+        int totalPartyHP;
+
+        CombatWorker(const vector<Combatant>& party, const vector<Combatant>& monsters) {
+            int side = 0;
+            totalPartyHP = 0;
+
+            for(auto list : { &party, &monsters }) {
+                for(size_t i = 0; i < list->size(); i++) {
+                    const Combatant& block = (*list)[i];
+                    Fighter fighter = { &block, side, (int)i, 0, 0, damage.size() };
+
+                    for(auto& attack : block.attacks) {
+                        damage.push_back(ExpressionCache::shared().get(attack.damage));
+                    }
+
+                    if(side == 0) totalPartyHP += block.maxHP;
+
+                    fighters.push_back(fighter);
+                }
+
+                side++;
+            }
+
+            for(auto& fighter : fighters) order.push_back(&fighter);
+        }
+
+        /* runs a single combat and records how it went in result */
+        void run(Utils::RandomEngine& engine, EncounterResult& result) {
+            uniform_int_distribution<int> d20(1, 20);
+            int standing[2] = { 0, 0 };
+
+            for(auto& fighter : fighters) {
+                fighter.hp = fighter.block->maxHP;
+                fighter.initiative = d20(engine) + fighter.block->initiative_bonus();
+
+                // a fighter with no hit points is down before the combat starts
+                if(fighter.hp > 0) standing[fighter.side]++;
+            }
+
+            stable_sort(order.begin(), order.end(), [](const Fighter* a, const Fighter* b) {
+                return a->initiative > b->initiative;
+            });
+
+            int round = 0;
+
+            while(standing[0] > 0 && standing[1] > 0 && round < COMBAT_MAX_ROUNDS) {
+                round++;
+
+                for(auto attacker : order) {
+                    if(attacker->hp <= 0) continue;
+
+                    const vector<Attack>& attacks = attacker->block->attacks;
+
+                    for(size_t a = 0; a < attacks.size(); a++) {
+                        // focus on whichever enemy is closest to falling
+                        Fighter* target = nullptr;
+
+                        for(auto& fighter : fighters) {
+                            if(fighter.side == attacker->side || fighter.hp <= 0) continue;
+                            if(target == nullptr || fighter.hp < target->hp) target = &fighter;
+                        }
+
+                        if(target == nullptr) break;
+
+                        const int roll = d20(engine);
+
+                        if(roll == 1) continue;
+                        if(roll != 20 && roll + attacks[a].toHit < target->block->armorClass) continue;
+
+                        target->hp -= max(0, damage[attacker->firstAttack + a]->evaluate(engine));
+
+                        if(target->hp <= 0) standing[target->side]--;
+                    }
+
+                    if(standing[0] == 0 || standing[1] == 0) break;
+                }
+            }
+
+            int partyHP = 0;
+
+            for(auto& fighter : fighters) {
+                if(fighter.side != 0 || fighter.hp <= 0) continue;
+
+                partyHP += fighter.hp;
+                result.survivors[fighter.index]++;
+            }
+
+            result.combats++;
+            result.rounds[round]++;
+            result.partyHP[totalPartyHP > 0 ? partyHP * 100 / totalPartyHP : 0]++;
+
+            if(standing[1] == 0) result.partyWins++;
+            else if(standing[0] == 0) result.monsterWins++;
+            else result.draws++;
+        }
+    };
+
+    EncounterResult EncounterSimulator::run(uint64 combats, unsigned int threads) const {
+        EncounterResult ret = empty_result(party.size());
+
+        if(!is_valid() || combats == 0) return ret;
+
+        Core::ThreadPool pool(threads);
+
+        // a few tasks per thread, so an unlucky thread does not hold up the rest
+        const uint64 taskCount = min<uint64>(combats, pool.size() * 4);
+        vector<EncounterResult> partials(taskCount, ret);
+
+        pool.parallel_for(taskCount, [&](size_t task) {
+            const uint64 begin = combats * task / taskCount;
+            const uint64 end = combats * (task + 1) / taskCount;
+
+            CombatWorker worker(party, monsters);
+            auto& engine = Utils::thread_engine();
+
+            for(uint64 i = begin; i < end; i++) worker.run(engine, partials[task]);
+        });
+
+        for(auto& partial : partials) ret.merge(partial);
+
+        return ret;
+    }
+}
@@ -0,0 +1,241 @@
+/*
+characters - initiative.cpp
+Created on: Oct 18, 2026
+
+OpenRPG Software License - Version 1.0 - February 10th, 2017 <https://openrpg.io/about/license/>
+This is free software: you are free to change and redistribute it.
+There is NO WARRANTY, to the extent permitted by law.
+*/
+#include <algorithm>
+#include <random>
+
+#include "core/utils.h"
+#include "character/initiative.h"
+
+using namespace std;
+
+namespace ORPG {
+    /* returns true if a acts before b: earlier round, then higher initiative,
+        then higher Dexterity modifier, then whoever joined first */
+    static bool acts_before(const InitiativeTracker::Entry& a, const InitiativeTracker::Entry& b) {
+        if(a.round != b.round) return a.round < b.round;
+        if(a.initiative != b.initiative) return a.initiative > b.initiative;
+        if(a.dexMod != b.dexMod) return a.dexMod > b.dexMod;
+
+        return a.joined < b.joined;
+    }
+
+    InitiativeTracker::InitiativeTracker(): currentTurn(NONE), currentRound(1) {
+        /* Does nothing else currently */
+    }
+
+    bool InitiativeTracker::before(Handle a, Handle b) const {
+        return acts_before(entries[a], entries[b]);
+    }
+
+    void InitiativeTracker::place(size_t index, Handle handle) {
+        heap[index] = handle;
+        positions[handle] = (int32)index;
+    }
+
+    void InitiativeTracker::sift_up(size_t index) {
+        const Handle handle = heap[index];
+
+        while(index > 0) {
+            const size_t parent = (index - 1) / 2;
+
+            if(!before(handle, heap[parent])) break;
+
+            place(index, heap[parent]);
+            index = parent;
+        }
+
+        place(index, handle);
+    }
+
+    void InitiativeTracker::sift_down(size_t index) {
+        const Handle handle = heap[index];
+        const size_t count = heap.size();
+
+        while(true) {
+            size_t child = 2 * index + 1;
+            if(child >= count) break;
+
+            if(child + 1 < count && before(heap[child + 1], heap[child])) child++;
+            if(!before(heap[child], handle)) break;
+
+            place(index, heap[child]);
+            index = child;
+        }
+
+        place(index, handle);
+    }
+
+    void InitiativeTracker::push(Handle handle) {
+        heap.push_back(handle);
+        positions[handle] = (int32)(heap.size() - 1);
+
+        sift_up(heap.size() - 1);
+    }
+
+    void InitiativeTracker::erase(size_t index) {
+        const Handle handle = heap[index];
+        const Handle last = heap.back();
+
+        heap.pop_back();
+        positions[handle] = -1;
+
+        if(handle == last) return;
+
+        place(index, last);
+        sift_up(index);
+        sift_down(positions[last]);
+    }
+
+    InitiativeTracker::Handle InitiativeTracker::make_entry(const string& name, int dexMod, int initiative) {
+        Entry entry;
+
+        entry.name = name;
+        entry.initiative = initiative;
+        entry.dexMod = dexMod;
+        entry.round = currentRound;
+        entry.joined = (uint32)entries.size();
+
+        // if their initiative has already passed this round, they wait for the next
+        if(currentTurn != NONE) {
+            Entry now = entries[currentTurn];
+            now.round = currentRound;
+
+            if(acts_before(entry, now)) entry.round++;
+        }
+
+        entries.push_back(entry);
+        positions.push_back(-1);
+
+        return (Handle)(entries.size() - 1);
+    }
+
+    InitiativeTracker::Handle InitiativeTracker::add(const string& name, int dexMod) {
+        uniform_int_distribution<int> d20(1, 20);
+
+        return add(name, dexMod, d20(Utils::thread_engine()) + dexMod);
+    }
+
+    InitiativeTracker::Handle InitiativeTracker::add(const string& name, int dexMod, int initiative) {
+        const Handle handle = make_entry(name, dexMod, initiative);
+
+        push(handle);
+
+        return handle;
+    }
+
+    InitiativeTracker::Handle InitiativeTracker::add(Character& character) {
+        string name = character.get_first_name();
+        if(!character.get_last_name().empty()) name += " " + character.get_last_name();
+
+        return add(name, character.DEX_MOD());
+    }
+
+    vector<InitiativeTracker::Handle> InitiativeTracker::add_all(const vector<string>& names,
+                                                                 const vector<int>& dexMods) {
+        const size_t count = min(names.size(), dexMods.size());
+        vector<Handle> ret(count);
+
+        // roll everyone first, then build the heap once
+        vector<int> rolls(count);
+        uniform_int_distribution<int> d20(1, 20);
+        auto& engine = Utils::thread_engine();
+
+        for(size_t i = 0; i < count; i++) rolls[i] = d20(engine);
+
+        entries.reserve(entries.size() + count);
+        positions.reserve(positions.size() + count);
+        heap.reserve(heap.size() + count);
+
+        for(size_t i = 0; i < count; i++) {
+            ret[i] = make_entry(names[i], dexMods[i], rolls[i] + dexMods[i]);
+
+            positions[ret[i]] = (int32)heap.size();
+            heap.push_back(ret[i]);
+        }
+
+        for(size_t i = heap.size() / 2; i > 0; i--) sift_down(i - 1);
+
+        return ret;
+    }
+
+    bool InitiativeTracker::remove(Handle handle) {
+        if(!contains(handle)) return false;
+
+        erase(positions[handle]);
+
+        return true;
+    }
+
+    bool InitiativeTracker::delay(Handle handle, int initiative) {
+        if(handle != currentTurn || !contains(handle)) return false;
+        if(initiative >= entries[handle].initiative) return false;
+
+        // next() already moved them to the next round, bring them back to this one
+        entries[handle].initiative = initiative;
+        entries[handle].round = currentRound;
+
+        sift_up(positions[handle]);
+
+        return true;
+    }
+
+    bool InitiativeTracker::set_initiative(Handle handle, int initiative) {
+        if(!contains(handle)) return false;
+
+        entries[handle].initiative = initiative;
+
+        sift_up(positions[handle]);
+        sift_down(positions[handle]);
+
+        return true;
+    }
+
+    InitiativeTracker::Handle InitiativeTracker::next() {
+        if(heap.empty()) {
+            currentTurn = NONE;
+            return NONE;
+        }
+
+        const Handle handle = heap[0];
+
+        currentTurn = handle;
+        currentRound = entries[handle].round;
+
+        // their next turn is next round, which sinks them below everyone still to act
+        entries[handle].round++;
+        sift_down(0);
+
+        return handle;
+    }
+
+    InitiativeTracker::Handle InitiativeTracker::find(const string& name) const {
+        for(Handle handle = 0; handle < entries.size(); handle++) {
+            if(contains(handle) && entries[handle].name == name) return handle;
+        }
+
+        return NONE;
+    }
+
+    vector<InitiativeTracker::Handle> InitiativeTracker::order() const {
+        vector<Handle> ret(heap);
+
+        sort(ret.begin(), ret.end(), [this](Handle a, Handle b) { return before(a, b); });
+
+        return ret;
+    }
+
+    void InitiativeTracker::clear() {
+        entries.clear();
+        positions.clear();
+        heap.clear();
+
+        currentTurn = NONE;
+        currentRound = 1;
+    }
+}
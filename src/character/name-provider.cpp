@@ -0,0 +1,71 @@
+/*
+characters - name-provider.cpp
+Created on: Oct 18, 2026
+
+OpenRPG Software License - Version 1.0 - February 10th, 2017 <https://openrpg.io/about/license/>
+This is free software: you are free to change and redistribute it.
+There is NO WARRANTY, to the extent permitted by law.
+*/
+#include <string>
+#include <unordered_map>
+
+#include "names.h"
+#include "character/races.h"
+#include "character/name-provider.h"
+
+using namespace std;
+
+namespace ORPG {
+    void GeneratorNameProvider::make_name(const Race& race, string& first, string& last) {
+        // NOTE(incomingstick): a NameGenerator is not thread safe, so each thread keeps its own
+        thread_local unordered_map<string, unordered_map<uint, NameGenerator>> locations;
+
+        // providers reading from different locations must not share generators
+        auto& generators = locations[location];
+
+        auto it = generators.find(race.id());
+        if(it == generators.end()) {
+            it = generators.emplace(race.id(), NameGenerator(race.to_string(), "", location)).first;
+        }
+
+        NameGenerator& ng = it->second;
+
+        // make_first() keeps the gender it picks, so clear it for a fresh one each time
+        ng.set_gender("");
+
+        first = ng.make_first();
+        last = ng.make_last();
+    }
+
+    ListNameProvider::ListNameProvider(const vector<string>& names): next(0) {
+        firstNames.reserve(names.size());
+        lastNames.reserve(names.size());
+
+        for(auto& name : names) {
+            const size_t space = name.find(' ');
+
+            firstNames.push_back(name.substr(0, space));
+            lastNames.push_back(space == string::npos ? "" : name.substr(space + 1));
+        }
+    }
+
+    void ListNameProvider::make_name(const Race& race, string& first, string& last) {
+        if(firstNames.empty()) {
+            first.clear();
+            last.clear();
+            return;
+        }
+
+        const size_t i = next.fetch_add(1, memory_order_relaxed) % firstNames.size();
+
+        first = firstNames[i];
+        last = lastNames[i];
+    }
+
+    namespace Characters {
+        NameProvider& default_name_provider() {
+            static GeneratorNameProvider provider;
+            return provider;
+        }
+    }
+}
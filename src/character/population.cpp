@@ -0,0 +1,256 @@
+/*
+characters - population.cpp
+Created on: Oct 18, 2026
+
+OpenRPG Software License - Version 1.0 - February 10th, 2017 <https://openrpg.io/about/license/>
+This is free software: you are free to change and redistribute it.
+There is NO WARRANTY, to the extent permitted by law.
+*/
+#include <algorithm>
+#include <random>
+
+#include "core/utils.h"
+#include "character/checks.h"
+#include "character/population.h"
+
+using namespace std;
+
+namespace ORPG {
+    Population::Population() {
+        // NameID 0 is reserved for the empty name
+        intern("");
+    }
+
+    void Population::reserve(size_t count) {
+        for(auto& column : scores) column.reserve(count);
+
+        saveProfs.reserve(count);
+        skillProfs.reserve(count);
+        languages.reserve(count);
+        raceIDs.reserve(count);
+        classIDs.reserve(count);
+        bgIDs.reserve(count);
+        levels.reserve(count);
+        exp.reserve(count);
+        currHP.reserve(count);
+        maxHP.reserve(count);
+        tempHP.reserve(count);
+        firstNames.reserve(count);
+        lastNames.reserve(count);
+    }
+
+    void Population::clear() {
+        for(auto& column : scores) column.clear();
+
+        saveProfs.clear();
+        skillProfs.clear();
+        languages.clear();
+        raceIDs.clear();
+        classIDs.clear();
+        bgIDs.clear();
+        levels.clear();
+        exp.clear();
+        currHP.clear();
+        maxHP.clear();
+        tempHP.clear();
+        firstNames.clear();
+        lastNames.clear();
+
+        names.clear();
+        nameIndex.clear();
+        intern("");
+    }
+
+    Population::NameID Population::intern(const string& name) {
+        auto it = nameIndex.find(name);
+        if(it != nameIndex.end()) return it->second;
+
+        const NameID id = (NameID)names.size();
+
+        names.push_back(name);
+        nameIndex.emplace(name, id);
+
+        return id;
+    }
+
+    Population::Index Population::add(Character& character) {
+        const Index member = (Index)size();
+
+        uint8 profs = 0;
+        for(int ability = 0; ability < ABILITY_SCORE_COUNT; ability++) {
+            scores[ability].push_back(character.ABILITY_SCORE((EnumAbilityScore)ability));
+
+            if(character.is_save_prof((EnumAbilityScore)ability)) profs |= 1 << ability;
+        }
+
+        saveProfs.push_back(profs);
+
+        uint64 skills = 0;
+        for(int skill = 0; skill < SKILL_COUNT; skill++) {
+            const uint64 rank = character.get_skill_prof((EnumSkill)skill) & 3;
+            skills |= rank << (2 * skill);
+        }
+
+        skillProfs.push_back(skills);
+
+        uint32 langs = 0;
+        for(auto lang : character.get_languages()) langs |= 1u << lang;
+
+        languages.push_back(langs);
+
+        // the high bits only say which class space the ID is in
+        raceIDs.push_back((uint16)(character.get_race_id() & 0xFFFF));
+        classIDs.push_back((uint16)(character.get_class_id() & 0xFFFF));
+        bgIDs.push_back((uint16)(character.get_background_id() & 0xFFFF));
+
+        levels.push_back((uint8)character.get_level());
+        exp.push_back(character.get_exp());
+        currHP.push_back(character.get_current_hp());
+        maxHP.push_back(character.get_max_hp());
+        tempHP.push_back(character.get_temp_hp());
+
+        const string first = character.get_first_name();
+        const string last = character.get_last_name();
+
+        firstNames.push_back(intern(first == "NULL" ? "" : first));
+        lastNames.push_back(intern(last == "NULL" ? "" : last));
+
+        return member;
+    }
+
+    Character* Population::to_character(Index member) const {
+        const Race* race = Characters::select_race(race_id(member));
+        const CharacterClass* cClass = Characters::select_character_class(class_id(member));
+
+        if(race == nullptr || cClass == nullptr ||
+           Characters::select_background(background_id(member)) == nullptr) {
+            return nullptr;
+        }
+
+        // the stored names are used as they are, even when empty or with spaces in them
+        FixedNameProvider names(first_name(member), last_name(member));
+
+        Character* ret = new Character(race, new AbilityScores, cClass,
+                                       background_id(member), new Skills, "", &names);
+
+        for(int ability = 0; ability < ABILITY_SCORE_COUNT; ability++) {
+            ret->set_ability_score((EnumAbilityScore)ability, score(member, (EnumAbilityScore)ability));
+            ret->set_save_prof((EnumAbilityScore)ability, is_save_prof(member, (EnumAbilityScore)ability));
+        }
+
+        for(int skill = 0; skill < SKILL_COUNT; skill++) {
+            ret->set_skill_prof((EnumSkill)skill, skill_prof(member, (EnumSkill)skill));
+        }
+
+        vector<Language> langs;
+        for(int lang = 0; lang < 32; lang++) {
+            if(languages[member] & (1u << lang)) langs.push_back((Language)lang);
+        }
+
+        ret->set_languages(langs);
+
+        ret->set_level(level(member));
+        ret->set_exp(experience(member));
+        ret->set_hit_points(current_hp(member), max_hp(member), temp_hp(member));
+
+        return ret;
+    }
+
+    void Population::modifiers(EnumAbilityScore ability, int8* out) const {
+        const uint8* column = scores[ability].data();
+        const size_t count = size();
+
+        for(size_t i = 0; i < count; i++) {
+            out[i] = modifier(column[i]);
+        }
+    }
+
+    void Population::saves(EnumAbilityScore ability, int8* out) const {
+        const uint8* column = scores[ability].data();
+        const uint8* profs = saveProfs.data();
+        const uint8* lvls = levels.data();
+        const size_t count = size();
+
+        for(size_t i = 0; i < count; i++) {
+            const int8 prof = ((profs[i] >> ability) & 1) ? 2 + (lvls[i] - 1) / 4 : 0;
+
+            out[i] = modifier(column[i]) + prof;
+        }
+    }
+
+    size_t Population::roll_saves(EnumAbilityScore ability, int dc, vector<uint8>& passed) const {
+        const size_t count = size();
+
+        // compute every modifier first, so the rolling loop is just d20 + mod
+        vector<int8> mods(count);
+        saves(ability, mods.data());
+
+        passed.resize(count);
+        Characters::roll_d20s(count, passed.data());
+
+        size_t ret = 0;
+        for(size_t i = 0; i < count; i++) {
+            passed[i] = (passed[i] + mods[i] >= dc) ? 1 : 0;
+            ret += passed[i];
+        }
+
+        return ret;
+    }
+
+    size_t Population::level_up(int targetLevel) {
+        targetLevel = max(1, min(20, targetLevel));
+
+        const size_t count = size();
+
+        // look up the hit die of each members class once, rather than once per level
+        vector<uint8> dice(count);
+        vector<int8> conMods(count);
+        uint16 lastClass = 0;
+        uint8 lastDie = 0;
+
+        for(size_t i = 0; i < count; i++) {
+            if(lastDie == 0 || classIDs[i] != lastClass) {
+                const CharacterClass* cClass = Characters::select_character_class(class_id((Index)i));
+
+                lastClass = classIDs[i];
+                lastDie = cClass == nullptr ? 0 : (uint8)cClass->HIT_DIE_MAX();
+            }
+
+            dice[i] = lastDie;
+        }
+
+        modifiers(CON, conMods.data());
+
+        auto& engine = Utils::thread_engine();
+        size_t ret = 0;
+
+        for(int lvl = 2; lvl <= targetLevel; lvl++) {
+            for(size_t i = 0; i < count; i++) {
+                if(levels[i] >= lvl || dice[i] == 0) continue;
+
+                const int roll = uniform_int_distribution<int>(1, dice[i])(engine);
+                const int gain = max(1, roll + conMods[i]);
+
+                currHP[i] += gain;
+                maxHP[i] += gain;
+                levels[i] = (uint8)lvl;
+                ret++;
+            }
+        }
+
+        return ret;
+    }
+
+    void Population::apply_damage(const vector<uint8>& mask, int amount) {
+        const size_t count = min(size(), mask.size());
+
+        for(size_t i = 0; i < count; i++) {
+            if(mask[i] == 0) continue;
+
+            const int absorbed = min(tempHP[i], amount);
+
+            tempHP[i] -= absorbed;
+            currHP[i] -= amount - absorbed;
+        }
+    }
+}
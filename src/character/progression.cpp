@@ -0,0 +1,153 @@
+/*
+characters - progression.cpp
+Created on: Oct 18, 2026
+
+OpenRPG Software License - Version 1.0 - February 10th, 2017 <https://openrpg.io/about/license/>
+This is free software: you are free to change and redistribute it.
+There is NO WARRANTY, to the extent permitted by law.
+*/
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+#include "core/thread-pool.h"
+#include "core/utils.h"
+#include "character/progression.h"
+
+/* the number of characters each block simulates side by side */
+#define SIMULATION_BLOCK_SIZE   4096
+
+using namespace std;
+
+namespace ORPG {
+    int HitPointDistribution::lowest(int level) const {
+        const auto& column = counts[level - 1];
+
+        for(size_t hp = 0; hp < column.size(); hp++) {
+            if(column[hp] != 0) return (int)hp;
+        }
+
+        return 0;
+    }
+
+    int HitPointDistribution::highest(int level) const {
+        const auto& column = counts[level - 1];
+
+        for(size_t hp = column.size(); hp > 0; hp--) {
+            if(column[hp - 1] != 0) return (int)hp - 1;
+        }
+
+        return 0;
+    }
+
+    double HitPointDistribution::mean(int level) const {
+        if(samples == 0) return 0.0;
+
+        const auto& column = counts[level - 1];
+        double sum = 0.0;
+
+        for(size_t hp = 0; hp < column.size(); hp++) {
+            sum += (double)hp * column[hp];
+        }
+
+        return sum / samples;
+    }
+
+    double HitPointDistribution::stddev(int level) const {
+        if(samples == 0) return 0.0;
+
+        const auto& column = counts[level - 1];
+        const double avg = mean(level);
+        double sum = 0.0;
+
+        for(size_t hp = 0; hp < column.size(); hp++) {
+            sum += (hp - avg) * (hp - avg) * column[hp];
+        }
+
+        return sqrt(sum / samples);
+    }
+
+    int HitPointDistribution::percentile(int level, double fraction) const {
+        const auto& column = counts[level - 1];
+        const double target = fraction * samples;
+        uint64 seen = 0;
+
+        for(size_t hp = 0; hp < column.size(); hp++) {
+            seen += column[hp];
+
+            if(seen > 0 && seen >= target) return (int)hp;
+        }
+
+        return highest(level);
+    }
+
+    namespace Characters {
+        HitPointDistribution simulate_hit_points(const CharacterClass& cClass, int conMod,
+                                                 uint64 samples, unsigned int threads) {
+            HitPointDistribution ret;
+
+            ret.classID = cClass.id();
+            ret.hitDie = cClass.HIT_DIE_MAX();
+            ret.conMod = conMod;
+            ret.samples = samples;
+
+            // every level adds at least 1, so this is the most a character can have
+            const int firstLevel = std::max(1, ret.hitDie + conMod);
+            const size_t histogramSize = (size_t)firstLevel * CHARACTER_MAX_LEVEL + 1;
+
+            for(auto& column : ret.counts) column.assign(histogramSize, 0);
+
+            if(samples == 0) return ret;
+
+            Core::ThreadPool pool(threads);
+
+            // a few tasks per thread, so an unlucky thread does not hold up the rest
+            const uint64 taskCount = std::min<uint64>(samples, pool.size() * 4);
+            vector<vector<uint64>> partials(taskCount);
+
+            pool.parallel_for(taskCount, [&](size_t task) {
+                const uint64 begin = samples * task / taskCount;
+                const uint64 end = samples * (task + 1) / taskCount;
+
+                // this tasks counts, every level back to back
+                vector<uint64>& counts = partials[task];
+                counts.assign(histogramSize * CHARACTER_MAX_LEVEL, 0);
+
+                auto& engine = Utils::thread_engine();
+                uniform_int_distribution<int> hitDie(1, ret.hitDie);
+
+                vector<int> hp(SIMULATION_BLOCK_SIZE);
+                vector<int> rolls(SIMULATION_BLOCK_SIZE);
+
+                for(uint64 done = begin; done < end; done += SIMULATION_BLOCK_SIZE) {
+                    const size_t block = (size_t)std::min<uint64>(SIMULATION_BLOCK_SIZE, end - done);
+
+                    // level 1 is always the maximum of the hit die
+                    fill(hp.begin(), hp.begin() + block, firstLevel);
+                    counts[firstLevel] += block;
+
+                    for(int level = 2; level <= CHARACTER_MAX_LEVEL; level++) {
+                        for(size_t i = 0; i < block; i++) rolls[i] = hitDie(engine);
+
+                        uint64* column = counts.data() + histogramSize * (level - 1);
+
+                        for(size_t i = 0; i < block; i++) {
+                            hp[i] += std::max(1, rolls[i] + conMod);
+                            column[hp[i]]++;
+                        }
+                    }
+                }
+            });
+
+            for(auto& counts : partials) {
+                for(int level = 0; level < CHARACTER_MAX_LEVEL; level++) {
+                    for(size_t hp = 0; hp < histogramSize; hp++) {
+                        ret.counts[level][hp] += counts[histogramSize * level + hp];
+                    }
+                }
+            }
+
+            return ret;
+        }
+    }
+}
@@ -57,37 +57,47 @@ namespace ORPG {
         }
 
         /**
-         * @desc This function takes in an integer, ideally a Race::ID,
-         * creates a new Race of that ID type and returns a pointer to it. If an ID
+         * @desc This function takes in an integer, ideally a Race::ID, and
+         * returns a pointer to the shared Race registered under that ID. If an ID
          * less than 0 is passed we instead will randomly select a Race type to return.
+         *
+         * NOTE(incomingstick): function statics are initialized exactly once, even
+         * across threads, so each Race is built the first time it is asked for
+         * and lives until the program exits.
          * 
-         * @param const int identifier - the RaceID of the race to be generated
+         * @param const int identifier - the Race::ID of the race to look up
          * 
-         * @return Race* - a pointer to the newly created Race
+         * @return const Race* - a pointer to the shared Race, or nullptr if the
+         * ID is unknown
          **/
-        Race* select_race(const int identifier) {
+        const Race* select_race(const int identifier) {
             const auto id = (identifier < 0) ?
                 random_race_id() : identifier;
 
             switch(id) {
             case Human::ID : {
-                return new Human();
+                static const Human human;
+                return &human;
             }
 
             case Dwarf::ID : {
-                return new Dwarf();
+                static const Dwarf dwarf;
+                return &dwarf;
             }
 
             case HillDwarf::ID : {
-                return new HillDwarf();
+                static const HillDwarf hillDwarf;
+                return &hillDwarf;
             }
 
             case Elf::ID : {
-                return new Elf();
+                static const Elf elf;
+                return &elf;
             }
 
             case HighElf::ID : {
-                return new HighElf();
+                static const HighElf highElf;
+                return &highElf;
             }
 
             default: {
@@ -125,7 +135,7 @@ namespace ORPG {
      * @param AbilityScores* - a pointer the base AbilityScores to
      * add to
      **/
-    void Human::applyRacialBonus(AbilityScores* base) {
+    void Human::applyRacialBonus(AbilityScores* base) const {
         *base = *base + abilBonus;
     }
 
@@ -157,7 +167,7 @@ namespace ORPG {
      * @param AbilityScores* - a pointer the base AbilityScores to
      * add to
      **/
-    void Dwarf::applyRacialBonus(AbilityScores* base) {
+    void Dwarf::applyRacialBonus(AbilityScores* base) const {
         *base = *base + abilBonus;
     }
 
@@ -180,7 +190,7 @@ namespace ORPG {
      * @param AbilityScores* - a pointer the base AbilityScores to
      * add to
      **/
-    void HillDwarf::applyRacialBonus(AbilityScores* base) {
+    void HillDwarf::applyRacialBonus(AbilityScores* base) const {
         *base = *base + abilBonus;
     }
 
@@ -212,7 +222,7 @@ namespace ORPG {
      * @param AbilityScores* - a pointer the base AbilityScores to
      * add to
      **/
-    void Elf::applyRacialBonus(AbilityScores* base) {
+    void Elf::applyRacialBonus(AbilityScores* base) const {
         *base = *base + abilBonus;
     }
 
@@ -235,7 +245,7 @@ namespace ORPG {
      * @param AbilityScores* - a pointer the base AbilityScores to
      * add to
      **/
-    void HighElf::applyRacialBonus(AbilityScores* base) {
+    void HighElf::applyRacialBonus(AbilityScores* base) const {
         *base = *base + abilBonus;
     }
 }
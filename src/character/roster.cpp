@@ -0,0 +1,298 @@
+/*
+characters - roster.cpp
+Created on: Oct 18, 2026
+
+OpenRPG Software License - Version 1.0 - February 10th, 2017 <https://openrpg.io/about/license/>
+This is free software: you are free to change and redistribute it.
+There is NO WARRANTY, to the extent permitted by law.
+*/
+#include <cstdio>
+#include <cstring>
+#include <type_traits>
+
+#include "core/platform.h"
+#include "character/roster.h"
+
+using namespace std;
+
+namespace ORPG {
+    static_assert(sizeof(RosterHeader) == 32, "RosterHeader must not contain padding");
+    static_assert(sizeof(RosterRecord) == 56, "RosterRecord must not contain padding");
+    static_assert(std::is_trivially_copyable<RosterRecord>::value,
+                  "RosterRecord must be trivially copyable");
+
+    /* returns true if this machine stores integers little-endian */
+    static bool little_endian_host() {
+        const uint16 probe = 1;
+        uint8 first;
+
+        memcpy(&first, &probe, 1);
+
+        return first == 1;
+    }
+
+    RosterWriter::RosterWriter() {
+        // offset 0 is always the empty string
+        intern("");
+    }
+
+    uint32 RosterWriter::intern(const string& str) {
+        auto it = stringOffsets.find(str);
+        if(it != stringOffsets.end()) return it->second;
+
+        const uint32 offset = (uint32)strings.size();
+
+        strings.append(str);
+        strings.push_back('\0');
+        stringOffsets.emplace(str, offset);
+
+        return offset;
+    }
+
+    void RosterWriter::add(Character& character) {
+        RosterRecord record;
+        memset(&record, 0, sizeof(record));
+
+        for(int skill = 0; skill < SKILL_COUNT; skill++) {
+            const uint64 rank = character.get_skill_prof((EnumSkill)skill) & 3;
+            record.skillProfs |= rank << (2 * skill);
+        }
+
+        record.raceID = character.get_race_id();
+        record.classID = character.get_class_id();
+        record.backgroundID = character.get_background_id();
+
+        const string first = character.get_first_name();
+        const string last = character.get_last_name();
+
+        record.firstName = intern(first == "NULL" ? "" : first);
+        record.lastName = intern(last == "NULL" ? "" : last);
+
+        record.currHP = character.get_current_hp();
+        record.maxHP = character.get_max_hp();
+        record.tempHP = character.get_temp_hp();
+        record.exp = character.get_exp();
+
+        for(auto lang : character.get_languages()) {
+            record.languages |= 1u << lang;
+        }
+
+        for(int ability = 0; ability < ABILITY_SCORE_COUNT; ability++) {
+            record.scores[ability] = character.ABILITY_SCORE((EnumAbilityScore)ability);
+
+            if(character.is_save_prof((EnumAbilityScore)ability)) {
+                record.saveProfs |= 1 << ability;
+            }
+        }
+
+        record.level = (uint8)character.get_level();
+
+        records.push_back(record);
+    }
+
+    void RosterWriter::add(const Population& population, Population::Index member) {
+        RosterRecord record;
+        memset(&record, 0, sizeof(record));
+
+        record.raceID = population.race_id(member);
+        record.classID = population.class_id(member);
+        record.backgroundID = population.background_id(member);
+        record.firstName = intern(population.first_name(member));
+        record.lastName = intern(population.last_name(member));
+        record.currHP = population.current_hp(member);
+        record.maxHP = population.max_hp(member);
+        record.tempHP = population.temp_hp(member);
+        record.exp = population.experience(member);
+
+        for(int skill = 0; skill < SKILL_COUNT; skill++) {
+            const uint64 rank = population.skill_prof(member, (EnumSkill)skill);
+            record.skillProfs |= rank << (2 * skill);
+        }
+
+        for(int lang = 0; lang < 32; lang++) {
+            if(population.knows_language(member, (Language)lang)) record.languages |= 1u << lang;
+        }
+
+        for(int ability = 0; ability < ABILITY_SCORE_COUNT; ability++) {
+            record.scores[ability] = population.score(member, (EnumAbilityScore)ability);
+
+            if(population.is_save_prof(member, (EnumAbilityScore)ability)) {
+                record.saveProfs |= 1 << ability;
+            }
+        }
+
+        record.level = (uint8)population.level(member);
+
+        records.push_back(record);
+    }
+
+    bool RosterWriter::save(const string& path, string* error) const {
+        // TODO(incomingstick): byte swap on big-endian hosts
+        if(!little_endian_host()) {
+            if(error != nullptr) *error = "roster files can only be written on little-endian hosts";
+            return false;
+        }
+
+        RosterHeader header;
+        memset(&header, 0, sizeof(header));
+
+        memcpy(header.magic, ROSTER_MAGIC, sizeof(header.magic));
+        header.version = ROSTER_VERSION;
+        header.headerSize = sizeof(RosterHeader);
+        header.recordCount = (uint32)records.size();
+        header.recordSize = sizeof(RosterRecord);
+        header.recordsOffset = sizeof(RosterHeader);
+        header.stringsOffset = header.recordsOffset + (uint32)(records.size() * sizeof(RosterRecord));
+        header.stringsSize = (uint32)strings.size();
+
+        FILE* file = fopen(path.c_str(), "wb");
+        if(file == nullptr) {
+            if(error != nullptr) *error = "unable to open " + path + " for writing";
+            return false;
+        }
+
+        bool ok = fwrite(&header, sizeof(header), 1, file) == 1;
+
+        if(ok && !records.empty()) {
+            ok = fwrite(records.data(), sizeof(RosterRecord), records.size(), file) == records.size();
+        }
+
+        if(ok) {
+            ok = fwrite(strings.data(), 1, strings.size(), file) == strings.size();
+        }
+
+        if(fclose(file) != 0) ok = false;
+
+        if(!ok && error != nullptr) *error = "unable to write " + path;
+
+        return ok;
+    }
+
+    RosterReader::RosterReader():
+        mapping(nullptr), mappingSize(0),
+        header(nullptr), records(nullptr), strings(nullptr) {
+        /* Does nothing else currently */
+    }
+
+    RosterReader::~RosterReader() {
+        close();
+    }
+
+    bool RosterReader::fail(const string& msg) {
+        close();
+        errorStr = msg;
+        return false;
+    }
+
+    bool RosterReader::open(const string& path) {
+        close();
+        errorStr.clear();
+
+        if(!little_endian_host()) {
+            return fail("roster files can only be read on little-endian hosts");
+        }
+
+        mapping = MEMORY_MAP_FILE(path, mappingSize);
+        if(mapping == nullptr) return fail("unable to map " + path);
+
+        const char* base = (const char*)mapping;
+
+        if(mappingSize < sizeof(RosterHeader)) {
+            return fail(path + " is too small to be a roster file");
+        }
+
+        const RosterHeader* head = (const RosterHeader*)base;
+
+        if(memcmp(head->magic, ROSTER_MAGIC, sizeof(head->magic)) != 0) {
+            return fail(path + " is not a roster file");
+        }
+
+        if(head->version != ROSTER_VERSION) {
+            return fail(path + " is roster version " + std::to_string(head->version) +
+                        ", expected version " + std::to_string(ROSTER_VERSION));
+        }
+
+        if(head->headerSize != sizeof(RosterHeader) || head->recordSize != sizeof(RosterRecord)) {
+            return fail(path + " has an unexpected header or record size");
+        }
+
+        // everything is checked in 64 bits, so a corrupt count cannot overflow
+        const uint64 recordsEnd = (uint64)head->recordsOffset +
+                                  (uint64)head->recordCount * sizeof(RosterRecord);
+        const uint64 stringsEnd = (uint64)head->stringsOffset + head->stringsSize;
+
+        if(head->recordsOffset < sizeof(RosterHeader) ||
+           head->recordsOffset % alignof(RosterRecord) != 0 ||
+           recordsEnd > mappingSize || stringsEnd > mappingSize ||
+           head->stringsOffset < recordsEnd) {
+            return fail(path + " is truncated or corrupt");
+        }
+
+        // an empty first string, and a terminated last one, keeps string_at() in bounds
+        if(head->stringsSize == 0 || base[head->stringsOffset] != '\0' ||
+           base[stringsEnd - 1] != '\0') {
+            return fail(path + " has a corrupt string table");
+        }
+
+        header = head;
+        records = (const RosterRecord*)(base + head->recordsOffset);
+        strings = base + head->stringsOffset;
+
+        return true;
+    }
+
+    void RosterReader::close() {
+        MEMORY_UNMAP_FILE(mapping, mappingSize);
+
+        mapping = nullptr;
+        mappingSize = 0;
+        header = nullptr;
+        records = nullptr;
+        strings = nullptr;
+    }
+
+    const char* RosterReader::string_at(uint32 offset) const {
+        if(header == nullptr || offset >= header->stringsSize) return "";
+
+        return strings + offset;
+    }
+
+    Character* RosterReader::to_character(size_t i) const {
+        const RosterRecord& record = records[i];
+
+        const Race* race = Characters::select_race(record.raceID);
+        const CharacterClass* cClass = Characters::select_character_class(record.classID);
+
+        if(race == nullptr || cClass == nullptr ||
+           Characters::select_background(record.backgroundID) == nullptr) {
+            return nullptr;
+        }
+
+        // the stored names are used as they are, even when empty or with spaces in them
+        FixedNameProvider names(first_name(i), last_name(i));
+
+        Character* ret = new Character(race, new AbilityScores, cClass,
+                                       record.backgroundID, new Skills, "", &names);
+
+        for(int ability = 0; ability < ABILITY_SCORE_COUNT; ability++) {
+            ret->set_ability_score((EnumAbilityScore)ability, record.scores[ability]);
+            ret->set_save_prof((EnumAbilityScore)ability, (record.saveProfs >> ability) & 1);
+        }
+
+        for(int skill = 0; skill < SKILL_COUNT; skill++) {
+            ret->set_skill_prof((EnumSkill)skill, record.skill_prof((EnumSkill)skill));
+        }
+
+        vector<Language> langs;
+        for(int lang = 0; lang < 32; lang++) {
+            if(record.languages & (1u << lang)) langs.push_back((Language)lang);
+        }
+        ret->set_languages(langs);
+
+        ret->set_level(record.level);
+        ret->set_exp(record.exp);
+        ret->set_hit_points(record.currHP, record.maxHP, record.tempHP);
+
+        return ret;
+    }
+}
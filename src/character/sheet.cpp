@@ -0,0 +1,177 @@
+/*
+characters - sheet.cpp
+Created on: Oct 18, 2026
+
+OpenRPG Software License - Version 1.0 - February 10th, 2017 <https://openrpg.io/about/license/>
+This is free software: you are free to change and redistribute it.
+There is NO WARRANTY, to the extent permitted by law.
+*/
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#include "core/utils.h"
+#include "character/sheet.h"
+
+using namespace std;
+
+namespace ORPG {
+    /* the name of each SheetField as it is written in a template */
+    static const char* FIELD_NAMES[SHEET_FIELD_COUNT] = {
+        "first_name", "last_name", "race", "background", "class", "level",
+        "exp", "hp", "prof",
+        "str", "str_mod", "dex", "dex_mod", "con", "con_mod",
+        "int", "int_mod", "wis", "wis_mod", "cha", "cha_mod",
+        "acr", "anm", "arc", "ath", "dec", "his", "ins", "itm", "inv",
+        "med", "nat", "prc", "prf", "prs", "rel", "sle", "stl", "sur",
+        "passive_perception"
+    };
+
+    /* returns the number of characters (not bytes) in a UTF-8 string */
+    static size_t utf8_length(const char* str, size_t len) {
+        size_t ret = 0;
+
+        for(size_t i = 0; i < len; i++) {
+            if(((unsigned char)str[i] & 0xC0) != 0x80) ret++;
+        }
+
+        return ret;
+    }
+
+    SheetTemplate::SheetTemplate(): sizeHint(0) {
+        /* Does nothing else currently */
+    }
+
+    bool SheetTemplate::compile(const string& source) {
+        literals.clear();
+        spans.clear();
+        sizeHint = 0;
+        errorStr.clear();
+
+        size_t pos = 0;
+        int line = 1;
+
+        while(true) {
+            const size_t open = source.find("{{", pos);
+            const size_t textEnd = open == string::npos ? source.size() : open;
+
+            Span span;
+            span.offset = (uint32)literals.size();
+            span.length = (uint32)(textEnd - pos);
+            span.field = -1;
+            span.width = 0;
+            span.alignRight = false;
+
+            literals.append(source, pos, textEnd - pos);
+            for(size_t i = pos; i < textEnd; i++) if(source[i] == '\n') line++;
+
+            if(open == string::npos) {
+                spans.push_back(span);
+                break;
+            }
+
+            const size_t close = source.find("}}", open + 2);
+            if(close == string::npos || source.find('\n', open) < close) {
+                errorStr = "line " + std::to_string(line) + ": unterminated placeholder";
+                return false;
+            }
+
+            // {{name}} or {{name:width}} or {{name:>width}}
+            const string placeholder = source.substr(open + 2, close - open - 2);
+            const size_t colon = placeholder.find(':');
+            const string name = placeholder.substr(0, colon);
+
+            for(int field = 0; field < SHEET_FIELD_COUNT; field++) {
+                if(name == FIELD_NAMES[field]) span.field = (int16)field;
+            }
+
+            if(span.field < 0) {
+                errorStr = "line " + std::to_string(line) + ": unknown placeholder '" + name + "'";
+                return false;
+            }
+
+            if(colon != string::npos) {
+                string width = placeholder.substr(colon + 1);
+
+                if(!width.empty() && width[0] == '>') {
+                    span.alignRight = true;
+                    width.erase(0, 1);
+                }
+
+                char* end = nullptr;
+                const long value = strtol(width.c_str(), &end, 10);
+
+                if(width.empty() || *end != '\0' || value < 0 || value > 0xFFFF) {
+                    errorStr = "line " + std::to_string(line) + ": invalid width for '" + name + "'";
+                    return false;
+                }
+
+                span.width = (uint16)value;
+            }
+
+            spans.push_back(span);
+            pos = close + 2;
+        }
+
+        sizeHint = literals.size();
+        for(auto& span : spans) sizeHint += span.width;
+
+        return true;
+    }
+
+    bool SheetTemplate::load_file(const string& path) {
+        ifstream file(path.c_str(), ios::in | ios::binary);
+
+        if(!file.is_open()) {
+            errorStr = "unable to open " + path;
+            return false;
+        }
+
+        stringstream buffer;
+        buffer << file.rdbuf();
+
+        if(!compile(buffer.str())) {
+            errorStr = path + ": " + errorStr;
+            return false;
+        }
+
+        return true;
+    }
+
+    void SheetTemplate::render(const SheetValue* values, string& out) const {
+        out.reserve(out.size() + sizeHint);
+
+        const char* text = literals.data();
+
+        for(auto& span : spans) {
+            out.append(text + span.offset, span.length);
+
+            if(span.field < 0) continue;
+
+            const SheetValue& value = values[span.field];
+            const size_t length = utf8_length(value.data, value.length);
+            const size_t padding = length < span.width ? span.width - length : 0;
+
+            if(span.alignRight) out.append(padding, ' ');
+            out.append(value.data, value.length);
+            if(!span.alignRight) out.append(padding, ' ');
+        }
+    }
+
+    const SheetTemplate& ascii_sheet_template() {
+        // NOTE(incomingstick): function statics are initialized exactly once, even across threads
+        static const SheetTemplate sheet = [] {
+            SheetTemplate ret;
+
+            if(!ret.load_file(Core::DATA_LOCATION() + "/" + ASCII_SHEET_TEMPLATE)) {
+                cerr << "Unable to load character sheet: " << ret.get_error() << endl;
+            }
+
+            return ret;
+        }();
+
+        return sheet;
+    }
+}
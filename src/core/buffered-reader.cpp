@@ -0,0 +1,72 @@
+/*
+core - buffered-reader.cpp
+Created on: Oct 18, 2026
+
+OpenRPG Software License - Version 1.0 - February 10th, 2017 <https://openrpg.io/about/license/>
+This is free software: you are free to change and redistribute it.
+There is NO WARRANTY, to the extent permitted by law.
+*/
+#include <cstring>
+
+#include "core/buffered-reader.h"
+
+using namespace std;
+
+namespace ORPG {
+    namespace Core {
+        BufferedReader::BufferedReader(FILE* file, size_t capacity):
+            in(file), buffer(capacity == 0 ? 1 : capacity), begin(0), end(0), done(false) {
+            /* Does nothing else currently */
+        }
+
+        bool BufferedReader::next_line(const char*& line, size_t& len) {
+            size_t searched = begin;    // bytes before this are known not to be '\n'
+
+            while(true) {
+                const char* start = buffer.data() + begin;
+                const char* newline = (const char*)memchr(buffer.data() + searched, '\n', end - searched);
+
+                if(newline != nullptr || (done && end > begin)) {
+                    const char* stop = newline != nullptr ? newline : buffer.data() + end;
+
+                    line = start;
+                    len = stop - start;
+                    begin = newline != nullptr ? (stop - buffer.data()) + 1 : end;
+
+                    if(len > 0 && line[len - 1] == '\r') len--;
+
+                    return true;
+                }
+
+                if(done) return false;
+
+                // move what is left of the current line to the front, and make room if it is the whole buffer
+                const size_t pending = end - begin;
+
+                memmove(buffer.data(), start, pending);
+                searched = pending;
+                begin = 0;
+                end = pending;
+
+                if(end == buffer.size()) buffer.resize(buffer.size() * 2);
+
+                const size_t got = fread(buffer.data() + end, 1, buffer.size() - end, in);
+
+                end += got;
+
+                if(got == 0) done = true;
+            }
+        }
+
+        bool BufferedReader::read_line(string& line) {
+            const char* data;
+            size_t len;
+
+            if(!next_line(data, len)) return false;
+
+            line.assign(data, len);
+
+            return true;
+        }
+    }
+}
@@ -0,0 +1,50 @@
+/*
+core - buffered-writer.cpp
+Created on: Oct 18, 2026
+
+OpenRPG Software License - Version 1.0 - February 10th, 2017 <https://openrpg.io/about/license/>
+This is free software: you are free to change and redistribute it.
+There is NO WARRANTY, to the extent permitted by law.
+*/
+#include <cstring>
+
+#include "core/buffered-writer.h"
+
+using namespace std;
+
+namespace ORPG {
+    namespace Core {
+        BufferedWriter::BufferedWriter(FILE* file, size_t capacity):
+            out(file), buffer(capacity == 0 ? 1 : capacity), used(0), written(0) {
+            /* Does nothing else currently */
+        }
+
+        BufferedWriter::~BufferedWriter() {
+            flush();
+        }
+
+        void BufferedWriter::write(const char* data, size_t len) {
+            if(used + len > buffer.size()) {
+                flush();
+
+                // too big to be worth copying, send it straight through
+                if(len >= buffer.size()) {
+                    written += fwrite(data, 1, len, out);
+                    return;
+                }
+            }
+
+            memcpy(buffer.data() + used, data, len);
+            used += len;
+        }
+
+        bool BufferedWriter::flush() {
+            if(used != 0) {
+                written += fwrite(buffer.data(), 1, used, out);
+                used = 0;
+            }
+
+            return fflush(out) == 0 && !ferror(out);
+        }
+    }
+}
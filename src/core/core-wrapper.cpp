@@ -9,6 +9,7 @@ There is NO WARRANTY, to the extent permitted by law.
 #include "core/core-wrapper.h"
 
 namespace ORPGJS {
+    using v8::External;
     using v8::FunctionCallbackInfo;
     using v8::Isolate;
     using v8::NewStringType;
@@ -22,4 +23,16 @@ namespace ORPGJS {
         Isolate* isolate = args.GetIsolate();
         args.GetReturnValue().Set(String::NewFromUtf8(isolate, VERSION, NewStringType::kNormal).ToLocalChecked());
     }
-}
\ No newline at end of file
+
+    AddonData::AddonData(Isolate* isolate) {
+        node::AddEnvironmentCleanupHook(isolate, DeleteInstance, this);
+    }
+
+    void AddonData::DeleteInstance(void* data) {
+        delete static_cast<AddonData*>(data);
+    }
+
+    AddonData* AddonData::From(const FunctionCallbackInfo<Value>& args) {
+        return static_cast<AddonData*>(args.Data().As<External>()->Value());
+    }
+}
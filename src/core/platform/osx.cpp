@@ -12,6 +12,10 @@ There is NO WARRANTY, to the extent permitted by law.
 
 // POSIX Headers
 #include <limits.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 // Standard Library Headers
 #include <string>
@@ -35,3 +39,30 @@ string CALL_PATH(void* func_ptr) {
     dladdr(func_ptr, &dl_info);
     return string(dl_info.dli_fname);
 }
+
+const void* MEMORY_MAP_FILE(const string& path, size_t& size) {
+    size = 0;
+
+    int fd = open(path.c_str(), O_RDONLY);
+    if(fd < 0) return nullptr;
+
+    struct stat info;
+    if(fstat(fd, &info) != 0 || info.st_size <= 0) {
+        close(fd);
+        return nullptr;
+    }
+
+    void* data = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+    // the mapping holds its own reference to the file
+    close(fd);
+
+    if(data == MAP_FAILED) return nullptr;
+
+    size = (size_t)info.st_size;
+    return data;
+}
+
+void MEMORY_UNMAP_FILE(const void* data, size_t size) {
+    if(data != nullptr) munmap(const_cast<void*>(data), size);
+}
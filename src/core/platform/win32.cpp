@@ -75,3 +75,36 @@ string CALL_PATH(void* func_path) {
 
     return retval;
 }
+
+const void* MEMORY_MAP_FILE(const string& path, size_t& size) {
+    size = 0;
+
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if(file == INVALID_HANDLE_VALUE) return nullptr;
+
+    LARGE_INTEGER length;
+    if(!GetFileSizeEx(file, &length) || length.QuadPart <= 0) {
+        CloseHandle(file);
+        return nullptr;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    CloseHandle(file);
+
+    if(mapping == NULL) return nullptr;
+
+    const void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+
+    // the view holds its own reference to the mapping
+    CloseHandle(mapping);
+
+    if(data == NULL) return nullptr;
+
+    size = (size_t)length.QuadPart;
+    return data;
+}
+
+void MEMORY_UNMAP_FILE(const void* data, size_t size) {
+    if(data != nullptr) UnmapViewOfFile(data);
+}
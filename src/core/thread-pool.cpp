@@ -0,0 +1,110 @@
+/*
+core - thread-pool.cpp
+Created on: Oct 18, 2026
+
+OpenRPG Software License - Version 1.0 - February 10th, 2017 <https://openrpg.io/about/license/>
+This is free software: you are free to change and redistribute it.
+There is NO WARRANTY, to the extent permitted by law.
+*/
+#include "core/thread-pool.h"
+
+using namespace std;
+
+namespace ORPG {
+    namespace Core {
+        unsigned int default_thread_count() {
+            unsigned int hw = thread::hardware_concurrency();
+            return hw == 0 ? 1 : hw;
+        }
+
+        ThreadPool::ThreadPool(unsigned int threads):
+            job(nullptr), jobCount(0), nextIndex(0),
+            generation(0), active(0), stopping(false) {
+
+            if(threads == 0) threads = default_thread_count();
+
+            workers.reserve(threads - 1);
+            for(unsigned int i = 1; i < threads; i++) {
+                workers.emplace_back(&ThreadPool::worker_loop, this);
+            }
+        }
+
+        ThreadPool::~ThreadPool() {
+            {
+                lock_guard<mutex> guard(lock);
+                stopping = true;
+            }
+
+            wake.notify_all();
+
+            for(auto& worker : workers) {
+                worker.join();
+            }
+        }
+
+        /**
+         * @desc pulls indices off of the shared counter until the current batch
+         * is exhausted. This is run by the workers and the calling thread alike.
+         **/
+        void ThreadPool::run_batch() {
+            size_t i;
+            while((i = nextIndex.fetch_add(1, memory_order_relaxed)) < jobCount) {
+                (*job)(i);
+            }
+        }
+
+        void ThreadPool::worker_loop() {
+            size_t seen = 0;
+
+            while(true) {
+                {
+                    unique_lock<mutex> guard(lock);
+                    wake.wait(guard, [&] { return stopping || generation != seen; });
+
+                    if(stopping) return;
+
+                    seen = generation;
+                }
+
+                run_batch();
+
+                {
+                    lock_guard<mutex> guard(lock);
+                    active--;
+                }
+
+                done.notify_one();
+            }
+        }
+
+        void ThreadPool::parallel_for(size_t count, const function<void(size_t)>& work) {
+            if(count == 0) return;
+
+            // no point waking the pool for a single item
+            if(workers.empty() || count == 1) {
+                for(size_t i = 0; i < count; i++) work(i);
+                return;
+            }
+
+            {
+                lock_guard<mutex> guard(lock);
+                job = &work;
+                jobCount = count;
+                nextIndex.store(0, memory_order_relaxed);
+                active = workers.size();
+                generation++;
+            }
+
+            wake.notify_all();
+
+            run_batch();
+
+            // every worker must leave the batch before job goes out of scope
+            unique_lock<mutex> guard(lock);
+            done.wait(guard, [&] { return active == 0; });
+
+            job = nullptr;
+            jobCount = 0;
+        }
+    }
+}
@@ -9,6 +9,7 @@ There is NO WARRANTY, to the extent permitted by law.
 #include <filesystem>
 #include <fstream>
 #include <functional>
+#include <mutex>
 #include <random>
 #include <vector>
 
@@ -93,6 +94,7 @@ namespace ORPG {
                 "\n"
                 "Available modules:\n"
                         "\tgenerate (gen, ng) [RACE | GENDER]   Generate a random name of the given RACE and GENDER.\n"
+                        "\tinitiative (init, i) [COMMAND]       Track the turn order of a battle, see 'help init'.\n"
                         "\troll (r) [XdY]                       Simulates rolling dice with Y sides X number of times.\n"
                 "\n"
                 "Long options may not be passed with a single dash.\n"
@@ -196,6 +198,10 @@ namespace ORPG {
          * @return string - the location of our data
          **/
         string DATA_LOCATION() {
+            // guard the first lookup, as threads may ask for the location at once
+            static mutex lock;
+            lock_guard<mutex> guard(lock);
+
             if(LOCATION.empty() && !LOCATE_DATA()) cerr << "Unable to locate the OpenRPG data directory!" << endl;
 
             return LOCATION.string();
@@ -352,12 +358,30 @@ namespace ORPG {
             return str;
         }
 
+        /**
+         * @desc returns a reference to the calling threads RandomEngine. Each
+         * thread gets its own engine, seeded once from a std::random_device the
+         * first time it is used, so threads never share state or need a lock.
+         *
+         * NOTE(incomingstick): we used to construct a random_device and a new
+         * engine on every call, which is far more expensive than the roll itself.
+         *
+         * @return RandomEngine& - the calling threads random engine
+         **/
+        RandomEngine& thread_engine() {
+            thread_local RandomEngine engine([] {
+                random_device rd;
+                seed_seq seed{ rd(), rd(), rd(), rd() };
+                return RandomEngine(seed);
+            }());
+
+            return engine;
+        }
+
         int randomInt(int min, int max) {
-            random_device rd;
-            mt19937 mt(rd());
             uniform_int_distribution<int> dist(min, max);
 
-            return dist(mt);
+            return dist(thread_engine());
         }
 
         /**
@@ -366,7 +390,7 @@ namespace ORPG {
          * @return bool - a randomly chosen true of false state
          **/
         bool randomBool() {
-            return randomInt(INT32_MIN, INT32_MAX) % 2 ? true : false;
+            return (thread_engine()() & 1) ? true : false;
         }
 
         /* Compute the greatest common divisor of a and b. */
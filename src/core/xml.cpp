@@ -6,7 +6,10 @@ OpenRPG Software License - Version 1.0 - February 10th, 2017 <https://openrpg.io
 This is free software: you are free to change and redistribute it.
 There is NO WARRANTY, to the extent permitted by law.
 */
+#include <cctype>
+#include <cstring>
 #include <fstream>
+#include <vector>
 
 #include "core/xml.h"
 #include "core/utils.h"
@@ -34,10 +37,10 @@ XMLNode::XMLNode(XMLDocument* doc):document(doc) {
 }
 
 /**
- * TODO doc comments
+ * @desc deletes this XMLNode along with all of its children
  **/
 XMLNode::~XMLNode() {
-    //TODO destruction
+    delete_children();
 };
 
 /**
@@ -179,7 +182,16 @@ XMLNode* XMLNode::insert_before_node(XMLNode* before, XMLNode* insert) {
  * @desc deletes all child nodes of this XMLNode
  **/
 void XMLNode::delete_children() {
-    //TODO implementation
+    XMLNode* child = firstChild;
+
+    while(child != nullptr) {
+        XMLNode* next = child->nextSib;
+        delete child;
+        child = next;
+    }
+
+    firstChild = nullptr;
+    lastChild = nullptr;
 }
 
 /**
@@ -188,7 +200,15 @@ void XMLNode::delete_children() {
  * @param XMLNode* node - the node to be deleted
  **/
 void XMLNode::delete_child(XMLNode* node) {
-    //TODO implementation
+    if(node == nullptr || node->parent != this) return;
+
+    if(node->prevSib != nullptr) node->prevSib->nextSib = node->nextSib;
+    if(node->nextSib != nullptr) node->nextSib->prevSib = node->prevSib;
+
+    if(firstChild == node) firstChild = node->nextSib;
+    if(lastChild == node) lastChild = node->prevSib;
+
+    delete node;
 }
 
 /**
@@ -213,13 +233,20 @@ XMLAttribute::~XMLAttribute() {
 XMLElement::XMLElement(XMLDocument* doc):XMLNode(doc) {
     //TODO construciton
     root = nullptr;
+    closingType = XMLElementClosingType::DEFAULT;
 }
 
 /**
  * TODO doc comments
  **/
 XMLElement::~XMLElement() {
-    //TODO destruciton
+    XMLAttribute* curr = root;
+
+    while(curr != nullptr) {
+        XMLAttribute* next = curr->next;
+        delete curr;
+        curr = next;
+    }
 }
 
 /**
@@ -255,6 +282,68 @@ void XMLElement::add_attribute(std::string name, std::string value, int line) {
     }
 }
 
+/**
+ * @desc searches this elements attribute list for the given name
+ *
+ * @param std::string name - the name of the attribute to find
+ *
+ * @return XMLAttribute* - the matching attribute, nullptr if not found
+ **/
+XMLAttribute* XMLElement::find_attribute(const string& name) {
+    for(XMLAttribute* curr = root; curr != nullptr; curr = curr->next) {
+        if(curr->name == name) return curr;
+    }
+
+    return nullptr;
+}
+
+/**
+ * @desc returns the value of the named attribute, or def if this
+ * element does not have an attribute by that name.
+ *
+ * @param std::string name - the name of the attribute to read
+ * @param std::string def - the value to return if it is missing
+ *
+ * @return std::string - the attribute value, or def
+ **/
+string XMLElement::attribute(const string& name, const string& def) {
+    XMLAttribute* attr = find_attribute(name);
+    return attr == nullptr ? def : attr->value;
+}
+
+/**
+ * @desc returns the first child element of this element. If a name
+ * is given, the first child element with that name is returned instead.
+ *
+ * @param std::string name - the element name to match, or empty for any
+ *
+ * @return XMLElement* - the matching child, nullptr if there is none
+ **/
+XMLElement* XMLElement::first_child_element(const string& name) {
+    for(XMLNode* node = firstChild; node != nullptr; node = node->next_sibling()) {
+        // NOTE(incomingstick): every node the parser creates is an XMLElement
+        if(name.empty() || node->get_value() == name) return (XMLElement*)node;
+    }
+
+    return nullptr;
+}
+
+/**
+ * @desc returns the next sibling element of this element. If a name
+ * is given, the next sibling element with that name is returned instead.
+ *
+ * @param std::string name - the element name to match, or empty for any
+ *
+ * @return XMLElement* - the matching sibling, nullptr if there is none
+ **/
+XMLElement* XMLElement::next_sibling_element(const string& name) {
+    for(XMLNode* node = nextSib; node != nullptr; node = node->next_sibling()) {
+        if(name.empty() || node->get_value() == name) return (XMLElement*)node;
+    }
+
+    return nullptr;
+}
+
 /**
  * TODO doc comments
  **/
@@ -264,201 +353,407 @@ XMLDocument::XMLDocument() {
 }
 
 /**
- * TODO doc comments
+ * @desc deletes every XMLNode owned by this document
  **/
 XMLDocument::~XMLDocument() {
-    //TODO destruciton
+    clear();
 }
 
 /**
- * TODO doc comments
- * FIXME this crashes with the following error
- *  Expression: cannot dereference string iterator because it is out of range (e.g. an end iterator)
- * This error is occuring when it reaches the "<noteList>" tag, as the notes span multiple lines. We
- * need to handle XMLAttribute data spanning multiple lines, as this is a very common things.
+ * @desc deletes the loaded tree and resets any error state
+ **/
+void XMLDocument::clear() {
+    delete root;
+    root = nullptr;
+
+    currLine = 0;
+    errorStr = "";
+    errorLine = 0;
+}
+
+/**
+ * @desc records a load error. This always returns false so the parser
+ * can bail out with "return set_error(...)".
+ *
+ * @param std::string message - a description of the error
+ * @param int line - the line the error was found on
+ *
+ * @return bool - always false
+ **/
+bool XMLDocument::set_error(string message, int line) {
+    errorStr = message;
+    errorLine = line;
+    return false;
+}
+
+/**
+ * @desc reads the given file and parses it into this document. Any
+ * previously loaded content is discarded. On failure get_error() and
+ * get_error_line() describe what went wrong.
+ *
+ * NOTE(incomingstick): The file is read in a single call rather than line by
+ * line, as the parser needs to handle tags and attribute data that span
+ * multiple lines anyway (i.e a <noteList> on a Fifth Edition Character Sheet).
+ *
+ * @param std::string filename - the path of the file to load
+ *
+ * @return bool - true if the file was loaded and parsed, false otherwise
  **/
 bool XMLDocument::load_file(string filename) {
-    //TODO load file
-    ifstream xml(filename);
+    clear();
 
-    if(xml.is_open()) {
-        string buffer;
+    ifstream xml(filename, ios::in | ios::binary);
 
-        XMLElementClosingType closeType = XMLElementClosingType::DEFAULT;
-        XMLElement* currElement = root;
+    if(!xml.is_open()) {
+        return set_error("unable to open " + filename, 0);
+    }
 
-        // Do we want to zero index this and add 1 back after the fact, or just start at 1?
-        currLine = 0;
+    string buffer;
 
-        // begin parsing the XML document one line at a time
-        while(Utils::safeGetline(xml, buffer)) {
-            string tag = "";
+    xml.seekg(0, ios::end);
+    const streamoff size = xml.tellg();
+    xml.seekg(0, ios::beg);
 
-            currLine++;
+    if(size > 0) {
+        buffer.resize((size_t)size);
+        xml.read(&buffer[0], size);
+        buffer.resize((size_t)xml.gcount());
+    }
 
-            // parse each individual character to catch special characters
-            for(string::iterator ch = buffer.begin();
-                ch != buffer.end();) {
+    return parse(buffer);
+}
 
-                switch(*ch) {
-                    // ignore whitespace
-                    case ' ': {
-                        ch++;
-                    } break;
+/**
+ * @desc returns true if ch may be part of a tag or attribute name
+ **/
+static bool is_name_char(char ch) {
+    return !(ch == ' ' || ch == '\t' || ch == '\r' || ch == '\n' ||
+             ch == '>' || ch == '/' || ch == '=' || ch == '?' ||
+             ch == '<' || ch == '"' || ch == APOSTROPHE);
+}
 
-                    // tag and tagline opened
-                    case '<': {
-                        ch++;
+/**
+ * @desc returns true if ch is XML whitespace
+ **/
+static bool is_space(char ch) {
+    return ch == ' ' || ch == '\t' || ch == '\r' || ch == '\n';
+}
 
-                        if(currElement == nullptr) currElement = new XMLElement(this);
+/**
+ * @desc appends the UTF-8 encoding of the given code point to out
+ **/
+static void append_utf8(string& out, unsigned long cp) {
+    if(cp < 0x80) {
+        out += (char)cp;
+    } else if(cp < 0x800) {
+        out += (char)(0xC0 | (cp >> 6));
+        out += (char)(0x80 | (cp & 0x3F));
+    } else if(cp < 0x10000) {
+        out += (char)(0xE0 | (cp >> 12));
+        out += (char)(0x80 | ((cp >> 6) & 0x3F));
+        out += (char)(0x80 | (cp & 0x3F));
+    } else {
+        out += (char)(0xF0 | (cp >> 18));
+        out += (char)(0x80 | ((cp >> 12) & 0x3F));
+        out += (char)(0x80 | ((cp >> 6) & 0x3F));
+        out += (char)(0x80 | (cp & 0x3F));
+    }
+}
 
-                        closeType = XMLElementClosingType::OPEN;
+/**
+ * @desc replaces the predefined XML entities and numeric character
+ * references in the range [begin, end) and appends the result to out.
+ * Unknown entities are copied through untouched.
+ **/
+static void append_decoded(string& out, const char* begin, const char* end) {
+    static const struct { const char* name; char ch; } entities[] = {
+        { "lt;", '<' }, { "gt;", '>' }, { "amp;", '&' },
+        { "quot;", '"' }, { "apos;", APOSTROPHE }
+    };
+
+    for(const char* ch = begin; ch < end; ch++) {
+        if(*ch != '&') {
+            out += *ch;
+            continue;
+        }
 
-                        // getting the tag name here
-                        while(ch != buffer.end() &&
-                                *ch != ' ' &&
-                                *ch != '>' &&
-                                *ch != '/' &&
-                                *ch != '=' &&
-                                *ch != '?') {
+        bool decoded = false;
 
-                            tag += *ch++;
-                        }
+        if(ch + 1 < end && ch[1] == '#') {
+            const bool hex = ch + 2 < end && (ch[2] == 'x' || ch[2] == 'X');
+            const char* digits = ch + (hex ? 3 : 2);
+            const char* semi = digits;
+            unsigned long cp = 0;
 
-                        //FIXME if we are a "parent" here, we overwrite our name...
-                        if(!tag.empty()) currElement->set_name(tag);
-                    } break;
+            while(semi < end && isxdigit((unsigned char)*semi) && (hex || isdigit((unsigned char)*semi))) {
+                cp = cp * (hex ? 16 : 10) + (isdigit((unsigned char)*semi) ? *semi - '0' : (tolower(*semi) - 'a' + 10));
+                semi++;
+            }
 
-                    // tag closing
-                    case '/': {
-                        ch++;
+            if(semi < end && *semi == ';' && semi != digits && cp <= 0x10FFFF) {
+                append_utf8(out, cp);
+                ch = semi;
+                decoded = true;
+            }
+        } else {
+            for(const auto& entity : entities) {
+                const size_t len = strlen(entity.name);
+
+                if((size_t)(end - ch - 1) >= len && strncmp(ch + 1, entity.name, len) == 0) {
+                    out += entity.ch;
+                    ch += len;
+                    decoded = true;
+                    break;
+                }
+            }
+        }
 
-                        // getting the tag name here
-                        while(ch != buffer.end() &&
-                                *ch != ' ' &&
-                                *ch != '>' &&
-                                *ch != '/' &&
-                                *ch != '=' &&
-                                *ch != '?') {
+        if(!decoded) out += *ch;
+    }
+}
 
-                            tag += *ch++;
-                        }
+/**
+ * @desc parses the given XML string into this document. Any
+ * previously loaded content is discarded. On failure get_error() and
+ * get_error_line() describe what went wrong.
+ *
+ * NOTE(incomingstick): this is a non-validating parser. It understands
+ * elements, attributes, text, comments, CDATA sections, the XML declaration
+ * and DOCTYPEs (the latter two are skipped). Every error carries the line it
+ * was found on so a bad file can be reported and skipped rather than aborting.
+ *
+ * @param const std::string& xml - the XML text to parse
+ *
+ * @return bool - true if the text was parsed, false otherwise
+ **/
+bool XMLDocument::parse(const string& xml) {
+    clear();
 
-                        //FIXME(incomingstick): this is a very rudimentary way of doing this
-                        if(tag == ((XMLElement*)currElement->get_parent())->get_name()) {
-                            closeType = XMLElementClosingType::CLOSING;
-                        } else {
-                            closeType = XMLElementClosingType::CLOSED;
-                        }
-                    } break;
+    const char* ch = xml.data();
+    const char* const end = ch + xml.size();
 
-                    // tagline closed
-                    case '>': {
-                        ch++;
+    // the chain of currently open elements, innermost last
+    vector<XMLElement*> open;
 
-                        /* ignore data between tags such as <tag stuff="foo bar">DATA</tag>
-                          in that case DATA is added to the currElements data pointer */
-                        /* TODO store this data */
-                        string data = "";
+    currLine = 1;
 
-                        // TODO This only allows data to be a single line, what if it spans multiple lines?
-                        while(ch != buffer.end() && *ch != '<') {
-                            data += *ch++;
-                        }
+    // advances ch by one character, keeping track of the line we are on
+    auto advance = [&]() {
+        if(*ch == '\n') currLine++;
+        ch++;
+    };
 
-                        currElement->set_data((void*)data.c_str());
+    auto skip_space = [&]() {
+        while(ch < end && is_space(*ch)) advance();
+    };
 
-                        if(currElement != nullptr && closeType == XMLElementClosingType::OPEN) {
-                            currElement->add_child(new XMLElement(this));
+    // skips past the given terminator, returning false if it is never found
+    auto skip_past = [&](const char* terminator) {
+        const size_t len = strlen(terminator);
 
-                            if(root == nullptr) root = currElement;
+        while(ch < end) {
+            if((size_t)(end - ch) >= len && strncmp(ch, terminator, len) == 0) {
+                ch += len;
+                return true;
+            }
 
-                            currElement = (XMLElement*)currElement->first_child();
-                        } else if(closeType == XMLElementClosingType::CLOSING) {
-                            currElement = (XMLElement*)currElement->get_parent();
-                        } else if(closeType == XMLElementClosingType::CLOSED) {
-                            currElement = (XMLElement*)currElement->get_parent();
-                        }
+            advance();
+        }
+
+        return false;
+    };
+
+    auto read_name = [&]() {
+        const char* start = ch;
+        while(ch < end && is_name_char(*ch)) ch++;
+        return string(start, ch);
+    };
+
+    // skip a UTF-8 byte order mark if one is present
+    if(end - ch >= 3 && (unsigned char)ch[0] == 0xEF &&
+       (unsigned char)ch[1] == 0xBB && (unsigned char)ch[2] == 0xBF) {
+        ch += 3;
+    }
+
+    while(ch < end) {
+        if(*ch != '<') {
+            // text data between tags such as <tag stuff="foo bar">DATA</tag>
+            const char* start = ch;
+            const int startLine = currLine;
+            bool blank = true;
+
+            while(ch < end && *ch != '<') {
+                if(!is_space(*ch)) blank = false;
+                advance();
+            }
+
+            if(blank) continue;
+
+            if(open.empty()) {
+                return set_error("text found outside of the root element", startLine);
+            }
+
+            append_decoded(open.back()->text, start, ch);
+            continue;
+        }
+
+        const int tagLine = currLine;
+        ch++;
+
+        if(ch >= end) return set_error("unexpected end of file after '<'", tagLine);
+
+        switch(*ch) {
+            // XML definition tag found, i.e <?xml version="1.0"?>
+            case '?': {
+                if(!skip_past("?>")) {
+                    return set_error("unterminated processing instruction", tagLine);
+                }
+            } break;
+
+            // comments, CDATA, and DOCTYPE
+            case '!': {
+                if(end - ch >= 3 && strncmp(ch, "!--", 3) == 0) {
+                    if(!skip_past("-->")) {
+                        return set_error("unterminated comment", tagLine);
+                    }
+                } else if(end - ch >= 8 && strncmp(ch, "![CDATA[", 8) == 0) {
+                    ch += 8;
+                    const char* start = ch;
+
+                    if(!skip_past("]]>")) {
+                        return set_error("unterminated CDATA section", tagLine);
+                    }
+
+                    if(open.empty()) {
+                        return set_error("CDATA found outside of the root element", tagLine);
+                    }
+
+                    open.back()->text.append(start, ch - 3);
+                } else if(!skip_past(">")) {
+                    return set_error("unterminated declaration", tagLine);
+                }
+            } break;
+
+            // tag closing, i.e </foo>
+            case '/': {
+                ch++;
+                string tag = read_name();
+                skip_space();
+
+                if(ch >= end || *ch != '>') {
+                    return set_error("malformed closing tag </" + tag + ">", tagLine);
+                }
+
+                ch++;
+
+                if(open.empty()) {
+                    return set_error("unexpected closing tag </" + tag + ">", tagLine);
+                }
+
+                if(open.back()->get_name() != tag) {
+                    return set_error("closing tag </" + tag + "> does not match <" +
+                                     open.back()->get_name() + "> opened on line " +
+                                     std::to_string(open.back()->get_line_number()), tagLine);
+                }
 
-                        tag = "";
-                    } break;
+                open.pop_back();
+            } break;
+
+            // tag and tagline opened, i.e <foo bar="baz"> or <foo/>
+            default: {
+                string tag = read_name();
+
+                if(tag.empty()) return set_error("missing tag name after '<'", tagLine);
+
+                XMLElement* element = new XMLElement(this);
+                element->lineNum = tagLine;
+                element->set_name(tag);
+
+                // attach the element right away so it is cleaned up on error
+                if(!open.empty()) {
+                    open.back()->add_child(element);
+                } else if(root == nullptr) {
+                    root = element;
+                } else {
+                    delete element;
+                    return set_error("found a second root element <" + tag + ">", tagLine);
+                }
 
-                    // XML definition tag found
-                    case '?': {
+                // we can assume that until the tag closes, we are working with attributes
+                while(true) {
+                    skip_space();
+
+                    if(ch >= end) {
+                        return set_error("unterminated tag <" + tag + ">", tagLine);
+                    }
+
+                    if(*ch == '>') {
                         ch++;
+                        element->closingType = XMLElementClosingType::OPEN;
+                        open.push_back(element);
+                        break;
+                    }
 
-                        // getting the tag name here
-                        while(ch != buffer.end() &&
-                                *ch != ' ' &&
-                                *ch != '>' &&
-                                *ch != '/' &&
-                                *ch != '=' &&
-                                *ch != '?') {
+                    if(*ch == '/') {
+                        ch++;
 
-                            tag += *ch++;
+                        if(ch >= end || *ch != '>') {
+                            return set_error("expected '>' after '/' in <" + tag + ">", currLine);
                         }
 
-                        /* NOTE(incomingstick): tag == "xml" should be true here,
-                            is this something we should enforce? Will it ever matter? */
-
-                        if(!tag.empty()) currElement->set_name(tag);
-                    } break;
-
-                    // we can assume that if we reached  default, we are working with attributes
-                    default: {
-                        //first we get the attribute name
-                        string attr = "";
-                        
-                        // getting the attribute name here
-                        while(ch != buffer.end() &&
-                                *ch != ' ' &&
-                                *ch != '>' &&
-                                *ch != '/' &&
-                                *ch != '=' &&
-                                *ch != '?') {
-                        
-                            attr += *ch++;
-                        }
+                        ch++;
+                        element->closingType = XMLElementClosingType::CLOSED;
+                        break;
+                    }
 
-                        // this clears any whitespace until we find our first '"' 
-                        while(*ch == ' ' ||
-                              *ch == '=') {
-                            ch++;
-                        }
+                    const int attrLine = currLine;
+                    string attr = read_name();
 
-                        // this is a sanity check to ensure proper formatting
-                        // if an incorrect format is found, we abort immediately.
-                        // TODO handle this error reporting better
-                        if(*ch == '/' || *ch == '>' || *ch == '<') {
-                            cout << "found an unexpected " << *ch << " ";
-                            cout << "aborting parse of " << attr << endl;
-                            break;
-                        } else if(*ch == '"' || *ch == APOSTROPHE) {
-                            ch++;
-                        }
+                    if(attr.empty()) {
+                        return set_error(string("found an unexpected '") + *ch + "' in <" + tag + ">", currLine);
+                    }
 
-                        // we are now parsing attribute data
-                        string dat = "";
+                    skip_space();
 
-                        while(*ch != '"' && *ch != APOSTROPHE) {
-                            dat += *ch++;
-                        }
+                    if(ch >= end || *ch != '=') {
+                        return set_error("expected '=' after attribute " + attr, currLine);
+                    }
 
-                        // check and make sure we pop off the final " or '
-                        if(*ch == '"' || *ch == APOSTROPHE) {
-                            ch++;
-                        }
+                    ch++;
+                    skip_space();
 
-                        currElement->add_attribute(attr, dat, currLine);
+                    if(ch >= end || (*ch != '"' && *ch != APOSTROPHE)) {
+                        return set_error("expected a quoted value for attribute " + attr, currLine);
+                    }
 
-                        break;
+                    // attribute data may span multiple lines
+                    const char quote = *ch++;
+                    const char* start = ch;
+
+                    while(ch < end && *ch != quote) advance();
+
+                    if(ch >= end) {
+                        return set_error("unterminated value for attribute " + attr, attrLine);
                     }
+
+                    string dat;
+                    append_decoded(dat, start, ch);
+                    ch++;
+
+                    element->add_attribute(attr, dat, attrLine);
                 }
-            }
+            } break;
         }
-    } else {
-        return false;
+    }
+
+    if(!open.empty()) {
+        return set_error("<" + open.back()->get_name() + "> is never closed",
+                         open.back()->get_line_number());
+    }
+
+    if(root == nullptr) {
+        return set_error("no root element found", currLine);
     }
 
     return true;
-}
\ No newline at end of file
+}
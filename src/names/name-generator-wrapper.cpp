@@ -9,8 +9,14 @@ There is NO WARRANTY, to the extent permitted by law.
 #include <vector>
 #include "names/names-wrapper.h"
 
+/* the most names a single makeNames() call may ask for */
+#define MAX_BATCH_NAMES         (1 << 24)
+
 namespace ORPGJS {
+    using v8::Array;
     using v8::Context;
+    using v8::Exception;
+    using v8::External;
     using v8::Function;
     using v8::FunctionCallbackInfo;
     using v8::FunctionTemplate;
@@ -46,9 +52,6 @@ namespace ORPGJS {
         args.GetReturnValue().Set(Boolean::New(isolate, ORPG::race_is_gendered(str)));
     }
 
-    Persistent<Function> NameGeneratorWrapper::constructor;
-    NameGenerator NameGeneratorWrapper::wrappedGenerator;
-
     NameGeneratorWrapper::NameGeneratorWrapper(std::string _race, std::string _gender) : NameGenerator(_race, _gender) {
         // does nothing
     }
@@ -61,11 +64,11 @@ namespace ORPGJS {
         // does nothing
     }
 
-    void NameGeneratorWrapper::Init(Local<Object> exports) {
+    void NameGeneratorWrapper::Init(Local<Object> exports, AddonData* data) {
         Isolate* isolate = exports->GetIsolate();
 
         // Prepare constructor template
-        Local<FunctionTemplate> tpl = FunctionTemplate::New(isolate, New);
+        Local<FunctionTemplate> tpl = FunctionTemplate::New(isolate, New, External::New(isolate, data));
         tpl->SetClassName(String::NewFromUtf8(isolate, "NameGenerator", NewStringType::kNormal).ToLocalChecked());
         tpl->InstanceTemplate()->SetInternalFieldCount(1);
 
@@ -77,9 +80,10 @@ namespace ORPGJS {
         NODE_SET_PROTOTYPE_METHOD(tpl, "make_name", make_name);
         NODE_SET_PROTOTYPE_METHOD(tpl, "make_first", make_first);
         NODE_SET_PROTOTYPE_METHOD(tpl, "make_last", make_last);
+        NODE_SET_PROTOTYPE_METHOD(tpl, "makeNames", make_names);
 
         Local<Context> context = isolate->GetCurrentContext();
-        constructor.Reset(isolate, tpl->GetFunction(context).ToLocalChecked());
+        data->nameGeneratorConstructor.Reset(isolate, tpl->GetFunction(context).ToLocalChecked());
         exports->Set(context, String::NewFromUtf8(isolate, "NameGenerator", NewStringType::kNormal).ToLocalChecked(),
                      tpl->GetFunction(context).ToLocalChecked()).Check();
     }
@@ -104,19 +108,16 @@ namespace ORPGJS {
             switch (argv.size()) {
             case 2: {
                 obj = new NameGeneratorWrapper(argv[0], argv[1]);
-                wrappedGenerator = NameGenerator(argv[0], argv[1]);
                 break;
             }
 
             case 3: {
                 obj = new NameGeneratorWrapper(argv[0], argv[1], argv[2]);
-                wrappedGenerator = NameGenerator(argv[0], argv[1], argv[2]);
                 break;
             }
 
             default: {
                 obj = new NameGeneratorWrapper();
-                wrappedGenerator = NameGenerator();
             }
             }
 
@@ -126,7 +127,7 @@ namespace ORPGJS {
             // Invoked as plain function `NameGenerator(...)`, turn into construct call.
             const int argc = 1;
             Local<Value> argv[argc] = { args[0] };
-            Local<Function> cons = Local<Function>::New(isolate, constructor);
+            Local<Function> cons = Local<Function>::New(isolate, AddonData::From(args)->nameGeneratorConstructor);
             Local<Object> result =
                 cons->NewInstance(context, argc, argv).ToLocalChecked();
             args.GetReturnValue().Set(result);
@@ -136,7 +137,9 @@ namespace ORPGJS {
     void NameGeneratorWrapper::get_race(const v8::FunctionCallbackInfo<v8::Value>& args) {
         Isolate* isolate = args.GetIsolate();
 
-        auto raceString = wrappedGenerator.get_race();
+        NameGeneratorWrapper* obj = ObjectWrap::Unwrap<NameGeneratorWrapper>(args.Holder());
+
+        auto raceString = obj->NameGenerator::get_race();
         const char*  str = raceString.c_str();
 
         args.GetReturnValue().Set(String::NewFromUtf8(isolate, str, NewStringType::kNormal).ToLocalChecked());
@@ -145,7 +148,9 @@ namespace ORPGJS {
     void NameGeneratorWrapper::get_gender(const v8::FunctionCallbackInfo<v8::Value>& args) {
         Isolate* isolate = args.GetIsolate();
 
-        auto genderString = wrappedGenerator.get_gender();
+        NameGeneratorWrapper* obj = ObjectWrap::Unwrap<NameGeneratorWrapper>(args.Holder());
+
+        auto genderString = obj->NameGenerator::get_gender();
         const char*  str = genderString.c_str();
 
         args.GetReturnValue().Set(String::NewFromUtf8(isolate, str, NewStringType::kNormal).ToLocalChecked());
@@ -158,7 +163,8 @@ namespace ORPGJS {
 
         std::string str = *v8Str ? *v8Str : "dwarf";
 
-        wrappedGenerator.set_race(str);
+        NameGeneratorWrapper* obj = ObjectWrap::Unwrap<NameGeneratorWrapper>(args.Holder());
+        obj->NameGenerator::set_race(str);
 
         args.GetReturnValue().Set(String::NewFromUtf8(isolate, str.c_str(), NewStringType::kNormal).ToLocalChecked());
     }
@@ -170,7 +176,8 @@ namespace ORPGJS {
 
         std::string str = *v8Str ? *v8Str : "";
 
-        wrappedGenerator.set_gender(str);
+        NameGeneratorWrapper* obj = ObjectWrap::Unwrap<NameGeneratorWrapper>(args.Holder());
+        obj->NameGenerator::set_gender(str);
 
         args.GetReturnValue().Set(String::NewFromUtf8(isolate, str.c_str(), NewStringType::kNormal).ToLocalChecked());
     }
@@ -178,7 +185,9 @@ namespace ORPGJS {
     void NameGeneratorWrapper::make_name(const v8::FunctionCallbackInfo<v8::Value>& args) {
         Isolate* isolate = args.GetIsolate();
 
-        auto nameString = wrappedGenerator.make_name();
+        NameGeneratorWrapper* obj = ObjectWrap::Unwrap<NameGeneratorWrapper>(args.Holder());
+
+        auto nameString = obj->NameGenerator::make_name();
         const char*  str = nameString.c_str();
 
         args.GetReturnValue().Set(String::NewFromUtf8(isolate, str, NewStringType::kNormal).ToLocalChecked());
@@ -187,7 +196,9 @@ namespace ORPGJS {
     void NameGeneratorWrapper::make_first(const v8::FunctionCallbackInfo<v8::Value>& args) {
         Isolate* isolate = args.GetIsolate();
 
-        auto nameString = wrappedGenerator.make_first();
+        NameGeneratorWrapper* obj = ObjectWrap::Unwrap<NameGeneratorWrapper>(args.Holder());
+
+        auto nameString = obj->NameGenerator::make_first();
         const char*  str = nameString.c_str();
 
         args.GetReturnValue().Set(String::NewFromUtf8(isolate, str, NewStringType::kNormal).ToLocalChecked());
@@ -196,9 +207,61 @@ namespace ORPGJS {
     void NameGeneratorWrapper::make_last(const v8::FunctionCallbackInfo<v8::Value>& args) {
         Isolate* isolate = args.GetIsolate();
 
-        auto nameString = wrappedGenerator.make_last();
+        NameGeneratorWrapper* obj = ObjectWrap::Unwrap<NameGeneratorWrapper>(args.Holder());
+
+        auto nameString = obj->NameGenerator::make_last();
         const char*  str = nameString.c_str();
 
         args.GetReturnValue().Set(String::NewFromUtf8(isolate, str, NewStringType::kNormal).ToLocalChecked());
     }
-}
\ No newline at end of file
+
+    /* returns line of list as an internalized V8 string, making it only the first time it is asked for */
+    static Local<String> intern_line(Isolate* isolate, std::vector<Local<String>>& made,
+                                     const std::vector<std::string>& list, uint32 line,
+                                     const std::string& prefix) {
+        if(made[line].IsEmpty()) {
+            const std::string str = prefix + list[line];
+
+            made[line] = String::NewFromUtf8(isolate, str.c_str(), NewStringType::kInternalized,
+                                             (int)str.size()).ToLocalChecked();
+        }
+
+        return made[line];
+    }
+
+    void NameGeneratorWrapper::make_names(const v8::FunctionCallbackInfo<v8::Value>& args) {
+        Isolate* isolate = args.GetIsolate();
+        Local<Context> context = isolate->GetCurrentContext();
+
+        const double count = args[0]->NumberValue(context).FromMaybe(-1);
+
+        if(!(count >= 0 && count <= MAX_BATCH_NAMES) || count != (double)(size_t)count) {
+            isolate->ThrowException(Exception::RangeError(String::NewFromUtf8(isolate,
+                "the number of names must be a whole number from 0 to 16777216",
+                NewStringType::kNormal).ToLocalChecked()));
+            return;
+        }
+
+        NameGeneratorWrapper* obj = ObjectWrap::Unwrap<NameGeneratorWrapper>(args.Holder());
+        NameBatch batch = obj->NameGenerator::make_names((size_t)count);
+
+        // last names are made with the space in front, so each name is a single concat
+        std::vector<Local<String>> firsts(batch.firsts->size());
+        std::vector<Local<String>> lasts(batch.lasts->size());
+        std::vector<Local<Value>> names(batch.size());
+
+        for(size_t n = 0; n < batch.size(); n++) {
+            Local<String> name = batch.first.empty() ? String::Empty(isolate) :
+                intern_line(isolate, firsts, *batch.firsts, batch.first[n], "");
+
+            if(!batch.last.empty()) {
+                name = String::Concat(isolate, name,
+                                      intern_line(isolate, lasts, *batch.lasts, batch.last[n], " "));
+            }
+
+            names[n] = name;
+        }
+
+        args.GetReturnValue().Set(Array::New(isolate, names.data(), names.size()));
+    }
+}
@@ -8,15 +8,22 @@ There is NO WARRANTY, to the extent permitted by law.
 */
 #include <iostream>
 #include <algorithm>
+#include <cctype>
 #include <cstdlib>
+#include <vector>
 
 #include "openrpg.h"
+#include "core/buffered-reader.h"
+#include "core/buffered-writer.h"
 #include "names.h"
 
 using namespace std;
 using namespace ORPG;
 using namespace ORPG::Names;
 
+/* set by -b --batch --stdin */
+static bool BATCH_FLAG = false;
+
 /**
   * @desc This function parses all cla's passed to argv from the command line.
   * This function may terminate the program.
@@ -36,18 +43,25 @@ int parse_args(int argc, char* argv[], string* race, string* gender) {
 
     /* these are the long cla's and their corresponding chars */
     static struct Core::option long_opts[] = {
+        {"batch",   no_argument,        0,  'b'},
         {"help",    no_argument,        0,  'h'},
+        {"stdin",   no_argument,        0,  'b'},
         {"verbose", no_argument,        0,  'v'},
         {"version", no_argument,        0,  'V'},
         /* NULL row to terminate struct */
         {0,         0,                  0,   0}
     };
 
-    while ((opt = getopt_long(argc, argv, "hvV",
+    while ((opt = getopt_long(argc, argv, "bhvV",
                                long_opts, &opt_ind)) != EOF) {
         string cmd("");
 
         switch (opt) {
+        /* -b --batch --stdin */
+        case 'b': {
+            BATCH_FLAG = true;
+        } break;
+
         /* -h --help */
         case 'h': {
             Names::PRINT_HELP_FLAG();
@@ -78,6 +92,9 @@ int parse_args(int argc, char* argv[], string* race, string* gender) {
         }
     }
 
+    /* each line of stdin names its own race in batch mode */
+    if(BATCH_FLAG) return status;
+
     /* check to make sure there are at least 
         two "unknown" args to parse throug*/
     switch(argc - Core::optind) {
@@ -111,6 +128,62 @@ int parse_args(int argc, char* argv[], string* race, string* gender) {
     return status;
 }
 
+/**
+  * @desc generates a name for every line of stdin, writing one name per line
+  * to stdout. Each line is a race and an optional gender, in either order,
+  * the same as the arguments. Blank lines are skipped. Every line reuses one
+  * NameGenerator, and the name lists it reads are loaded once and shared by
+  * the names module, so only the first line of each race touches the disk.
+  *
+  * @return int - an integer code following the C/C++ standard for program success
+  */
+int name_batch() {
+    Core::BufferedReader in(stdin);
+    Core::BufferedWriter out(stdout);
+
+    NameGenerator gen;
+    vector<string> words;
+    const char* line;
+    size_t len;
+
+    while(in.next_line(line, len)) {
+        words.clear();
+
+        for(size_t pos = 0; pos < len; ) {
+            while(pos < len && isspace((unsigned char)line[pos])) pos++;
+
+            const size_t start = pos;
+            while(pos < len && !isspace((unsigned char)line[pos])) pos++;
+
+            if(pos > start) words.emplace_back(line + start, pos - start);
+        }
+
+        if(words.empty()) continue;
+
+        string gender;
+
+        if(words.size() > 1 && (words.front() == "male" || words.front() == "female")) {
+            gender = words.front();
+            words.erase(words.begin());
+        } else if(words.size() > 1 && (words.back() == "male" || words.back() == "female")) {
+            gender = words.back();
+            words.pop_back();
+        }
+
+        string race = words[0];
+        for(size_t i = 1; i < words.size(); i++) race += " " + words[i];
+
+        // set both every line, so a random gender or half-elf parent is picked fresh for each name
+        gen.set_race(race);
+        gen.set_gender(gender);
+
+        out.write(gen.make_name());
+        out.write("\n", 1);
+    }
+
+    return out.flush() ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
 /**
   * @desc entry point for the name-generator program. All command line
   * arguments are parsed before entering the name-generator program, and
@@ -123,6 +196,8 @@ int main(int argc, char* argv[]) {
     string race, gender;
     int status = parse_args(argc, argv, &race, &gender); // may exit
 
+    if(status == EXIT_SUCCESS && BATCH_FLAG) return name_batch();
+
     if(race.empty()) {
         printf("Error: race cannot be empty\n");
         status = EXIT_FAILURE;
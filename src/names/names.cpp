@@ -13,6 +13,9 @@ There is NO WARRANTY, to the extent permitted by law.
 #include <random>
 #include <functional>
 #include <algorithm>
+#include <map>
+#include <memory>
+#include <mutex>
 
 #include "core/config.h"
 #include "core/utils.h"
@@ -41,41 +44,80 @@ string make_valid_location(const string baseLoc, string nameList, string raceFol
 }
 
 /**
- * @desc this function takes in a file path as a string, opens an input file
- * stream, and reads a random line from it. If it cannot open the filePath it
- * returns an empty string.
+ * @desc this function takes in a file path as a string and returns the non-empty
+ * lines of that file. Every list is read from disk only once per process; the
+ * lines are kept in a cache shared by every thread and every NameGenerator, so
+ * generating many names does not re-read the same list over and over. If the
+ * file cannot be opened an empty list is returned, and not cached, so asking
+ * for lists that do not exist can not grow the cache.
  *
- * NOTE(incomingstick): Is is worth putting this in a header and making it a
- * part of the public lib?
+ * NOTE(incomingstick): the lists are never modified once loaded, so handing
+ * out a shared_ptr to the const list is safe without holding the lock. Each
+ * thread also remembers the lists it has already been handed, so threads
+ * making names side by side (i.e Node worker_threads) only take the lock the
+ * first time they ask for each list.
  *
- * @param string filePath - the file path to read a random line from
- * @return string - a string containing the random line read from. If the file
- * could not be opened, it returns an empty string
+ * @param const string& filePath - the file path to load
+ * @return shared_ptr<const vector<string>> - the lines of the file
  **/
-string rand_line_from_file(string filePath) {
+shared_ptr<const vector<string>> cached_name_list(const string& filePath) {
+    static mutex lock;
+    static map<string, shared_ptr<const vector<string>>> cache;
+    static thread_local map<string, shared_ptr<const vector<string>>> local;
+
+    auto found = local.find(filePath);
+    if(found != local.end()) return found->second;
+
+    {
+        lock_guard<mutex> guard(lock);
+
+        auto it = cache.find(filePath);
+        if(it != cache.end()) return local[filePath] = it->second;
+    }
+
+    // read outside of the lock so one slow list does not stall the others
+    auto list = make_shared<vector<string>>();
     ifstream file(filePath.c_str());
 
     if(file.is_open()) {
         string read;
-        vector<string> buff;
 
         while(Utils::safeGetline(file, read)) {
             if(!read.empty())
-                buff.push_back(read);
+                list->push_back(read);
         }
-
-        file.close();
-
-        return buff[Utils::randomInt(0, buff.size() - 1)];
     } else {
         // TODO: Raise an exception here, if an asset file
         // cannot be opened then something serious has gone wrong.
         cerr << "unable to open file " << filePath << endl;
+
+        static const shared_ptr<const vector<string>> missing = make_shared<const vector<string>>();
+        return missing;
     }
 
-    file.close();
+    lock_guard<mutex> guard(lock);
 
-    return "";
+    // if another thread beat us to it, use theirs so everyone shares one copy
+    return local[filePath] = cache.emplace(filePath, list).first->second;
+}
+
+/**
+ * @desc this function takes in a file path as a string and returns a random
+ * line from it. If it cannot open the filePath it returns an empty string.
+ *
+ * NOTE(incomingstick): Is is worth putting this in a header and making it a
+ * part of the public lib?
+ *
+ * @param string filePath - the file path to read a random line from
+ * @return string - a string containing the random line read from. If the file
+ * could not be opened, it returns an empty string
+ **/
+string rand_line_from_file(string filePath) {
+    auto list = cached_name_list(filePath);
+
+    if(list->empty()) return "";
+
+    return (*list)[Utils::randomInt(0, (int)list->size() - 1)];
 }
 
 namespace ORPG {
@@ -95,6 +137,7 @@ namespace ORPG {
                 "This is free software: you are free to change and redistribute it.\n"
                 "There is NO WARRANTY, to the extent permitted by law.\n\n"
                 "Usage: name-generator [options] \"[RACE | SUBRACE]\" [GENDER]\n"
+                        "\t-b --batch --stdin          Generate a name for each \"RACE [GENDER]\" line of stdin\n"
                         "\t-h --help                   Print this help screen\n"
                         "\t-v --version                Print version info\n"
                         "\t-V --verbose                Verbose program output\n"
@@ -313,6 +356,10 @@ namespace ORPG {
      * produced it will return an empty string.
      **/
     string NameGenerator::make_first() {
+        return rand_line_from_file(first_list());
+    }
+
+    string NameGenerator::first_list() {
         bool gendered = race_is_gendered(raceFile);
         if(gendered && gender.empty()) {
             if(Utils::randomBool()) gender = "female";
@@ -321,15 +368,9 @@ namespace ORPG {
             gender = "";
         }
 
-        string loc;
-
-        if(gender.empty()) {
-            loc = make_valid_location(location, raceFile);
-        } else {
-            loc = make_valid_location(location, gender, raceFile);
-        }
+        if(gender.empty()) return make_valid_location(location, raceFile);
 
-        return rand_line_from_file(loc);
+        return make_valid_location(location, gender, raceFile);
     }
 
     /**
@@ -341,12 +382,55 @@ namespace ORPG {
      * produced it will return an empty string.
      **/
     string NameGenerator::make_last() {
-        if(!race_has_last(raceFile)) {
-            return "";
-        }
+        auto loc = last_list();
 
-        auto loc = make_valid_location(location, "last", raceFile);
+        if(loc.empty()) return "";
 
         return rand_line_from_file(loc);
     }
+
+    string NameGenerator::last_list() {
+        if(!race_has_last(raceFile)) return "";
+
+        return make_valid_location(location, "last", raceFile);
+    }
+
+    /* fills picks with count random lines of list, or leaves it empty if list is */
+    static void pick_lines(const vector<string>& list, size_t count, vector<uint32>& picks) {
+        if(list.empty()) return;
+
+        auto& engine = Utils::thread_engine();
+        uniform_int_distribution<uint32> line(0, (uint32)list.size() - 1);
+
+        picks.resize(count);
+        for(auto& pick : picks) pick = line(engine);
+    }
+
+    NameBatch NameGenerator::make_names(size_t count) {
+        NameBatch ret;
+
+        ret.count = count;
+        ret.firsts = cached_name_list(first_list());
+
+        auto lastLoc = last_list();
+        ret.lasts = lastLoc.empty() ? make_shared<const vector<string>>() : cached_name_list(lastLoc);
+
+        pick_lines(*ret.firsts, count, ret.first);
+        pick_lines(*ret.lasts, count, ret.last);
+
+        return ret;
+    }
+
+    string NameBatch::name(size_t n) const {
+        string ret;
+
+        if(!first.empty()) ret += (*firsts)[first[n]];
+
+        if(!last.empty()) {
+            ret += " ";
+            ret += (*lasts)[last[n]];
+        }
+
+        return ret;
+    }
 }
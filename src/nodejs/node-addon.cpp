@@ -12,19 +12,31 @@ There is NO WARRANTY, to the extent permitted by law.
 using namespace ORPG;
 
 namespace ORPGJS {
+    using v8::Context;
     using v8::Local;
     using v8::Object;
 
-    void InitAll(Local<Object> exports) {
-        DieWrapper::Init(exports);
-        ExpressionTreeWrapper::Init(exports);
-        NameGeneratorWrapper::Init(exports);
+    void InitAll(Local<Object> exports, Local<Context> context) {
+        AddonData* data = new AddonData(context->GetIsolate());
+
+        DieWrapper::Init(exports, data);
+        ExpressionTreeWrapper::Init(exports, data);
+        NameGeneratorWrapper::Init(exports, data);
 
         NODE_SET_METHOD(exports, "ORPG_VERSION", ORPG_VERSION);
 
+        NODE_SET_METHOD(exports, "rollMany", roll_many);
+        NODE_SET_METHOD(exports, "simulate", simulate);
+
         NODE_SET_METHOD(exports, "race_has_last", race_has_last);
         NODE_SET_METHOD(exports, "race_is_gendered", race_is_gendered);
     }
+}
 
-    NODE_MODULE(orpg, InitAll)
+/**
+ * The addon is context aware, so it can be loaded once for the main thread
+ * and again for every worker_thread, each with its own AddonData.
+ **/
+NODE_MODULE_INIT() {
+    ORPGJS::InitAll(exports, context);
 }
\ No newline at end of file
@@ -10,6 +10,30 @@ declare module 'openrpg-libs' {
      * @return string - the version number of the built OpenRPG libraries that are being used
      **/
     export function ORPG_VERSION(): string;
+
+    /**
+     * @desc rolls a roll expression count times on a worker thread, leaving the
+     * event loop free while it runs
+     * @param string exp - the roll expression to roll
+     * @param number count - the number of times to roll it
+     * @return Promise<Int32Array> - every result, rejected with a TypeError if
+     * exp does not parse, or a RangeError if count is not a whole number
+     **/
+    export function rollMany(exp: string, count: number): Promise<Int32Array>;
+
+    /**
+     * @desc rolls a roll expression trials times on a worker thread, like
+     * rollMany, keeping only how often each total came up
+     * @param string exp - the roll expression to roll
+     * @param number trials - the number of times to roll it
+     * @return Promise - counts[n] is the number of times lowest + n came up
+     **/
+    export function simulate(exp: string, trials: number): Promise<{
+        lowest: number;
+        counts: Float64Array;
+        trials: number;
+        mean: number;
+    }>;
     
     export class Die {
         public constructor(max: number);
@@ -203,5 +227,16 @@ declare module 'openrpg-libs' {
          * produced it will return an empty string.
          **/
         public make_last(): string;
+
+        /**
+         * @desc Generates count full names at once, the same way make_name
+         * does, without crossing into the addon once per name. Names that
+         * share a first or last name share its string.
+         *
+         * @param number count - the number of names to generate
+         * @return string[] - the names. Throws a RangeError if count is not
+         * a whole number
+         **/
+        public makeNames(count: number): string[];
     }
 }
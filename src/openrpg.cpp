@@ -6,6 +6,7 @@ OpenRPG Software License - Version 1.0 - February 10th, 2017 <https://openrpg.io
 This is free software: you are free to change and redistribute it.
 There is NO WARRANTY, to the extent permitted by law.
 */
+#include <cstdlib>
 #include <iostream>
 #include <vector>
 #include <string>
@@ -13,6 +14,7 @@ There is NO WARRANTY, to the extent permitted by law.
 #include "openrpg.h"
 #include "names.h"
 #include "roll.h"
+#include "character/initiative.h"
 
 using namespace std;
 using namespace ORPG;
@@ -25,6 +27,105 @@ using namespace ORPG;
  **/
 vector<string> commandHistory;
 
+/* the initiative order of the battle being run with the init command */
+InitiativeTracker initiative;
+
+/**
+ * @desc prints the help info when help init is called in the ORPG shell.
+ * Because this is called from within our ORPG shell, the program will continue running.
+ **/
+void print_initiative_help() {
+    fputs("Usage: orpg > init [command]\n"
+          "\n"
+          "Available commands:\n"
+                "\tadd NAME [DEX] [INIT]                Add NAME to the battle with the Dexterity modifier DEX,\n"
+                "\t                                         rolling 1d20 + DEX unless INIT is given.\n"
+                "\tnext (n)                             Start the next turn.\n"
+                "\tlist (ls)                            Print the turn order, starting with the next turn.\n"
+                "\tremove (rm) NAME                     Remove NAME from the battle.\n"
+                "\tdelay NAME INIT                      Delay NAME, whose turn it is, to act later this round on INIT.\n"
+                "\tclear                                End the battle, removing everyone.\n",
+          stdout);
+}
+
+/**
+ * @desc parses a whole word as an integer, allowing a leading + or -
+ *
+ * @param const string& word - the word to parse
+ * @param int& out - set to the parsed value on success
+ * @return bool - true if word was a number
+ **/
+bool parse_int(const string& word, int& out) {
+    char* end = nullptr;
+    const long value = strtol(word.c_str(), &end, 10);
+
+    if(word.empty() || *end != '\0') return false;
+
+    out = (int)value;
+    return true;
+}
+
+/**
+ * @desc runs an init command from the ORPG shell against the initiative tracker
+ *
+ * @param const vector<string>& words - the words of the command, starting with init
+ **/
+void parse_initiative(const vector<string>& words) {
+    const string command = words.size() > 1 ? words[1] : "list";
+
+    if(command == "add" && words.size() >= 3) {
+        int dexMod = 0;
+        int roll = 0;
+
+        if(words.size() >= 4 && !parse_int(words[3], dexMod)) {
+            printf("DEX must be a number!\n");
+            return;
+        }
+
+        if(words.size() >= 5 && !parse_int(words[4], roll)) {
+            printf("INIT must be a number!\n");
+            return;
+        }
+
+        auto handle = words.size() >= 5 ?
+            initiative.add(words[2], dexMod, roll) :
+            initiative.add(words[2], dexMod);
+
+        printf("%s rolled %i\n", words[2].c_str(), initiative.get(handle).initiative);
+    } else if(command == "next" || command == "n") {
+        auto handle = initiative.next();
+
+        if(handle == InitiativeTracker::NONE) {
+            printf("No one is in the battle!\n");
+        } else {
+            printf("Round %i: %s (%i)\n", initiative.round(),
+                   initiative.get(handle).name.c_str(), initiative.get(handle).initiative);
+        }
+    } else if(command == "list" || command == "ls") {
+        for(auto handle : initiative.order()) {
+            auto& entry = initiative.get(handle);
+
+            printf("%4i  %s%s\n", entry.initiative, entry.name.c_str(),
+                   entry.round > initiative.round() ? " (next round)" : "");
+        }
+    } else if((command == "remove" || command == "rm") && words.size() >= 3) {
+        if(!initiative.remove(initiative.find(words[2]))) {
+            printf("%s is not in the battle!\n", words[2].c_str());
+        }
+    } else if(command == "delay" && words.size() >= 4) {
+        int roll = 0;
+
+        if(!parse_int(words[3], roll) ||
+           !initiative.delay(initiative.find(words[2]), roll)) {
+            printf("Only the current turn may delay, to a lower initiative!\n");
+        }
+    } else if(command == "clear") {
+        initiative.clear();
+    } else {
+        print_initiative_help();
+    }
+}
+
 /**
  * @desc This function parses all cla's passed to argv from the command line.
  * This function may terminate the program.
@@ -87,9 +188,11 @@ int parse_args(int argc, char* argv[]) {
 
 			/* -r --roll */
 			case 'r': {
-				ExpressionTree tree;
-				tree.set_expression(Core::optarg);
-				printf("%i\n", tree.parse_expression());
+				auto expression = ExpressionCache::shared().get(Core::optarg);
+
+				if(expression != nullptr) printf("%i\n", expression->evaluate());
+				else fprintf(stderr, "Invalid expression - %s\n", Core::optarg);
+
 				exit(EXIT_SUCCESS);
 			} break;
 
@@ -191,15 +294,18 @@ int parse_input(string in) {
                         exp += words[i];
                     }
 
-                    ExpressionTree tree;
-                    
-                    if(tree.set_expression(exp))
-                        printf("%i\n", tree.parse_expression());
+                    // the REPL tends to repeat itself, so parse through the shared cache
+                    auto expression = ExpressionCache::shared().get(exp);
+
+                    if(expression != nullptr)
+                        printf("%i\n", expression->evaluate());
                 } else {
                     Die d20;
 
                     printf("%i\n", d20.roll());
                 }
+            } else if(words[0] == "initiative" || words[0] == "init" || words[0] == "i") {
+                parse_initiative(words);
             } else if(words[0] == "help" || words[0] == "h" || words[0] == "H") {
                 /*
 				 * TODO complete the help command as follows
@@ -215,6 +321,8 @@ int parse_input(string in) {
                         Roll::PRINT_BASIC_HELP();
                     } else if(words[1] == "generate" || words[1] == "gen" || words[1] == "ng") {
                         Names::PRINT_BASIC_HELP();
+                    } else if(words[1] == "initiative" || words[1] == "init" || words[1] == "i") {
+                        print_initiative_help();
                     } else {
                         Core::PRINT_BASIC_HELP();
                     }
@@ -0,0 +1,422 @@
+/*
+orpgd - orpgd.cpp
+Created on: Oct 18, 2026
+
+OpenRPG Software License - Version 1.0 - February 10th, 2017 <https://openrpg.io/about/license/>
+This is free software: you are free to change and redistribute it.
+There is NO WARRANTY, to the extent permitted by law.
+*/
+#include <atomic>
+#include <cctype>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "openrpg.h"
+#include "character.h"
+#include "names.h"
+#include "roll.h"
+
+/* the socket orpgd listens on unless --socket is given */
+#define ORPGD_SOCKET            "/tmp/orpgd.sock"
+
+/* the longest request line a client may send, in bytes */
+#define ORPGD_MAX_REQUEST       4096
+
+/* the most clients served at once, any more are turned away */
+#define ORPGD_MAX_CONNECTIONS   64
+
+using namespace std;
+using namespace ORPG;
+
+/* the path of the socket we are listening on, kept so we can remove it on exit */
+static char SOCKET_PATH[sizeof(sockaddr_un::sun_path)] = ORPGD_SOCKET;
+
+/* the number of clients being served right now */
+static atomic<unsigned int> CONNECTIONS(0);
+
+/**
+ * @desc prints the version info when -V or --version is an argument to the command.
+ * This adhears to the GNU standard for version printing, and immediately terminates
+ * the program with exit code EXIT_SUCCESS
+ **/
+void print_version_flag() {
+    fputs("orpgd (openrpg) " VERSION " - " COPYRIGHT "\n"
+        "OpenRPG Software License - Version 1.0 - February 10th, 2017 <https://openrpg.io/about/license/>\n"
+        "This is free software: you are free to change and redistribute it.\n"
+        "There is NO WARRANTY, to the extent permitted by law.\n\n",
+        stdout);
+    exit(EXIT_SUCCESS);
+}
+
+/**
+ * @desc prints the help info when -h or --help is an argument to the command.
+ * This adhears to the GNU standard for help printing, and immediately terminates
+ * the program with exit code EXIT_SUCCESS
+ **/
+void print_help_flag() {
+    fputs("orpgd (openrpg) " VERSION " - " COPYRIGHT "\n"
+        "OpenRPG Software License - Version 1.0 - February 10th, 2017 <https://openrpg.io/about/license/>\n"
+        "This is free software: you are free to change and redistribute it.\n"
+        "There is NO WARRANTY, to the extent permitted by law.\n\n"
+        "Usage: orpgd [options]\n"
+                "\t-h --help                   Print this help screen\n"
+                "\t-s --socket=PATH            Listen on PATH (defaults to " ORPGD_SOCKET ")\n"
+                "\t-v --verbose                Verbose program output\n"
+                "\t-V --version                Print version info\n"
+        "\n"
+        "orpgd serves requests over a Unix domain socket, one per line:\n"
+                "\troll [EXPRESSION]           Rolls EXPRESSION (defaults to 1d20)\n"
+                "\tname [RACE] [GENDER]        Generates a name (RACE defaults to dwarf)\n"
+                "\tcharacter [FORMAT]          Generates a random character as text, json, or sheet\n"
+        "\n"
+        "Each reply is a line of 'ok LENGTH' or 'err LENGTH', followed by LENGTH bytes.\n"
+        "\n"
+        "Long options may not be passed with a single dash.\n"
+        "OpenRPG home page: <https://www.openrpg.io>\n"
+        "Report bugs to: <https://github.com/incomingstick/OpenRPG/issues>\n"
+        "See 'man orpgd' for more information [TODO add man pages].\n",
+        stdout);
+    exit(EXIT_SUCCESS);
+}
+
+/**
+ * @desc parses through the arguements passed by char* argv[] and runs
+ *     program logic realted to those arguements. This function may
+ *     exit the program
+ * @param int argc - length of argv as an integer
+ * @param char* argv[] - an array of cstrings read from the command line
+ * @return int - signifies the stats of the function call, 0 for success
+ **/
+int parse_args(int argc, char* argv[]) {
+    int status = EXIT_SUCCESS;
+
+    /* getopt_long stores the option and option index here */
+    int opt, opt_ind;
+
+    /* disables getopt printing to now be handled in '?' case */
+    Core::opterr = 0;
+
+    /* these are the long cla's and their corresponding chars */
+    static struct Core::option long_opts[] = {
+        {"help",        no_argument,        0,  'h'},
+        {"socket",      required_argument,  0,  's'},
+        {"verbose",     no_argument,        0,  'v'},
+        {"version",     no_argument,        0,  'V'},
+        /* NULL row to terminate struct */
+        {0,         0,                      0,   0}
+    };
+
+    while ((opt = Core::getopt_long(argc, argv, "hs:vV",
+                               long_opts, &opt_ind)) != EOF &&
+                               status != EXIT_FAILURE) {
+        switch (opt) {
+        /* -h --help */
+        case 'h': {
+            print_help_flag();
+        } break;
+
+        /* -s --socket */
+        case 's': {
+            if(strlen(Core::optarg) < sizeof(SOCKET_PATH)) {
+                strcpy(SOCKET_PATH, Core::optarg);
+            } else {
+                fprintf(stderr, "Error: --socket path is too long\n");
+                status = EXIT_FAILURE;
+            }
+        } break;
+
+        /* -v --verbose */
+        case 'v': {
+            Core::VB_FLAG = true;
+            Core::QUIET_FLAG = false;
+        } break;
+
+        /* -V --version */
+        case 'V': {
+            print_version_flag();
+        } break;
+
+        /* parsing error */
+        case ':':
+        case '?': {
+            print_help_flag();
+        } break;
+
+        /* if we get here something very bad happened */
+        default: {
+            printf("Aborting...\n");
+            status = EXIT_FAILURE;
+        }
+        }
+    }
+
+    return status;
+}
+
+/**
+ * @desc removes the socket and exits when we are asked to stop. Only async
+ * signal safe calls are made here.
+ **/
+void stop(int) {
+    unlink(SOCKET_PATH);
+    _exit(EXIT_SUCCESS);
+}
+
+/**
+ * @desc writes all of len bytes of data to fd, retrying short writes
+ * @return bool - true if everything was written
+ **/
+bool write_all(int fd, const char* data, size_t len) {
+    while(len > 0) {
+        ssize_t wrote = write(fd, data, len);
+
+        if(wrote <= 0) return false;
+
+        data += wrote;
+        len -= wrote;
+    }
+
+    return true;
+}
+
+/**
+ * @desc checks race could name a list in the data directory, i.e "dwarf" or
+ * "half-orc", before anything goes looking for it. Only letters, spaces, and
+ * dashes are allowed, so a client can not point us at any other file.
+ * @return bool - true if race may be a known race
+ **/
+bool valid_race(const string& race) {
+    if(race.empty()) return false;
+
+    for(char c : race) {
+        if(!isalpha((unsigned char)c) && c != ' ' && c != '-') return false;
+    }
+
+    return true;
+}
+
+/**
+ * Each connection is served by its own thread, up to ORPGD_MAX_CONNECTIONS
+ * at once. Parsed roll expressions are shared by every connection through
+ * ExpressionCache::shared(), name lists are shared by the names module once
+ * loaded, and each thread rolls with its own Utils::thread_engine().
+ **/
+class Connection {
+private:
+    int fd;
+
+    bool reply(bool ok, const string& payload) {
+        string out = (ok ? "ok " : "err ") + to_string(payload.size()) + "\n" + payload;
+
+        return write_all(fd, out.c_str(), out.size());
+    }
+
+    bool roll(const string& args) {
+        const string exp = args.empty() ? "1d20" : args;
+
+        auto expression = ExpressionCache::shared().get(exp);
+
+        if(expression == nullptr) return reply(false, "Invalid expression - " + exp);
+
+        return reply(true, to_string(expression->evaluate()));
+    }
+
+    bool name(const string& args) {
+        vector<string> words;
+        size_t pos = 0;
+
+        while(pos < args.size()) {
+            size_t end = args.find(' ', pos);
+            if(end == string::npos) end = args.size();
+
+            if(end > pos) words.push_back(args.substr(pos, end - pos));
+            pos = end + 1;
+        }
+
+        string race = "dwarf";
+        string gender;
+
+        // like name-generator the gender may come first or last, every other word is the race
+        if(words.size() > 1 && (words.front() == "male" || words.front() == "female")) {
+            gender = words.front();
+            words.erase(words.begin());
+        } else if(!words.empty() && (words.back() == "male" || words.back() == "female")) {
+            gender = words.back();
+            words.pop_back();
+        }
+
+        if(!words.empty()) {
+            race = words[0];
+            for(size_t i = 1; i < words.size(); i++) race += " " + words[i];
+        }
+
+        if(!valid_race(race)) return reply(false, "Unknown race - " + race);
+
+        NameGenerator generator(race, gender);
+        const string name = generator.make_name();
+
+        // a race with no name lists gives no name, and is not cached by the names module
+        if(name.empty()) return reply(false, "Unknown race - " + race);
+
+        return reply(true, name);
+    }
+
+    bool character(const string& args) {
+        if(!args.empty() && args != "text" && args != "json" && args != "sheet") {
+            return reply(false, "Unknown format - " + args + " (expects text, json, or sheet)");
+        }
+
+        unique_ptr<Character> character(Characters::new_random_character());
+        string out;
+
+        if(args == "json") out = character->to_json();
+        else if(args == "sheet") character->to_ascii_sheet(out);
+        else out = character->to_string();
+
+        return reply(true, out);
+    }
+
+    /* answers a single request line, returning false if the client is gone */
+    bool serve(const string& line) {
+        const size_t space = line.find(' ');
+        const string command = line.substr(0, space);
+        const string args = space == string::npos ? "" : line.substr(space + 1);
+
+        if(command == "roll") return roll(args);
+        if(command == "name") return name(args);
+        if(command == "character") return character(args);
+
+        return reply(false, "Unknown request - " + command + " (expects roll, name, or character)");
+    }
+
+public:
+    explicit Connection(int client): fd(client) {}
+
+    ~Connection() { close(fd); }
+
+    /* turns the client away without serving it */
+    void refuse() { reply(false, "Too many connections"); }
+
+    /* serves requests until the client hangs up */
+    void run() {
+        char buffer[ORPGD_MAX_REQUEST];
+        string pending;
+
+        while(true) {
+            ssize_t got = read(fd, buffer, sizeof(buffer));
+
+            if(got <= 0) return;
+
+            pending.append(buffer, got);
+
+            size_t start = 0;
+            size_t end;
+
+            while((end = pending.find('\n', start)) != string::npos) {
+                string line = pending.substr(start, end - start);
+                if(!line.empty() && line.back() == '\r') line.pop_back();
+
+                start = end + 1;
+
+                if(line.empty()) continue;
+
+                bool served;
+
+                // a request that throws fails on its own, rather than taking the daemon down with it
+                try {
+                    served = serve(line);
+                } catch(const exception& e) {
+                    served = reply(false, string("Request failed - ") + e.what());
+                }
+
+                if(!served) return;
+            }
+
+            pending.erase(0, start);
+
+            if(pending.size() > ORPGD_MAX_REQUEST) {
+                reply(false, "Request too long");
+                return;
+            }
+        }
+    }
+};
+
+int main(int argc, char* argv[]) {
+    int status = parse_args(argc, argv);
+
+    if(status != EXIT_SUCCESS) return status;
+
+    // locate the data once, before any connection goes looking for name lists
+    Core::DATA_LOCATION();
+
+    int server = socket(AF_UNIX, SOCK_STREAM, 0);
+
+    if(server < 0) {
+        perror("orpgd: socket");
+        return EXIT_FAILURE;
+    }
+
+    sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, SOCKET_PATH);
+
+    // a socket left behind by an orpgd that did not exit cleanly would fail the bind
+    unlink(SOCKET_PATH);
+
+    if(bind(server, (sockaddr*)&addr, sizeof(addr)) < 0 || listen(server, SOMAXCONN) < 0) {
+        perror("orpgd: bind");
+        close(server);
+        return EXIT_FAILURE;
+    }
+
+    signal(SIGPIPE, SIG_IGN);
+    signal(SIGINT, stop);
+    signal(SIGTERM, stop);
+
+    if(Core::VB_FLAG) fprintf(stderr, "orpgd: listening on %s\n", SOCKET_PATH);
+
+    while(true) {
+        int client = accept(server, nullptr, nullptr);
+
+        if(client < 0) {
+            if(errno == EINTR) continue;
+
+            perror("orpgd: accept");
+            break;
+        }
+
+        if(CONNECTIONS.fetch_add(1) >= ORPGD_MAX_CONNECTIONS) {
+            CONNECTIONS--;
+
+            Connection busy(client);
+            busy.refuse();
+            continue;
+        }
+
+        thread([client]() {
+            {
+                Connection connection(client);
+                connection.run();
+            }
+
+            CONNECTIONS--;
+        }).detach();
+    }
+
+    close(server);
+    unlink(SOCKET_PATH);
+
+    return EXIT_FAILURE;
+}
@@ -0,0 +1,132 @@
+/*
+roll - distribution.cpp
+Created on: Oct 18, 2026
+
+OpenRPG Software License - Version 1.0 - February 10th, 2017 <https://openrpg.io/about/license/>
+This is free software: you are free to change and redistribute it.
+There is NO WARRANTY, to the extent permitted by law.
+*/
+#include <algorithm>
+#include <cmath>
+
+#include "roll/distribution.h"
+
+using namespace std;
+
+namespace ORPG {
+    double Distribution::chance(int total) const {
+        if(total < lowest || total > highest()) return 0.0;
+
+        return probability[total - lowest];
+    }
+
+    double Distribution::at_least(int total) const {
+        double ret = 0.0;
+
+        for(int n = max(total, lowest); n <= highest(); n++) ret += probability[n - lowest];
+
+        return ret;
+    }
+
+    double Distribution::mean() const {
+        double ret = 0.0;
+
+        for(size_t n = 0; n < probability.size(); n++) ret += (lowest + (double)n) * probability[n];
+
+        return ret;
+    }
+
+    double Distribution::stddev() const {
+        const double avg = mean();
+        double ret = 0.0;
+
+        for(size_t n = 0; n < probability.size(); n++) {
+            const double diff = lowest + (double)n - avg;
+
+            ret += diff * diff * probability[n];
+        }
+
+        return sqrt(ret);
+    }
+
+    namespace Roll {
+        /* returns n choose k, as a double so large pools do not overflow */
+        static double choose(int n, int k) {
+            double ret = 1.0;
+
+            for(int i = 1; i <= k; i++) ret = ret * (n - k + i) / i;
+
+            return ret;
+        }
+
+        /**
+         * hands out the dice that are left to faces face down to 1, highest
+         * first, so the first keep dice handed out are the ones kept. weight is
+         * the number of outcomes that sort the dice handed out so far this way.
+         **/
+        static void walk_faces(int face, int left, int keep, int kept, double weight,
+                               vector<double>& counts) {
+            if(face == 1 || left == 0) {
+                // whatever is left all rolled a 1
+                counts[kept + min(keep, left)] += weight;
+                return;
+            }
+
+            for(int count = 0; count <= left; count++) {
+                const int taken = min(keep, count);
+
+                walk_faces(face - 1, left - count, keep - taken, kept + taken * face,
+                           weight * choose(left, count), counts);
+            }
+        }
+
+        Distribution keep_highest(int dice, int sides, int keep, int bonus) {
+            dice = max(1, dice);
+            sides = max(2, sides);
+            keep = max(1, min(dice, keep));
+
+            Distribution ret;
+            ret.lowest = keep + bonus;
+
+            vector<double> counts(keep * sides + 1, 0.0);
+            walk_faces(sides, dice, keep, 0, 1.0, counts);
+
+            const double outcomes = pow((double)sides, dice);
+
+            ret.probability.assign(counts.begin() + keep, counts.end());
+            for(auto& p : ret.probability) p /= outcomes;
+
+            return ret;
+        }
+
+        Distribution dice_sum(int dice, int sides, int bonus) {
+            dice = max(1, dice);
+            sides = max(2, sides);
+
+            // the chance of each total of the dice added so far, starting from one die
+            vector<double> sums(sides, 1.0 / sides);
+
+            for(int die = 1; die < dice; die++) {
+                vector<double> next(sums.size() + sides - 1, 0.0);
+                double window = 0.0;
+
+                // next[n] is the chance of sums[n - sides + 1] through sums[n], each times 1 / sides
+                for(size_t n = 0; n < next.size(); n++) {
+                    if(n < sums.size()) window += sums[n];
+                    if(n >= (size_t)sides) window -= sums[n - sides];
+
+                    // the running sum can drift just below zero, a chance never can
+                    next[n] = max(0.0, window / sides);
+                }
+
+                sums.swap(next);
+            }
+
+            Distribution ret;
+            ret.lowest = dice + bonus;
+            ret.probability = sums;
+
+            return ret;
+        }
+    }
+}
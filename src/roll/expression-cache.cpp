@@ -0,0 +1,169 @@
+/*
+roll - expression-cache.cpp
+Created on: Oct 18, 2026
+
+OpenRPG Software License - Version 1.0 - February 10th, 2017 <https://openrpg.io/about/license/>
+This is free software: you are free to change and redistribute it.
+There is NO WARRANTY, to the extent permitted by law.
+*/
+#include <cctype>
+#include <functional>
+
+#include "roll/expression-cache.h"
+
+using namespace std;
+
+namespace ORPG {
+    ExpressionCache::ExpressionCache(size_t capacity, size_t shards):
+        shardCount(shards == 0 ? 1 : shards) {
+        shardCapacity = (capacity + shardCount - 1) / shardCount;
+        if(shardCapacity == 0) shardCapacity = 1;
+
+        this->shards.reset(new Shard[shardCount]);
+    }
+
+    ExpressionCache::Shard& ExpressionCache::shard_for(const string& key) const {
+        return shards[hash<string>()(key) % shardCount];
+    }
+
+    shared_ptr<const Expression> ExpressionCache::get(const string& exp) {
+        const string key = normalize(exp);
+        Shard& shard = shard_for(key);
+
+        {
+            lock_guard<mutex> guard(shard.lock);
+
+            auto found = shard.index.find(key);
+
+            if(found != shard.index.end()) {
+                shard.hits++;
+                shard.order.splice(shard.order.begin(), shard.order, found->second);
+
+                return found->second->second;
+            }
+
+            shard.misses++;
+        }
+
+        // parse without holding the lock, so a slow expression does not stall the shard
+        shared_ptr<Expression> expression = make_shared<Expression>();
+
+        if(!Expression::parse(key, *expression)) return nullptr;
+
+        lock_guard<mutex> guard(shard.lock);
+
+        // another thread may have parsed the same expression in the meantime
+        auto found = shard.index.find(key);
+
+        if(found != shard.index.end()) return found->second->second;
+
+        shard.order.emplace_front(key, expression);
+        shard.index[key] = shard.order.begin();
+
+        if(shard.order.size() > shardCapacity) {
+            shard.index.erase(shard.order.back().first);
+            shard.order.pop_back();
+        }
+
+        return expression;
+    }
+
+    void ExpressionCache::clear() {
+        for(size_t i = 0; i < shardCount; i++) {
+            lock_guard<mutex> guard(shards[i].lock);
+
+            shards[i].index.clear();
+            shards[i].order.clear();
+            shards[i].hits = 0;
+            shards[i].misses = 0;
+        }
+    }
+
+    uint64 ExpressionCache::hits() const {
+        uint64 ret = 0;
+
+        for(size_t i = 0; i < shardCount; i++) {
+            lock_guard<mutex> guard(shards[i].lock);
+            ret += shards[i].hits;
+        }
+
+        return ret;
+    }
+
+    uint64 ExpressionCache::misses() const {
+        uint64 ret = 0;
+
+        for(size_t i = 0; i < shardCount; i++) {
+            lock_guard<mutex> guard(shards[i].lock);
+            ret += shards[i].misses;
+        }
+
+        return ret;
+    }
+
+    size_t ExpressionCache::size() const {
+        size_t ret = 0;
+
+        for(size_t i = 0; i < shardCount; i++) {
+            lock_guard<mutex> guard(shards[i].lock);
+            ret += shards[i].order.size();
+        }
+
+        return ret;
+    }
+
+    string ExpressionCache::normalize(const string& exp) {
+        string ret;
+        ret.reserve(exp.size());
+
+        // the brackets still open, so a group closed the wrong way keeps its style and fails to parse
+        string open;
+        bool matched = true;
+        bool spaced = false;
+
+        for(auto c : exp) {
+            if(isspace((unsigned char)c)) {
+                spaced = true;
+                continue;
+            }
+
+            // the lexer would read these two as one token, were it not for the space
+            if(spaced && !ret.empty()) {
+                const char last = ret.back();
+
+                if((isdigit((unsigned char)last) && isdigit((unsigned char)c)) ||
+                   ((last == '<' || last == '>' || last == '!') && c == '=')) {
+                    ret += ' ';
+                }
+            }
+
+            spaced = false;
+
+            if(c == '(' || c == '[' || c == '{') {
+                open += c;
+            } else if(c == ')' || c == ']' || c == '}') {
+                const char expected = c == ')' ? '(' : c == ']' ? '[' : '{';
+
+                if(open.empty() || open.back() != expected) matched = false;
+                else open.pop_back();
+            }
+
+            ret += c;
+        }
+
+        if(!matched) return ret;
+
+        for(auto& c : ret) {
+            if(c == '[' || c == '{') c = '(';
+            else if(c == ']' || c == '}') c = ')';
+        }
+
+        return ret;
+    }
+
+    ExpressionCache& ExpressionCache::shared() {
+        static ExpressionCache cache;
+
+        return cache;
+    }
+}
@@ -0,0 +1,672 @@
+/*
+roll - expression.cpp
+Created on: Oct 18, 2026
+
+OpenRPG Software License - Version 1.0 - February 10th, 2017 <https://openrpg.io/about/license/>
+This is free software: you are free to change and redistribute it.
+There is NO WARRANTY, to the extent permitted by law.
+*/
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "roll/expression.h"
+#include "roll/roll-parser.h"
+
+/* keep highest and lowest nodes rolling up to this many dice sort them on the stack */
+#define EXPRESSION_STACK_DICE   64
+
+/* the most totals worked out for the left side of a reroll, past this it is rolled out */
+#define EXPRESSION_TABLE_TOTALS 16384
+
+/* the most steps spent working out the chances of any one node */
+#define EXPRESSION_TABLE_STEPS  (1 << 22)
+
+/* the most different rolls a die with a rolled count or sides is worked out as a mix of */
+#define EXPRESSION_TABLE_MIXES  256
+
+using namespace std;
+
+namespace ORPG {
+    /* the same checks as ExpressionTree::checked_sum() and checked_multiplication() */
+    static int checked_sum(int op1, int op2) {
+        if ((op2 > 0 && op1 > INT_MAX - op2) || (op2 < 0 && op1 < INT_MIN - op2))
+            printf("overflow");
+        return op1 + op2;
+    }
+
+    static int checked_multiplication(int op1, int op2) {
+        int result = op1 * op2;
+        if(op1 != 0 && result / op1 != op2 )
+            printf("overflow");
+        return result;
+    }
+
+    bool Expression::parse(const string& exp, Expression& out) {
+        // each thread keeps a tree to parse with, so its nodes are only allocated once
+        static thread_local ExpressionTree tree;
+
+        if(!tree.set_expression(exp)) return false;
+
+        out = tree.compile();
+
+        return true;
+    }
+
+    /**
+     * @desc evaluates nodes[index] and everything under it, drawing every die
+     * from engine
+     **/
+    int Expression::evaluate_node(int32 index, Utils::RandomEngine& engine) const {
+        if(index < 0) return 0;
+
+        const Node& curr = nodes[index];
+
+        if(!curr.op && !curr.value) return 0;
+
+        // the children of a child, for the keep highest and lowest nodes
+        auto child = [&](int32 node, bool left) -> int32 {
+            if(node < 0) return -1;
+            return left ? nodes[node].left : nodes[node].right;
+        };
+
+        int sum = 0;
+
+        switch(curr.op) {
+        // error node
+        case OP_ERR: {
+            return 0;
+        } break;
+
+        // number node
+        case OP_NUMBER: {
+            sum = curr.value;
+        } break;
+
+        // n-sided die node
+        case OP_DIE: {
+            const int reps = curr.left >= 0 ? evaluate_node(curr.left, engine) : 1;
+            const int size = evaluate_node(curr.right, engine);
+
+            if(reps == 0) break;
+
+            if(size < 2 && size > -2) {
+                sum = checked_sum(sum, size);
+                break;
+            }
+
+            const Die die(size);
+
+            for(int i = 0; i < reps; i++) {
+                sum = checked_sum(sum, die.roll(engine));
+            }
+        } break;
+
+        // multiplication node
+        case OP_TIMES: {
+            sum = checked_multiplication(evaluate_node(curr.left, engine),
+                                         evaluate_node(curr.right, engine));
+        } break;
+
+        // integer division node
+        case OP_DIV: {
+            sum = (int)
+            ceil((float)evaluate_node(curr.left, engine) /
+                        evaluate_node(curr.right, engine));
+        } break;
+
+        // addition node
+        case OP_PLUS: {
+            sum = checked_sum(evaluate_node(curr.left, engine),
+                              evaluate_node(curr.right, engine));
+        } break;
+
+        // subtraction node
+        case OP_MINUS: {
+            sum = checked_sum(evaluate_node(curr.left, engine),
+                             -evaluate_node(curr.right, engine));
+        } break;
+
+        // modulo node
+        case OP_MOD: {
+            sum = evaluate_node(curr.left, engine) % evaluate_node(curr.right, engine);
+        } break;
+
+        // keep highest or lowest results node
+        case OP_HIGH:
+        case OP_LOW: {
+            const int reps = evaluate_node(child(curr.left, true), engine);
+            const int keep = evaluate_node(curr.right, engine);
+            const int size = evaluate_node(child(curr.left, false), engine);
+
+            if(reps == 0) break;
+
+            if(size < 2 && size > -2) {
+                sum = checked_sum(sum, size);
+                break;
+            }
+
+            int stack[EXPRESSION_STACK_DICE];
+            vector<int> heap;
+            int* results = stack;
+
+            if(reps > EXPRESSION_STACK_DICE) {
+                heap.resize(reps);
+                results = heap.data();
+            }
+
+            const Die die(size);
+
+            for(int i = 0; i < reps; i++) results[i] = die.roll(engine);
+
+            sort(results, results + max(0, reps));
+
+            // keeping more dice than were rolled keeps them all
+            const int kept = max(0, min(keep, reps));
+
+            if(curr.op == OP_HIGH) {
+                for(int i = reps - kept; i < reps; i++) sum = checked_sum(sum, results[i]);
+            } else {
+                for(int i = 0; i < kept; i++) sum = checked_sum(sum, results[i]);
+            }
+        } break;
+
+        // keep results greater than, greater or equal, less than, less or equal, or not equal to
+        case OP_GT:
+        case OP_GE:
+        case OP_LT:
+        case OP_LE:
+        case OP_NE: {
+            sum = reroll(curr, engine);
+        } break;
+
+        default: {
+            if(Core::VB_FLAG) fprintf(stderr, "Expression Parse Error: Invalid option - %c\n", curr.op);
+            exit(EXIT_FAILURE);
+        }
+        }
+
+        return sum;
+    }
+
+    /* whether op is one of the reroll nodes */
+    static bool is_reroll(short op) {
+        return op == OP_GT || op == OP_GE || op == OP_LT || op == OP_LE || op == OP_NE;
+    }
+
+    /* whether a total meets a reroll of op against limit */
+    static bool meets(short op, int total, int limit) {
+        switch(op) {
+        case OP_GT: return total > limit;
+        case OP_GE: return total >= limit;
+        case OP_LT: return total < limit;
+        case OP_LE: return total <= limit;
+        default:    return total != limit;
+        }
+    }
+
+    /* a result that is always value */
+    static Distribution point(int value) {
+        Distribution ret;
+        ret.lowest = value;
+        ret.probability.assign(1, 1.0);
+
+        return ret;
+    }
+
+    /**
+     * @desc works out how rolling reps size-sided dice and keeping keep of
+     * them is distributed, the same way evaluate_node() rolls them
+     * @return bool - false if there are too many totals or steps to work it out
+     **/
+    static bool roll_distribution(int reps, int size, int keep, bool high, Distribution& out) {
+        if(reps == 0) {
+            out = point(0);
+            return true;
+        }
+
+        if(size < 2 && size > -2) {
+            out = point(size);
+            return true;
+        }
+
+        // no dice rolled, or none of them kept
+        if(reps < 0 || keep <= 0) {
+            out = point(0);
+            return true;
+        }
+
+        // a Die made with fewer than 2 sides has 2
+        const int sides = max(2, size);
+        keep = min(keep, reps);
+
+        const double totals = (double)keep * (sides - 1) + 1;
+        if(totals > EXPRESSION_TABLE_TOTALS) return false;
+
+        if(keep == reps) {
+            if((double)reps * totals > EXPRESSION_TABLE_STEPS) return false;
+
+            out = Roll::dice_sum(reps, sides);
+            return true;
+        }
+
+        // keep_highest() walks each of the (reps + sides - 1) choose reps ways the dice can sort
+        double steps = 1.0;
+        for(int i = 1; i <= reps && steps <= EXPRESSION_TABLE_STEPS; i++) steps = steps * (sides - 1 + i) / i;
+
+        if(steps > EXPRESSION_TABLE_STEPS) return false;
+
+        out = Roll::keep_highest(reps, sides, keep);
+
+        // the lowest dice of a roll are the highest with every face turned over
+        if(!high) {
+            out.lowest = keep * (sides + 1) - out.highest();
+            reverse(out.probability.begin(), out.probability.end());
+        }
+
+        return true;
+    }
+
+    /**
+     * @desc works out how a op b is distributed, where a and b are rolled
+     * independently, using the same arithmetic as evaluate_node()
+     * @return bool - false if there are too many totals or steps to work it out
+     **/
+    static bool combine(const Distribution& a, const Distribution& b, short op, Distribution& out) {
+        if((double)a.probability.size() * b.probability.size() > EXPRESSION_TABLE_STEPS) return false;
+
+        // leave dividing by zero to evaluate_node()
+        if((op == OP_DIV || op == OP_MOD) && b.chance(0) > 0.0) return false;
+
+        auto apply = [op](long long x, long long y) -> long long {
+            switch(op) {
+            case OP_PLUS:   return x + y;
+            case OP_MINUS:  return x - y;
+            case OP_TIMES:  return x * y;
+            case OP_DIV:    return (long long)ceil((float)x / y);
+            default:        return x % y;
+            }
+        };
+
+        long long lowest = LLONG_MAX;
+        long long highest = LLONG_MIN;
+
+        for(size_t i = 0; i < a.probability.size(); i++) {
+            if(a.probability[i] <= 0.0) continue;
+
+            for(size_t j = 0; j < b.probability.size(); j++) {
+                if(b.probability[j] <= 0.0) continue;
+
+                const long long total = apply(a.lowest + (long long)i, b.lowest + (long long)j);
+
+                lowest = min(lowest, total);
+                highest = max(highest, total);
+            }
+        }
+
+        // anything that overflows is left to evaluate_node() too
+        if(lowest < INT_MIN || highest > INT_MAX || highest - lowest >= EXPRESSION_TABLE_TOTALS) return false;
+
+        out.lowest = (int)lowest;
+        out.probability.assign(highest - lowest + 1, 0.0);
+
+        for(size_t i = 0; i < a.probability.size(); i++) {
+            if(a.probability[i] <= 0.0) continue;
+
+            for(size_t j = 0; j < b.probability.size(); j++) {
+                if(b.probability[j] <= 0.0) continue;
+
+                const long long total = apply(a.lowest + (long long)i, b.lowest + (long long)j);
+
+                out.probability[total - lowest] += a.probability[i] * b.probability[j];
+            }
+        }
+
+        return true;
+    }
+
+    /**
+     * @desc adds the chances of d, times weight, in to into
+     * @return bool - false if into would hold too many totals
+     **/
+    static bool mix(Distribution& into, const Distribution& d, double weight) {
+        if(into.probability.empty()) {
+            into.lowest = d.lowest;
+            into.probability.assign(d.probability.size(), 0.0);
+        }
+
+        const int lowest = min(into.lowest, d.lowest);
+        const int highest = max(into.highest(), d.highest());
+
+        if((long long)highest - lowest >= EXPRESSION_TABLE_TOTALS) return false;
+
+        if(lowest < into.lowest) into.probability.insert(into.probability.begin(), into.lowest - lowest, 0.0);
+        into.lowest = lowest;
+        into.probability.resize(highest - lowest + 1, 0.0);
+
+        for(size_t n = 0; n < d.probability.size(); n++) {
+            into.probability[d.lowest - lowest + n] += d.probability[n] * weight;
+        }
+
+        return true;
+    }
+
+    /* the chance of a total of d that meets op against limit */
+    static double meeting(const Distribution& d, short op, int limit) {
+        double ret = 0.0;
+
+        for(size_t n = 0; n < d.probability.size(); n++) {
+            if(meets(op, d.lowest + (int)n, limit)) ret += d.probability[n];
+        }
+
+        return ret;
+    }
+
+    /**
+     * @desc works out the chance of every result nodes[index] can come up with,
+     * for the dice, keeps, rerolls, and arithmetic whose operands can be
+     * @return bool - false if it can not be worked out, so has to be rolled
+     **/
+    bool Expression::distribution_of(int32 index, Distribution& out) const {
+        // a missing operand, like the left of a unary minus, is 0
+        if(index < 0 || (!nodes[index].op && !nodes[index].value)) {
+            out = point(0);
+            return true;
+        }
+
+        const Node& curr = nodes[index];
+
+        // the value of an operand that always comes up the same
+        auto constant = [this](int32 node, int& value) -> bool {
+            Distribution d;
+
+            if(!distribution_of(node, d) || d.probability.size() != 1) return false;
+
+            value = d.lowest;
+            return true;
+        };
+
+        switch(curr.op) {
+        case OP_NUMBER: {
+            out = point(curr.value);
+            return true;
+        }
+
+        // a count or sides that are rolled themselves mix the rolls of each one they can be
+        case OP_DIE: {
+            Distribution reps = point(1);
+            Distribution size;
+
+            if(curr.left >= 0 && !distribution_of(curr.left, reps)) return false;
+            if(!distribution_of(curr.right, size)) return false;
+
+            if((double)reps.probability.size() * size.probability.size() > EXPRESSION_TABLE_MIXES) return false;
+
+            out = Distribution();
+
+            for(size_t r = 0; r < reps.probability.size(); r++) {
+                for(size_t s = 0; s < size.probability.size(); s++) {
+                    const double weight = reps.probability[r] * size.probability[s];
+                    if(weight <= 0.0) continue;
+
+                    const int count = reps.lowest + (int)r;
+                    Distribution roll;
+
+                    if(!roll_distribution(count, size.lowest + (int)s, count, true, roll)) return false;
+                    if(!mix(out, roll, weight)) return false;
+                }
+            }
+
+            return true;
+        }
+
+        case OP_HIGH:
+        case OP_LOW: {
+            if(curr.left < 0) return false;
+
+            int reps, size, keep;
+
+            if(!constant(nodes[curr.left].left, reps)) return false;
+            if(!constant(nodes[curr.left].right, size)) return false;
+            if(!constant(curr.right, keep)) return false;
+
+            return roll_distribution(reps, size, keep, curr.op == OP_HIGH, out);
+        }
+
+        case OP_PLUS:
+        case OP_MINUS:
+        case OP_TIMES:
+        case OP_DIV:
+        case OP_MOD: {
+            Distribution left, right;
+
+            if(!distribution_of(curr.left, left) || !distribution_of(curr.right, right)) return false;
+
+            return combine(left, right, curr.op, out);
+        }
+
+        // a reroll against a fixed limit keeps only the totals that meet it
+        case OP_GT:
+        case OP_GE:
+        case OP_LT:
+        case OP_LE:
+        case OP_NE: {
+            int limit;
+
+            if(!distribution_of(curr.left, out) || !constant(curr.right, limit)) return false;
+
+            const double chance = meeting(out, curr.op, limit);
+            if(chance <= 0.0) return false;
+
+            for(size_t n = 0; n < out.probability.size(); n++) {
+                if(meets(curr.op, out.lowest + (int)n, limit)) out.probability[n] /= chance;
+                else out.probability[n] = 0.0;
+            }
+
+            return true;
+        }
+
+        default: return false;
+        }
+    }
+
+    /* the chance of drawing a total from table at or below total */
+    static double below(const vector<double>& cdf, int lowest, long long total) {
+        if(total < lowest) return 0.0;
+        if(total - lowest >= (long long)cdf.size()) return cdf.back();
+
+        return cdf[total - lowest];
+    }
+
+    /**
+     * @desc finds the span of a cdf that holds the totals meeting op against
+     * limit. For OP_NE the span leaves out the chance of limit itself, which
+     * the caller steps over.
+     * @return double - the chance of meeting the limit, the width of the span
+     **/
+    static double span(const vector<double>& cdf, int lowest, short op, int limit, double& from, double& to) {
+        const double all = cdf.back();
+
+        switch(op) {
+        case OP_GT: from = below(cdf, lowest, limit);                to = all; break;
+        case OP_GE: from = below(cdf, lowest, (long long)limit - 1); to = all; break;
+        case OP_LT: from = 0.0; to = below(cdf, lowest, (long long)limit - 1); break;
+        case OP_LE: from = 0.0; to = below(cdf, lowest, limit);                break;
+        default: {
+            from = 0.0;
+            to = all - (below(cdf, lowest, limit) - below(cdf, lowest, (long long)limit - 1));
+        }
+        }
+
+        return to - from;
+    }
+
+    /**
+     * @desc rolls a reroll node: its left side until it meets the limit on its
+     * right. With a table the total is drawn straight from the ones that meet
+     * the limit, rolling the limit again only if no total could. Either way
+     * it gives up after curr.tries tries (see budget()), and like an error node
+     * evaluates to 0 rather than to a roll that does not meet the limit.
+     **/
+    int Expression::reroll(const Node& curr, Utils::RandomEngine& engine) const {
+        int limit = evaluate_node(curr.right, engine);
+
+        if(curr.table >= 0) {
+            const Table& table = tables[curr.table];
+            uniform_real_distribution<double> uniform(0.0, 1.0);
+
+            for(int tries = 0; tries < curr.tries; tries++) {
+                double from, to;
+
+                if(span(table.cdf, table.lowest, curr.op, limit, from, to) <= 0.0) {
+                    limit = evaluate_node(curr.right, engine);
+                    continue;
+                }
+
+                double u = from + uniform(engine) * (to - from);
+
+                // step over the chance of limit itself
+                if(curr.op == OP_NE && u >= below(table.cdf, table.lowest, (long long)limit - 1)) {
+                    u += below(table.cdf, table.lowest, limit) - below(table.cdf, table.lowest, (long long)limit - 1);
+                }
+
+                const size_t n = upper_bound(table.cdf.begin(), table.cdf.end(), u) - table.cdf.begin();
+                const int total = table.lowest + (int)min(n, table.cdf.size() - 1);
+
+                // rounding can land just outside the span, so draw again
+                if(meets(curr.op, total, limit)) return total;
+            }
+        } else {
+            for(int tries = 0; tries < curr.tries; tries++) {
+                const int total = evaluate_node(curr.left, engine);
+
+                if(meets(curr.op, total, limit)) return total;
+            }
+        }
+
+        if(Core::VB_FLAG) fprintf(stderr, "Expression error: gave up rerolling %s after %i tries\n",
+                                  text.c_str(), curr.tries);
+
+        return 0;
+    }
+
+    /**
+     * @desc checks the expression can not roll more than EXPRESSION_MAX_DICE
+     * dice in one evaluation, or a die with more than EXPRESSION_MAX_SIDES
+     * sides, and sets how many tries each reroll gets. Every node is given the
+     * largest magnitude it could come up with and the most dice it could roll,
+     * working up from the bottom, so a count or sides that is rolled is judged
+     * by the largest it could roll. A reroll tries EXPRESSION_REROLL_LIMIT
+     * times, or as many as fit the budget if that many would roll too many
+     * dice. Must be called after prepare(), which decides which rerolls have
+     * tables, and so do not roll their left side at all.
+     * @return bool - false if the expression is over budget
+     **/
+    bool Expression::budget() {
+        // kept between calls, so parsing does not allocate for them every time
+        static thread_local vector<double> largest, dice;
+
+        largest.assign(nodes.size(), 0.0);
+        dice.assign(nodes.size(), 0.0);
+
+        auto most = [&](int32 index) { return index < 0 ? 0.0 : largest[index]; };
+        auto rolls = [&](int32 index) { return index < 0 ? 0.0 : dice[index]; };
+
+        // every child is laid out after its parent, so work backwards
+        for(size_t n = nodes.size(); n-- > 0;) {
+            Node& curr = nodes[n];
+            const double left = most(curr.left);
+            const double right = most(curr.right);
+
+            dice[n] = rolls(curr.left) + rolls(curr.right);
+
+            switch(curr.op) {
+            case OP_NUMBER: largest[n] = fabs((double)curr.value); break;
+
+            case OP_DIE: {
+                const double reps = curr.left >= 0 ? left : 1.0;
+
+                if(reps > EXPRESSION_MAX_DICE || right > EXPRESSION_MAX_SIDES) return false;
+
+                largest[n] = reps * right;
+                dice[n] += reps;
+            } break;
+
+            case OP_PLUS:
+            case OP_MINUS:  largest[n] = left + right; break;
+            case OP_TIMES:  largest[n] = left * right; break;
+            case OP_DIV:
+            case OP_MOD:    largest[n] = left; break;
+
+            // keep highest and lowest roll the dice of their left side, which counted them
+            case OP_HIGH:
+            case OP_LOW:    largest[n] = left; break;
+
+            default: {
+                if(!is_reroll(curr.op)) break;
+
+                // each try rolls the limit again, and the left side too without a table
+                const double each = rolls(curr.right) + (curr.table >= 0 ? 0.0 : rolls(curr.left));
+                const double fit = each > 0.0 ? floor(EXPRESSION_MAX_DICE / each) : EXPRESSION_REROLL_LIMIT;
+
+                curr.tries = (int32)max(1.0, min<double>(fit, EXPRESSION_REROLL_LIMIT));
+
+                largest[n] = left;
+                dice[n] = curr.tries * each;
+            }
+            }
+
+            if(dice[n] > EXPRESSION_MAX_DICE) return false;
+        }
+
+        return true;
+    }
+
+    /**
+     * @desc works out a table for every reroll whose left side's chances can
+     * be, and checks each reroll with a known limit can be met at all
+     * @return bool - false if some reroll can never be met
+     **/
+    bool Expression::prepare() {
+        tables.clear();
+
+        for(auto& node : nodes) {
+            node.table = -1;
+
+            if(!is_reroll(node.op)) continue;
+
+            Distribution left;
+            if(!distribution_of(node.left, left)) continue;
+
+            Table table;
+            table.lowest = left.lowest;
+            table.cdf.resize(left.probability.size());
+
+            double sum = 0.0;
+            for(size_t n = 0; n < left.probability.size(); n++) table.cdf[n] = sum += left.probability[n];
+
+            // a limit that is known can be checked now, rather than rerolled forever
+            Distribution right;
+
+            if(distribution_of(node.right, right)) {
+                bool possible = false;
+                double from, to;
+
+                for(size_t n = 0; n < right.probability.size() && !possible; n++) {
+                    if(right.probability[n] <= 0.0) continue;
+
+                    possible = span(table.cdf, table.lowest, node.op, right.lowest + (int)n, from, to) > 0.0;
+                }
+
+                if(!possible) return false;
+            }
+
+            node.table = (int32)tables.size();
+            tables.push_back(move(table));
+        }
+
+        return true;
+    }
+}
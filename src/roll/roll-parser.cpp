@@ -6,8 +6,12 @@ OpenRPG Software License - Version 1.0 - February 10th, 2017 <https://openrpg.io
 This is free software: you are free to change and redistribute it.
 There is NO WARRANTY, to the extent permitted by law.
 */
+#include <algorithm>
+#include <cctype>
+#include <charconv>
 #include <climits>
 #include <string>
+#include <string_view>
 
 #include "core/config.h"
 #include "roll/roll-parser.h"
@@ -39,6 +43,7 @@ namespace ORPG {
                 "This is free software: you are free to change and redistribute it.\n"
                 "There is NO WARRANTY, to the extent permitted by law.\n\n"
                 "Usage: roll [options] XdY [+|-] AdB [+|-] N [...]\n"
+                        "\t-b --batch --stdin          Roll each line of stdin as its own expression\n"
                         "\t-h --help                   Print this help screen\n"
                         "\t-v --verbose                Verbose program output\n"
                         "\t-V --version                Print version info\n"
@@ -83,32 +88,14 @@ namespace ORPG {
     }
 
     /**
-     * @desc compares two values p1 and p2 as integers returning
-     *     p1 > p2 = 1, p1 < p2 = -1, p1 = p2 = 0 
-     * @param const void* p1 - first value to be compared
-     * @param const void* p2 - second value to be compared
-     * @return int - >  1, < -1, =  0
-     */
-    int compare(const void* p1, const void* p2) {
-        auto i1 = *((const int *)p1);
-        auto i2 = *((const int *)p2);
-
-        if (i1 > i2) return 1;
-        else if (i1 < i2) return -1;
-        else return 0;
-    }
-
-    /**
-     * @desc creates a pointer to an empty parse_node
+     * @desc creates a pointer to an empty parse_node, reusing one left over
+     *     from an earlier expression when there is one
      * @return struct parse_node* - and empty parse_node
      */
     parse_node* ExpressionTree::allocate_node() {
-        struct parse_node* node = new parse_node;
-        
-        if(node == NULL) {
-            printf("out of memory");
-            exit(EXIT_FAILURE);
-        }
+        if(used == nodes.size()) nodes.emplace_back(new parse_node);
+
+        struct parse_node* node = nodes[used++].get();
 
         /* initialize default values */
         node->left = NULL;
@@ -120,116 +107,6 @@ namespace ORPG {
         return node;
     }
 
-    /**
-     * @desc sets curr to a parse_node with an op value of OP_NUMBER and a value of
-     *     read from the input string and return the parent of curr
-     * @param struct parse_node* curr - the current node
-     * @param int* numBytesToRead - the number of bytes to read from the input string
-     * @return struct parse_node* - pointer to the parent of curr
-     */
-    struct parse_node* ExpressionTree::new_number(struct parse_node* curr, int
-                            * numBytesToRead) {
-        string currParseString = "";
-        int numBytesRead = 0;
-
-        parse_input_string(&currParseString, &numBytesRead, *numBytesToRead);
-
-        if(!curr->left) {
-            curr->left = allocate_node();
-            curr->left->parent = curr;
-            curr = curr->left;
-        } else if(!curr->right) {
-            curr->right = allocate_node();
-            curr->right->parent = curr;
-            curr = curr->right;
-        }
-                
-        curr->value = stoi(currParseString);
-        curr->op = OP_NUMBER;
-
-
-        if(curr->parent == NULL && (size_t)numBytesRead != inputString.length()) {
-            curr->parent = allocate_node();
-            curr->parent->left = curr;
-        }
-            
-        curr = curr->parent;
-
-        *numBytesToRead = 0;
-        
-        return curr;
-    }
-
-    /**
-     * @desc sets curr to a parse_node with an op value of op and a new node as the right
-     *     child of the curr node and returns the right child
-     * @param struct parse_node* curr - the current node
-     * @param short int op - the operator to be assigned to the curr parse_node 
-     * @return struct parse_node* - a pointer to the right child of curr
-     */
-    parse_node* ExpressionTree::new_op(struct parse_node* curr, short int op) {
-        if(curr->op) {
-            while(curr->parent &&
-                curr->parent->op != OP_EXPR) {
-                curr = curr->parent;
-            }
-
-            if(!curr->parent) {
-                curr->parent = allocate_node();
-                curr->parent->left = curr;
-                curr = curr->parent;
-            } else if(curr->parent->op == OP_EXPR) {
-                auto swapAddr = curr->parent;
-                curr->parent = allocate_node();
-                curr->parent->parent = swapAddr;
-                curr->parent->parent->left = curr->parent;
-                curr->parent->parent->right = curr->parent;
-                curr->parent->left = curr;
-                curr = curr->parent;
-            }
-        }
-        
-        curr->op = op;
-        curr->right = allocate_node();
-        curr->right->parent = curr;
-        curr = curr->right;
-        
-        return curr;
-    }
-
-    /**
-     * @desc sets curr to a parse_node with an op value of op and a new node as the right
-     *     child of the curr node and returns the right child
-     * @param struct parse_node* curr - the current node
-     * @return struct parse_node* - a pointer to the right child of curr
-     */
-    parse_node* ExpressionTree::new_die(struct parse_node* curr) {
-        if(curr->op) {
-            while(curr->parent && curr->parent->op != OP_EXPR) curr = curr->parent;
-            if(curr->op != OP_EXPR) {
-                curr->parent = allocate_node();
-                curr->parent->left = curr;
-                curr = curr->parent;
-            } else if(curr->op == OP_EXPR) {
-                auto swapAddr = curr->parent;
-                curr->parent = allocate_node();
-                curr->parent->parent = swapAddr;
-                curr = curr->parent;
-            }
-        }
-
-        if(!curr->left) {
-            curr->left = allocate_node();
-            curr->left->parent = curr;
-            curr->left->op = OP_NUMBER;
-            curr->left->value = 1;
-        }
-        
-        curr->op = OP_DIE;
-        
-        return curr;
-    }
-
     /**
      * @desc Sets node to an error state. The node's children and parent will been cleared
      * and the value will be set to 0. The op code will be set to OP_ERR.
@@ -283,7 +160,7 @@ namespace ORPG {
      * @param int - the amount of whitespace to indent the current node by
      * @return string - a string of the tree of parse_nodes
      */
-    string ExpressionTree::tree_string(struct parse_node* node, int indent, string pre) {
+    string ExpressionTree::tree_string(struct parse_node* node, int indent, string pre) const {
         int i;
         string pad("");
         string ret("");
@@ -298,292 +175,318 @@ namespace ORPG {
         return ret;
     }
 
+    // TODO ensure integrity of this string before we actually allow rolling
+    bool ExpressionTree::is_expression_valid(const std::string exp) {
+        return true;
+    }
+
     /**
-     * @desc parses the parse_node tree given the top node of the tree
-     *     and returns the end result of the expression
-     * @param struct parse_node* node - the top node of the tree to parse
-     * @return int - the end result of the expression
+     * @desc sets the input string to be scanned and parsed equal to the string exp
+     * @param const std::string exp - the string to become the input string
      */
-    int ExpressionTree::parse_tree(struct parse_node* node) {
-        int high;
-        int i;
-        int limit;
-        int low;
-        int size;
-        int reps;
-        int tmp;
-        int* results;
-        Die* die;
+    bool ExpressionTree::set_expression(const std::string exp) {
+        if(!is_expression_valid(exp)) return false;
+        
+        inputString = exp;
 
-        int ret = 0;
+        // nothing points in to the old tree once head moves on, so its nodes are free to reuse
+        used = 0;
+        head = allocate_node();
 
-        /* sets our current node to node */
-        auto curr = node;
+        // cleared rather than replaced, so the next expression reuses their space
+        compiled.nodes.clear();
+        compiled.tables.clear();
 
-        int sum = 0;
+        return build_expression_tree() && compile_expression();
+    }
 
-        if(!curr || (!curr->op && !curr->value)) {
-            return 0;
-        }
+    /**
+     * The lexer and parser behind build_expression_tree(). The lexer makes a
+     * single pass over the expression, handing the parser one token at a time,
+     * and the parser climbs operator precedence to build the tree top down, so
+     * no node needs to be moved once it is made.
+     *
+     * From loosest to tightest, the operators bind:
+     *      +  -                        left to right
+     *      *  /  %                     left to right
+     *      -  +  (unary)
+     *      h  l  >  >=  <  <=  !  !=   left to right, i.e 2d20h1+4 is (2d20h1)+4
+     *      d                           left to right, i.e 4d6h3 is (4d6)h3
+     *
+     * A 'd' with nothing before it rolls a single die, one with no number after
+     * it has no sides, and an expression may be grouped with (), [], or {} so
+     * long as each group opens and closes the same.
+     **/
+    class ExpressionTree::Parser {
+    private:
+        /* what a token may be, besides an OP_* code */
+        enum Token { TOKEN_END = 0, TOKEN_OPEN = -2, TOKEN_CLOSE = -3 };
+
+        ExpressionTree& tree;
+        string_view input;
+        size_t pos = 0;
+
+        short token = TOKEN_END;    // the current token, an OP_* code or a Token
+        int value = 0;              // the value of an OP_NUMBER token
+        char symbol = '\0';         // the character the current token starts with
+
+        int depth = 0;              // how many expression() calls are parsing
+        int height = 0;             // the height of the node parsed last
 
-        switch(curr->op) {
-        // error node
-        case OP_ERR: {
-            return 0;
-        } break;
+        /**
+         * @desc reads the next token in to token, value, and symbol. Anything
+         * that is not part of an expression becomes an OP_ERR token.
+         **/
+        void next() {
+            while(pos < input.size() && isspace((unsigned char)input[pos])) pos++;
 
-        // number node
-        case OP_NUMBER: {
-            sum = curr->value;
-        } break;
+            if(pos == input.size()) {
+                token = TOKEN_END;
+                symbol = '\0';
+                return;
+            }
 
-        // n-sided die node
-        case OP_DIE: {
-            reps = curr->left ? parse_tree(curr->left) : 1;
-            size = parse_tree(curr->right);
+            symbol = input[pos];
 
-            if(reps == 0) {
-                break;
-            }
+            if(isdigit((unsigned char)symbol)) {
+                const char* first = input.data() + pos;
+                const char* last = input.data() + input.size();
 
-            if(size < 2 && size > -2) {
-                sum = checked_sum(sum, size);
-                break;
-            }
+                auto read = from_chars(first, last, value);
 
-            die = new Die(size); 
-            
-            for(i = 0; i < reps; i++) {
-                sum = checked_sum(sum, die->roll());
-            }
-            
-            delete[] die;
-        } break;
-
-        // multiplication node
-        case OP_TIMES: {
-            sum = checked_multiplication(parse_tree(curr->left),
-                                         parse_tree(curr->right));
-        } break;
-
-        // integer division node
-        case OP_DIV: {
-            sum = (int)
-            ceil((float)parse_tree(curr->left) /
-                        parse_tree(curr->right));
-        } break;
-        
-        // addition node
-        case OP_PLUS: {
-            sum = checked_sum(parse_tree(curr->left),
-                              parse_tree(curr->right));
-        } break;
-        
-        // subtraction node
-        case OP_MINUS: {
-            sum = checked_sum(parse_tree(curr->left),
-                             -parse_tree(curr->right));
-        } break;
-
-        // modulo node
-        case OP_MOD: {
-            sum = parse_tree(curr->left) % parse_tree(curr->right);
-        } break;
-        
-        // keep highest results node
-        case OP_HIGH: {
-            reps = parse_tree(curr->left->left);
-            high = parse_tree(curr->right);
-            size = parse_tree(curr->left->right);
-
-            if(reps == 0) {
-                break;
+                token = read.ec == errc() ? OP_NUMBER : OP_ERR;
+                pos += read.ptr - first;
+                return;
             }
 
-            if(size < 2 && size > -2) {
-                sum = checked_sum(sum, size);
-                break;
+            pos++;
+
+            // the second character of >=, <=, and !=
+            const bool equals = pos < input.size() && input[pos] == '=';
+
+            switch(symbol) {
+            case '(': case '[': case '{': token = TOKEN_OPEN;  break;
+            case ')': case ']': case '}': token = TOKEN_CLOSE; break;
+            case '+': token = OP_PLUS;  break;
+            case '-': token = OP_MINUS; break;
+            case '*': token = OP_TIMES; break;
+            case '/': token = OP_DIV;   break;
+            case '%': token = OP_MOD;   break;
+            case 'd': token = OP_DIE;   break;
+            case 'h': token = OP_HIGH;  break;
+            case 'l': token = OP_LOW;   break;
+            case '>': token = equals ? OP_GE : OP_GT; break;
+            case '<': token = equals ? OP_LE : OP_LT; break;
+            case '!': token = OP_NE;    break;
+            default:  token = OP_ERR;
             }
 
-            // array to store the results to sort
-            if (!(results = new int[reps])) {
-                printf("out of memory");
-                break;
+            if(equals && (token == OP_GE || token == OP_LE || token == OP_NE)) pos++;
+        }
+
+        /**
+         * @desc returns how tightly an infix operator binds, 0 if op is not one
+         * @param short op - the OP_* code of the operator
+         * @return int - the binding power of op, higher binds tighter
+         **/
+        static int binding_power(short op) {
+            switch(op) {
+            case OP_PLUS:
+            case OP_MINUS:  return 10;
+            case OP_TIMES:
+            case OP_DIV:
+            case OP_MOD:    return 20;
+            case OP_HIGH:
+            case OP_LOW:
+            case OP_GT:
+            case OP_GE:
+            case OP_LT:
+            case OP_LE:
+            case OP_NE:     return 30;
+            case OP_DIE:    return 40;
+            default:        return 0;
             }
-        
-            Die* die = new Die(size);
+        }
+
+        /* unary + and - bind tighter than * but looser than dice, i.e -1d4*2 is (-(1d4))*2 */
+        static const int UNARY_POWER = 25;
 
-            for(i = 0; i < reps; i++) {
-                results[i] = die->roll();
+        /* reports why the expression did not parse, and returns NULL */
+        parse_node* fail(const char* why) {
+            if(Core::VB_FLAG) {
+                if(token == TOKEN_END) fprintf(stderr, "Expression parse error: %s at end of expression\n", why);
+                else fprintf(stderr, "Expression parse error: %s '%c' found in expression\n", why, symbol);
             }
 
-            delete die;
+            return NULL;
+        }
 
-            qsort(results, reps, sizeof(int), &compare);
+        /* reports an expression nested deeper than it may be evaluated, and returns NULL */
+        parse_node* too_deep() {
+            if(Core::VB_FLAG) fprintf(stderr, "Expression parse error: Expression nests more than %i deep\n", EXPRESSION_MAX_DEPTH);
+            return NULL;
+        }
 
-            for(i = (reps - high); i < reps; i++) {
-                sum = checked_sum(sum, results[i]);
-            }
-        
-            delete[] results;
-        } break;
-            
-        // keep lowest resutls node
-        case OP_LOW: {
-            reps    = parse_tree(curr->left->left);
-            low     = parse_tree(curr->right);
-            size    = parse_tree(curr->left->right);
-
-            if(reps == 0) {
-                break;
-            }
+        /**
+         * @desc returns a new node of op with the children left and right
+         * @param int below - the height of the taller child, 0 when there are none
+         * @return parse_node* - the node, or NULL if it nests too deeply
+         **/
+        parse_node* make_node(short op, parse_node* left, parse_node* right, int below = 0) {
+            height = below + 1;
+            if(height > EXPRESSION_MAX_DEPTH) return too_deep();
 
-            if(size < 2 && size > -2) {
-                sum = checked_sum(sum, size);
-                break;
-            }
-                    
-            /* array to store the results to sort */
-            if (!(results = new int[reps])) {
-                printf("out of memory");
-                break;
-            }
-        
-            Die* die = new Die(size);
+            parse_node* node = tree.allocate_node();
 
-            for(i = 0; i < reps; i++) {
-                results[i] = die->roll();
-            }
+            node->op = op;
+            node->left = left;
+            node->right = right;
 
-            delete die;
+            if(left) left->parent = node;
+            if(right) right->parent = node;
 
-            qsort(results, reps, sizeof(int), &compare);
-        
-            for(i = 0; i < low; i++) {
-                sum = checked_sum(sum, results[i]);
+            return node;
+        }
+
+        /**
+         * @desc parses the sides of a die, the token after its 'd'. A die with no
+         * number after it has no sides, i.e 0d-1 is (0d)-1, as it always has been.
+         * @param parse_node* count - the number of dice to roll
+         * @return parse_node* - the die, or NULL if its sides did not parse
+         **/
+        parse_node* sides(parse_node* count) {
+            const int below = height;
+
+            if(token != OP_NUMBER && token != TOKEN_OPEN && token != OP_DIE) {
+                return make_node(OP_DIE, count, NULL, below);
             }
-        
-            delete[] results;
-        } break;
-
-        // keep results greater than
-        case OP_GT: {
-            limit = parse_tree(curr->right);      
-            tmp   = parse_tree(curr->left);
-                
-            while (tmp <= limit) {
-                tmp = parse_tree(curr->left);
+
+            parse_node* right = expression(binding_power(OP_DIE) + 1);
+            return right ? make_node(OP_DIE, count, right, std::max(below, height)) : NULL;
+        }
+
+        /**
+         * @desc parses a number, a group, a die with no count, or a unary + or -
+         * @return parse_node* - the operand, or NULL if it did not parse
+         **/
+        parse_node* operand() {
+            switch(token) {
+            case OP_NUMBER: {
+                parse_node* node = make_node(OP_NUMBER, NULL, NULL);
+                node->value = value;
+                next();
+                return node;
             }
-                
-            sum = checked_sum(sum, tmp);
-        } break;
-
-        // keep results greater or equal than
-        case OP_GE: {
-            limit = parse_tree(curr->right);      
-            tmp   = parse_tree(curr->left);
-            
-            while (tmp < limit) {
-                tmp = parse_tree(curr->left);
+
+            case TOKEN_OPEN: {
+                const char open = symbol;
+                next();
+
+                parse_node* node = expression(0);
+                if(!node) return NULL;
+
+                const char close = open == '(' ? ')' : open == '[' ? ']' : '}';
+                if(token != TOKEN_CLOSE || symbol != close) return fail("Unmatched bracket");
+
+                next();
+                return node;
             }
-        
-            sum = checked_sum( sum, tmp );
-        } break;
-            
-        // keep results less than
-        case OP_LT: {
-            limit = parse_tree(curr->right);      
-            tmp   = parse_tree(curr->left);
-        
-            while (tmp >= limit) {
-                tmp = parse_tree(curr->left);
+
+            case OP_PLUS:
+            case OP_MINUS: {
+                const short op = token;
+                next();
+
+                parse_node* right = expression(UNARY_POWER);
+                return right ? make_node(op, NULL, right, height) : NULL;
             }
-        
-            sum = checked_sum(sum, tmp);
-        
-        } break;
-        
-        // keep results less or equal than
-        case OP_LE: {
-            limit = parse_tree(curr->right);      
-            tmp   = parse_tree(curr->left);
-        
-            while (tmp > limit) {
-                tmp = parse_tree(curr->left);
+
+            // a 'd' on its own rolls one die
+            case OP_DIE: {
+                next();
+
+                parse_node* one = make_node(OP_NUMBER, NULL, NULL);
+                one->value = 1;
+
+                return sides(one);
             }
-        
-            sum = checked_sum(sum, tmp);
-        } break;
-        
-        // keep result not equal to
-        case OP_NE: {
-            limit = parse_tree(curr->right);      
-            tmp   = parse_tree(curr->left);
-        
-            while (tmp == limit) {
-                tmp = parse_tree(curr->left);      
+
+            case OP_ERR: {
+                if(!isdigit((unsigned char)symbol)) return fail("Invalid character");
+
+                if(Core::VB_FLAG) fprintf(stderr, "Expression parse error: Number too large found in expression\n");
+                return NULL;
             }
-        
-            return ret;
-        } break;
 
-        default: {
-            if(Core::VB_FLAG) fprintf(stderr, "Expression Parse Error: Invalid option - %c\n", curr->op);
-            exit(EXIT_FAILURE);
+            case TOKEN_END: return fail("Expected a number");
+            default:        return fail("Expected a number before");
+            }
         }
+
+    public:
+        Parser(ExpressionTree& tree, string_view input): tree(tree), input(input) {
+            next();
         }
 
-        ret = checked_sum(ret, sum);
+        /**
+         * @desc parses operators binding at least as tightly as minPower
+         * @param int minPower - the loosest operator to take
+         * @return parse_node* - the top of the parsed tree, or NULL if it did not parse
+         **/
+        parse_node* expression(int minPower) {
+            // a failed parse is thrown away, so only a successful one unwinds depth
+            if(++depth > EXPRESSION_MAX_DEPTH) return too_deep();
 
-        return ret;
-    }
+            parse_node* left = operand();
 
-    /**
-     * @desc reads in to the buffer bytes equal to maxBytesToRead
-     *     begining with an offest equal to globalReadOffset
-     *     and incremnting globalReadOffset by the number of bytes
-     *     read.
-     * @param char* buff - pointer to the buffer
-     * @param int* numBytesRead - pointer to the number of bytes we have read
-     * @param int maxBytesToRead - the maximum number of bytes to read
-     * @return 0 - to signify success
-     */
-    int ExpressionTree::parse_input_string(string* buff, int* numBytesRead, int maxBytesToRead) {
-        int numBytesToRead = maxBytesToRead;
-        int bytesRemaining = inputString.length() - globalReadOffset;
-        
-        if(numBytesToRead > bytesRemaining) { numBytesToRead = bytesRemaining; }
+            while(left) {
+                const short op = token;
+                const int power = binding_power(op);
 
-        buff->clear();
+                if(power == 0 || power < minPower) break;
 
-        for(int i = 0; i < numBytesToRead; i++)
-            buff->push_back(inputString[i + globalReadOffset]);
-        
-        *numBytesRead = numBytesToRead;
-        globalReadOffset += numBytesToRead;
-        
-        return 0;
-    }
+                // only a roll has dice to keep
+                if((op == OP_HIGH || op == OP_LOW) && left->op != OP_DIE) {
+                    return fail("Expected dice before");
+                }
 
-    // TODO ensure integrity of this string before we actually allow rolling
-    bool ExpressionTree::is_expression_valid(const std::string exp) {
-        return true;
-    }
+                next();
 
-    /**
-     * @desc sets the input string to be scanned and parsed equal to the string exp
-     * and resets the globalReadOffset
-     * @param const std::string exp - the string to become the input string
-     */
-    bool ExpressionTree::set_expression(const std::string exp) {
-        if(!is_expression_valid(exp)) return false;
-        
-        inputString = exp;
-        globalReadOffset = 0;
-        head = allocate_node();
+                if(op == OP_DIE) {
+                    left = sides(left);
+                    continue;
+                }
 
-        return build_expression_tree();
-    }
+                // everything is left associative, so the right side must bind tighter
+                const int below = height;
+                parse_node* right = expression(power + 1);
+                if(!right) return NULL;
+
+                left = make_node(op, left, right, std::max(below, height));
+            }
+
+            --depth;
+            return left;
+        }
+
+        /**
+         * @desc parses the whole input
+         * @return parse_node* - the head of the tree, or NULL if it did not parse
+         **/
+        parse_node* parse() {
+            // an empty expression parses, to nothing
+            if(token == TOKEN_END) return tree.head;
+
+            parse_node* head = expression(0);
+
+            if(head && token != TOKEN_END) {
+                return fail(token == TOKEN_CLOSE ? "Unmatched bracket" :
+                            token == OP_ERR ? "Invalid character" : "Unexpected");
+            }
+
+            return head;
+        }
+    };
 
     /**
      * @desc scans the string held by the ExpressionTree and
@@ -600,264 +503,74 @@ namespace ORPG {
      *                 ^~~~~~~~~
      */
     bool ExpressionTree::build_expression_tree(void) {
-        int numBytesToRead = 0;
+        Parser parser(*this, inputString);
 
-        auto curr = head;
+        parse_node* root = parser.parse();
 
-        /**
-         * Basic rules of a math expression parser (these WILL need improvement)
-         *  1) If the current token is a '(', add a new node as the left
-         *      child of the current node, and descend to the left child.
-         * 
-         *  2) If the current token is in the list ['+','-','/','*'],
-         *      set value of the current node to the operator code
-         *      representation of the current token. Add a new node as the
-         *      right child of the current node and descend to the right child.
-         * 
-         *  3) If the current token is a number, set the root value of the
-         *      current node to the number and return to the parent.
-         * 
-         *  4) If the current token is a ')', go to the parent of the current node.
-         * 
-         * FIXME(incomingstick): Currently an expression could be opened with a '(' and
-         * closed with a ']' or '}' or vice versa
-         **/
-        for(auto it = inputString.begin(); it != inputString.end(); ++it) {
-            auto curr_ch = *it;
-            if(isdigit(curr_ch)) {
-                numBytesToRead++;
-            } else if(!isspace(curr_ch)) {
-                /* 3) If the current token is a number, set the root value of the
-                    current node to the number and return to the parent. */
-                if(numBytesToRead > 0) {
-                    curr = new_number(curr, &numBytesToRead);
-                }
+        if(!root) {
+            // Set the head to a error
+            head = node_error(head);
+            return false;
+        }
 
-                switch(curr_ch) {
-                /* 1) If the current token is a '(', '[', or '{', add a new node as the left
-                    child of the current node, and descend to the left child. */
-                case '{':
-                case '[':
-                case '(': {
-                    if(curr->op) {
-                        /**
-                         * If we currently have an op, try and create a new expression node as child.
-                         * An expression node has a single child that should be thought of as it's own
-                         * expression tree
-                         **/
-                        if(!curr->left) {
-                            curr->left = allocate_node();
-                            curr->left->parent = curr;
-                            curr = curr->left;
-                            curr->op = OP_EXPR;
-                        } else if(!curr->right) {
-                            curr->right = allocate_node();
-                            curr->right->parent = curr;
-                            curr = curr->right;
-                            curr->op = OP_EXPR;
-                        }
-
-                        // If we successfully made the OP_EXPR node, create the left child and move to it
-                        if(curr->op == OP_EXPR) {
-                            curr->left = allocate_node();
-                            curr->left->parent = curr;
-                            curr->right = curr->left;
-                            curr = curr->left;
-                        }
-                    }
-                } break;
-
-                /* 2) If the current token is in the list, set value of the current
-                    node to the operator code representation of the current token.
-                    Add a new node as the right child of the current node and descend
-                    to the right child. */
-                case '+': {
-                    curr = new_op(curr, OP_PLUS);
-                } break;
-
-                case '-': {
-                    curr = new_op(curr, OP_MINUS);
-                } break;
-
-                case '*': {
-                    curr = new_op(curr, OP_TIMES);
-                } break;
-
-                case '/': {
-                    curr = new_op(curr, OP_DIV);
-                } break;
-
-                case '%': {
-                    curr = new_op(curr, OP_MOD);
-                } break;
-
-                case 'd': {
-                    curr = new_die(curr);
-                } break;
-
-                // TODO generate a set (vector/array) of numbers
-                case 'h': {
-                    curr = new_op(curr, OP_HIGH);
-                } break;
-
-                // TODO generate a set (vector/array) of numbers
-                case 'l': {
-                    curr = new_op(curr, OP_LOW);
-                } break;
-
-                case '>': {
-                    curr = new_op(curr, OP_GT);
-                } break;
-
-                case '<': {
-                    curr = new_op(curr, OP_LT);
-                } break;
-
-                case '!': {
-                    curr = new_op(curr, OP_NE);
-                } break;
-
-                case '=': {
-                    if(curr->parent) {
-                        switch(curr->parent->op) {
-                        case OP_GT: {
-                            curr->parent->op = OP_GE;
-                        } break;
-
-                        case OP_LT: {
-                            curr->parent->op = OP_LE;
-                        } break;
-
-                        default: {
-                            if(Core::VB_FLAG) fprintf(stderr, "Expression parse error: Invalid character %c found in expression\n", curr_ch);
-                            // Set the head to a error
-                            head = node_error(head);
-                            return false;
-                        }
-                        }
-                    }
-                } break;
-
-                /* 4) If the current token is a ')', ']', or '}, go to the parent of the current node tree */
-                case '}':
-                case ']':
-                case ')': {
-                    if(curr->parent) {
-                        // ensure that if the currrent node is empty, that we bring up its child
-                        // if our current node's op and value are empty, we consider it an empty node
-                        if(!curr->op && !curr->value) {
-                            // check if our current node has a left or right child, and set that childs
-                            // parent to our current parent
-                            if(curr->left) {
-                                curr->left->parent = curr->parent;
-
-                                // if we are the left or right of our parent, set our child to that node
-                                if(curr->parent->left == curr)
-                                    curr->parent->left = curr->left;
-                                else if(curr->parent->right == curr)
-                                    curr->parent->right = curr->left;
-                            } else if(curr->right) {
-                                curr->right->parent = curr->parent;
-
-                                // if we are the left or right of our parent, set our child to that node
-                                if(curr->parent->left == curr)
-                                    curr->parent->left = curr->right;
-                                else if(curr->parent->right == curr)
-                                    curr->parent->right = curr->right;
-                            }
-
-                            curr = curr->parent;
-                        }
-
-                        // we are leaving the current expression so lets remove the OP_EXPR node by setting
-                        // the subtree's head as this node
-                        if(curr->parent && curr->parent->op == OP_EXPR) {
-                            if(curr->parent->parent->left == curr->parent)
-                                curr->parent->parent->left = curr;
-                            else if(curr->parent->parent->right == curr->parent)
-                                curr->parent->parent->right = curr;
-                            curr->parent = curr->parent->parent;
-                        }
-                    }
-                } break;
-
-                default: {
-                    /* 
-                    * Default case for this scanner.
-                    * This set of characters will include all
-                    * charcters not included above
-                    */
-                    if(Core::VB_FLAG) fprintf(stderr, "Expression parse error: Invalid character %c found in expression\n", curr_ch);
-                    head = node_error(head);
-                    return false;
-                }
-                }
+        head = root;
 
-                globalReadOffset++;  
-            } else {
-                /* 3) If the current token is a number, set the root value of the
-                    current node to the number and return to the parent. */
-                if(numBytesToRead > 0){
-                    curr = new_number(curr, &numBytesToRead);
-                    // if our current node's op and value are empty, we consider it an empty node
-                    if(!curr->op && !curr->value) {
-                        // check if our current node has a left or right child, and set that childs
-                        // parent to our current parent
-                        if(curr->left) {
-                            curr->left->parent = curr->parent;
-
-                            // if we are the left or right of our parent, set our child to that node
-                            if(curr->parent->left == curr)
-                                curr->parent->left = curr->left;
-                            else if(curr->parent->right == curr)
-                                curr->parent->right = curr->left;
-                        } else if(curr->right) {
-                            curr->right->parent = curr->parent;
-
-                            // if we are the left or right of our parent, set our child to that node
-                            if(curr->parent->left == curr)
-                                curr->parent->left = curr->right;
-                            else if(curr->parent->right == curr)
-                                curr->parent->right = curr->right;
-                        }
-
-                        curr = curr->parent;
-                    }
-                }
+        return true;
+    }
 
-                globalReadOffset++;
-            }
+    /**
+     * @desc lays the tree out flat in to compiled, and works out ahead of
+     * time how each reroll in it can be drawn (see Expression)
+     * @return bool - false if a reroll in the expression can never be met, or
+     * the expression rolls more dice than Expression allows
+     */
+    bool ExpressionTree::compile_expression(void) {
+        compiled.text = inputString;
 
-            /* 3) If the current token is a number, and we are the end of the string,
-                set the root value of the current node to the number and return to the parent. */
-            if(it + 1 == inputString.end() && numBytesToRead > 0) {
-                curr = new_number(curr, &numBytesToRead);
-                if(!curr->op && !curr->value) {
-                    // because this is the last item, we can assume it was placed
-                    // to the left of our current node
-                    curr->left->parent = curr->parent;
-
-                    // if our parent exists, set our child to our current position relative to our parent
-                    // otherwise we assume our child should become the head node
-                    if(curr->parent && curr->parent->left == curr)
-                        curr->parent->left = curr->left;
-                    else if(curr->parent && curr->parent->right == curr)
-                        curr->parent->right = curr->left;
-                    else {
-                        // we can assume the number node we just created is the only node
-                        // so set head to that node
-                        head = curr->left;
-                    }
-
-                    curr = curr->parent;
-                }
-            }
+        if(head->op != 0 || head->value != 0) compile_node(head);
+
+        if(!compiled.prepare()) {
+            if(Core::VB_FLAG) fprintf(stderr, "Expression parse error: a reroll in %s can never be met\n", inputString.c_str());
+
+            head = node_error(head);
+            compiled.nodes.clear();
+            compiled.tables.clear();
+            return false;
+        }
+
+        if(!compiled.budget()) {
+            if(Core::VB_FLAG) fprintf(stderr, "Expression parse error: %s rolls more than %i dice, or a die with more than %i sides\n",
+                                      inputString.c_str(), EXPRESSION_MAX_DICE, EXPRESSION_MAX_SIDES);
+
+            head = node_error(head);
+            compiled.nodes.clear();
+            compiled.tables.clear();
+            return false;
         }
-        while(head->parent) head = head->parent;    // TODO make our head tracking more efficient
 
         return true;
     }
 
+    /**
+     * @desc lays out node and everything under it at the end of compiled
+     * @param const struct parse_node* node - the top of the tree to lay out
+     * @return int32 - where node was laid out, -1 for no node
+     */
+    int32 ExpressionTree::compile_node(const struct parse_node* node) {
+        if(node == NULL) return -1;
+
+        const int32 index = (int32)compiled.nodes.size();
+        compiled.nodes.push_back({ node->op, node->value, -1, -1, -1, 0 });
+
+        const int32 left = compile_node(node->left);
+        const int32 right = compile_node(node->right);
+
+        compiled.nodes[index].left = left;
+        compiled.nodes[index].right = right;
+
+        return index;
+    }
+
     /**
      * @desc outputs an error with ERROR_CODE if there
      *     would be an addition overflow
@@ -865,7 +578,7 @@ namespace ORPG {
      * @param int op2 - an integer to be added
      * @return int - op1 + op2
      */
-    int ExpressionTree::checked_sum(int op1, int op2) {
+    int ExpressionTree::checked_sum(int op1, int op2) const {
         if ((op2 > 0 && op1 > INT_MAX - op2) || (op2 < 0 && op1 < INT_MIN - op2))
             printf("overflow");
         return op1 + op2;
@@ -878,7 +591,7 @@ namespace ORPG {
      * @param int op2 - an integer to be multiply by
      * @return int - op1 * op2
      */
-    int ExpressionTree::checked_multiplication(int op1, int op2) {
+    int ExpressionTree::checked_multiplication(int op1, int op2) const {
         int result = op1 * op2;
         if(op1 != 0 && result / op1 != op2 )
             printf("overflow");
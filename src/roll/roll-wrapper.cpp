@@ -6,13 +6,34 @@ OpenRPG Software License - Version 1.0 - February 10th, 2017 <http://www.openrpg
 This is free software: you are free to change and redistribute it.
 There is NO WARRANTY, to the extent permitted by law.
 */
+#include <algorithm>
+#include <cstdlib>
+#include <exception>
+#include <memory>
+#include <string>
+#include <vector>
+
 #include "roll/roll-wrapper.h"
 
+// uv.h pulls in sys/param.h, whose MAX(a, b) macro would swallow Die::MAX()
+#include <uv.h>
+#undef MAX
+
+/* the most rolls a single rollMany() or simulate() call may ask for */
+#define MAX_BATCH_ROLLS         (1 << 28)
+
 namespace ORPGJS {
+    using v8::ArrayBuffer;
+    using v8::BackingStore;
     using v8::Context;
+    using v8::Exception;
+    using v8::External;
+    using v8::Float64Array;
     using v8::Function;
     using v8::FunctionCallbackInfo;
     using v8::FunctionTemplate;
+    using v8::HandleScope;
+    using v8::Int32Array;
     using v8::Isolate;
     using v8::Local;
     using v8::NewStringType;
@@ -20,13 +41,12 @@ namespace ORPGJS {
     using v8::Boolean;
     using v8::Object;
     using v8::Persistent;
+    using v8::Promise;
     using v8::String;
     using v8::Value;
 
     using namespace ORPG;
 
-    Persistent<Function> DieWrapper::constructor;
-
     DieWrapper::DieWrapper(int max) : Die(max) {
         // does nothing
     }
@@ -35,11 +55,11 @@ namespace ORPGJS {
         // does nothing
     }
 
-    void DieWrapper::Init(Local<Object> exports) {
+    void DieWrapper::Init(Local<Object> exports, AddonData* data) {
         Isolate* isolate = exports->GetIsolate();
 
         // Prepare constructor template
-        Local<FunctionTemplate> tpl = FunctionTemplate::New(isolate, New);
+        Local<FunctionTemplate> tpl = FunctionTemplate::New(isolate, New, External::New(isolate, data));
         tpl->SetClassName(String::NewFromUtf8(isolate, "Die", NewStringType::kNormal).ToLocalChecked());
         tpl->InstanceTemplate()->SetInternalFieldCount(1);
 
@@ -48,7 +68,7 @@ namespace ORPGJS {
         NODE_SET_PROTOTYPE_METHOD(tpl, "MAX", MAX);
 
         Local<Context> context = isolate->GetCurrentContext();
-        constructor.Reset(isolate, tpl->GetFunction(context).ToLocalChecked());
+        data->dieConstructor.Reset(isolate, tpl->GetFunction(context).ToLocalChecked());
         exports->Set(context, String::NewFromUtf8(isolate, "Die", NewStringType::kNormal).ToLocalChecked(),
                      tpl->GetFunction(context).ToLocalChecked()).Check();
     }
@@ -68,7 +88,7 @@ namespace ORPGJS {
             // Invoked as plain function `Die(...)`, turn into construct call.
             const int argc = 1;
             Local<Value> argv[argc] = { args[0] };
-            Local<Function> cons = Local<Function>::New(isolate, constructor);
+            Local<Function> cons = Local<Function>::New(isolate, AddonData::From(args)->dieConstructor);
             Local<Object> result =
                 cons->NewInstance(context, argc, argv).ToLocalChecked();
             args.GetReturnValue().Set(result);
@@ -79,28 +99,23 @@ namespace ORPGJS {
         Isolate* isolate = args.GetIsolate();
 
         DieWrapper* obj = ObjectWrap::Unwrap<DieWrapper>(args.Holder());
-        Die die(obj->_MAX);
 
-        args.GetReturnValue().Set(Number::New(isolate, die.roll()));
+        args.GetReturnValue().Set(Number::New(isolate, obj->Die::roll()));
     }
 
     void DieWrapper::MAX(const v8::FunctionCallbackInfo<v8::Value>& args) {
         Isolate* isolate = args.GetIsolate();
 
         DieWrapper* obj = ObjectWrap::Unwrap<DieWrapper>(args.Holder());
-        Die die(obj->_MAX);
 
-        args.GetReturnValue().Set(Number::New(isolate, die.MAX()));
+        args.GetReturnValue().Set(Number::New(isolate, obj->Die::MAX()));
     }
 
-    Persistent<Function> ExpressionTreeWrapper::constructor;
-    ExpressionTree ExpressionTreeWrapper::wrappedTree;
-
-    void ExpressionTreeWrapper::Init(Local<Object> exports) {
+    void ExpressionTreeWrapper::Init(Local<Object> exports, AddonData* data) {
         Isolate* isolate = exports->GetIsolate();
 
         // Prepare constructor template
-        Local<FunctionTemplate> tpl = FunctionTemplate::New(isolate, New);
+        Local<FunctionTemplate> tpl = FunctionTemplate::New(isolate, New, External::New(isolate, data));
         tpl->SetClassName(String::NewFromUtf8(isolate, "ExpressionTree", NewStringType::kNormal).ToLocalChecked());
         tpl->InstanceTemplate()->SetInternalFieldCount(1);
 
@@ -114,7 +129,7 @@ namespace ORPGJS {
         NODE_SET_PROTOTYPE_METHOD(tpl, "is_exppression_valid", is_exppression_valid);
 
         Local<Context> context = isolate->GetCurrentContext();
-        constructor.Reset(isolate, tpl->GetFunction(context).ToLocalChecked());
+        data->expressionTreeConstructor.Reset(isolate, tpl->GetFunction(context).ToLocalChecked());
         exports->Set(context, String::NewFromUtf8(isolate, "ExpressionTree", NewStringType::kNormal).ToLocalChecked(),
                      tpl->GetFunction(context).ToLocalChecked()).Check();
     }
@@ -125,7 +140,6 @@ namespace ORPGJS {
         if (args.IsConstructCall()) {
             // Invoked as constructor: `new ExpressionTreeWrapper(...)`
             ExpressionTreeWrapper* obj = new ExpressionTreeWrapper();
-            wrappedTree = ExpressionTree();
             obj->Wrap(args.This());
             args.GetReturnValue().Set(args.This());
         } else {
@@ -133,7 +147,7 @@ namespace ORPGJS {
             const int argc = 1;
             Local<Value> argv[argc] = { args[0] };
             Local<Context> context = isolate->GetCurrentContext();
-            Local<Function> cons = Local<Function>::New(isolate, constructor);
+            Local<Function> cons = Local<Function>::New(isolate, AddonData::From(args)->expressionTreeConstructor);
             Local<Object> result =
                 cons->NewInstance(context, argc, argv).ToLocalChecked();
             args.GetReturnValue().Set(result);
@@ -147,13 +161,17 @@ namespace ORPGJS {
 
         std::string exp = *v8Str ? *v8Str : "1d20";
 
-        args.GetReturnValue().Set(Boolean::New(isolate, wrappedTree.set_expression(exp)));
+        ExpressionTreeWrapper* obj = ObjectWrap::Unwrap<ExpressionTreeWrapper>(args.Holder());
+
+        args.GetReturnValue().Set(Boolean::New(isolate, obj->ExpressionTree::set_expression(exp)));
     }
 
     void ExpressionTreeWrapper::parse_expression(const v8::FunctionCallbackInfo<v8::Value>& args) {
         Isolate* isolate = args.GetIsolate();
 
-        args.GetReturnValue().Set(Number::New(isolate, wrappedTree.parse_expression()));
+        ExpressionTreeWrapper* obj = ObjectWrap::Unwrap<ExpressionTreeWrapper>(args.Holder());
+
+        args.GetReturnValue().Set(Number::New(isolate, obj->ExpressionTree::parse_expression()));
     }
 
     void ExpressionTreeWrapper::checked_sum(const v8::FunctionCallbackInfo<v8::Value>& args) {
@@ -167,7 +185,9 @@ namespace ORPGJS {
     void ExpressionTreeWrapper::to_string(const v8::FunctionCallbackInfo<v8::Value>& args) {
         Isolate* isolate = args.GetIsolate();
 
-        auto treeString = wrappedTree.to_string();
+        ExpressionTreeWrapper* obj = ObjectWrap::Unwrap<ExpressionTreeWrapper>(args.Holder());
+
+        auto treeString = obj->ExpressionTree::to_string();
 
         const char*  str = treeString.c_str();
 
@@ -177,7 +197,9 @@ namespace ORPGJS {
     void ExpressionTreeWrapper::get_input_string(const v8::FunctionCallbackInfo<v8::Value>& args) {
         Isolate* isolate = args.GetIsolate();
 
-        auto treeString = wrappedTree.get_input_string();
+        ExpressionTreeWrapper* obj = ObjectWrap::Unwrap<ExpressionTreeWrapper>(args.Holder());
+
+        auto treeString = obj->ExpressionTree::get_input_string();
 
         const char*  str = treeString.c_str();
 
@@ -193,4 +215,203 @@ namespace ORPGJS {
 
         args.GetReturnValue().Set(Boolean::New(isolate, ExpressionTree::is_expression_valid(exp)));
     }
-}
\ No newline at end of file
+
+    /**
+     * A RollBatch carries a rollMany() or simulate() call from the event loop
+     * to a libuv worker thread and back. Nothing in it is touched by V8 while
+     * the worker runs.
+     **/
+    struct RollBatch {
+        uv_work_t request;
+        Isolate* isolate;
+        Persistent<Promise::Resolver> resolver;
+        Persistent<Object> resource;        // the async resource the Promise settles in
+        node::async_context asyncContext;
+
+        std::shared_ptr<const Expression> expression;
+        size_t count;
+        bool histogram;                     // true for simulate(), false for rollMany()
+
+        int32_t* results;                   // rollMany(): every result, handed to V8 when done
+        std::vector<double>* counts;        // simulate(): how often each total came up, also handed to V8
+        int lowest;                         // simulate(): the total counts[0] is for
+        double sum;                         // simulate(): the sum of every total
+
+        std::string error;                  // why the worker failed, empty if it did not
+    };
+
+    /* the work of roll_batch(), which the worker may throw out of */
+    static void roll_batch_work(RollBatch* batch) {
+        const Expression& expression = *batch->expression;
+        Utils::RandomEngine& engine = Utils::thread_engine();
+
+        if(!batch->histogram) {
+            for(size_t i = 0; i < batch->count; i++) batch->results[i] = expression.evaluate(engine);
+
+            return;
+        }
+
+        std::vector<double>& counts = *batch->counts;
+
+        for(size_t i = 0; i < batch->count; i++) {
+            const int total = expression.evaluate(engine);
+
+            if(counts.empty()) {
+                batch->lowest = total;
+                counts.push_back(0);
+            } else if(total < batch->lowest) {
+                counts.insert(counts.begin(), batch->lowest - total, 0);
+                batch->lowest = total;
+            } else if(total - batch->lowest >= (int)counts.size()) {
+                counts.resize(total - batch->lowest + 1, 0);
+            }
+
+            counts[total - batch->lowest]++;
+            batch->sum += total;
+        }
+    }
+
+    /* runs on a libuv worker thread. Nothing may throw out of here, it would abort the process */
+    static void roll_batch(uv_work_t* request) {
+        RollBatch* batch = static_cast<RollBatch*>(request->data);
+
+        try {
+            roll_batch_work(batch);
+        } catch(const std::exception& e) {
+            batch->error = e.what();
+        }
+    }
+
+    /* runs back on the event loop once roll_batch() is done, settling the Promise */
+    static void roll_batch_done(uv_work_t* request, int status) {
+        RollBatch* batch = static_cast<RollBatch*>(request->data);
+        Isolate* isolate = batch->isolate;
+
+        HandleScope handleScope(isolate);
+
+        Local<Promise::Resolver> resolver = Local<Promise::Resolver>::New(isolate, batch->resolver);
+        Local<Context> context = resolver->GetCreationContext().ToLocalChecked();
+        Context::Scope contextScope(context);
+
+        {
+            // settling the Promise inside a callback scope runs its reactions right after
+            node::CallbackScope callbackScope(isolate, Local<Object>::New(isolate, batch->resource),
+                                              batch->asyncContext);
+
+            if(!batch->error.empty()) {
+                free(batch->results);
+                delete batch->counts;
+
+                resolver->Reject(context, Exception::Error(String::NewFromUtf8(isolate,
+                    ("rolling failed - " + batch->error).c_str(), NewStringType::kNormal).ToLocalChecked())).Check();
+            } else if(batch->histogram) {
+                std::vector<double>* counts = batch->counts;
+                const size_t length = counts->size();
+
+                auto store = ArrayBuffer::NewBackingStore(counts->data(), length * sizeof(double),
+                    [](void*, size_t, void* owner) { delete static_cast<std::vector<double>*>(owner); },
+                    counts);
+
+                Local<ArrayBuffer> buffer = ArrayBuffer::New(isolate, std::move(store));
+                Local<Object> result = Object::New(isolate);
+
+                result->Set(context, String::NewFromUtf8(isolate, "lowest", NewStringType::kNormal).ToLocalChecked(),
+                            Number::New(isolate, batch->lowest)).Check();
+                result->Set(context, String::NewFromUtf8(isolate, "counts", NewStringType::kNormal).ToLocalChecked(),
+                            Float64Array::New(buffer, 0, length)).Check();
+                result->Set(context, String::NewFromUtf8(isolate, "trials", NewStringType::kNormal).ToLocalChecked(),
+                            Number::New(isolate, (double)batch->count)).Check();
+                result->Set(context, String::NewFromUtf8(isolate, "mean", NewStringType::kNormal).ToLocalChecked(),
+                            Number::New(isolate, batch->count > 0 ? batch->sum / batch->count : 0.0)).Check();
+
+                resolver->Resolve(context, result).Check();
+            } else {
+                auto store = ArrayBuffer::NewBackingStore(batch->results, batch->count * sizeof(int32_t),
+                    [](void* data, size_t, void*) { free(data); }, nullptr);
+
+                Local<ArrayBuffer> buffer = ArrayBuffer::New(isolate, std::move(store));
+
+                resolver->Resolve(context, Int32Array::New(buffer, 0, batch->count)).Check();
+            }
+        }
+
+        node::EmitAsyncDestroy(isolate, batch->asyncContext);
+
+        batch->resolver.Reset();
+        batch->resource.Reset();
+        delete batch;
+    }
+
+    /**
+     * @desc checks the arguments of rollMany() or simulate() and queues the
+     * batch on the libuv thread pool, returning its Promise. A bad argument
+     * rejects the Promise straight away.
+     **/
+    static void queue_roll_batch(const FunctionCallbackInfo<Value>& args, bool histogram) {
+        Isolate* isolate = args.GetIsolate();
+        Local<Context> context = isolate->GetCurrentContext();
+
+        Local<Promise::Resolver> resolver = Promise::Resolver::New(context).ToLocalChecked();
+        args.GetReturnValue().Set(resolver->GetPromise());
+
+        String::Utf8Value v8Str(isolate, args[0]);
+        const std::string exp = *v8Str ? *v8Str : "";
+        const double count = args[1]->NumberValue(context).FromMaybe(-1);
+
+        // an Expression never changes, so the worker can share the cached one
+        auto expression = args[0]->IsString() ? ExpressionCache::shared().get(exp) : nullptr;
+
+        if(expression == nullptr) {
+            resolver->Reject(context, Exception::TypeError(String::NewFromUtf8(isolate,
+                ("invalid roll expression '" + exp + "'").c_str(), NewStringType::kNormal).ToLocalChecked())).Check();
+            return;
+        }
+
+        if(!(count >= 0 && count <= MAX_BATCH_ROLLS) || count != (double)(size_t)count) {
+            resolver->Reject(context, Exception::RangeError(String::NewFromUtf8(isolate,
+                "the number of rolls must be a whole number from 0 to 268435456",
+                NewStringType::kNormal).ToLocalChecked())).Check();
+            return;
+        }
+
+        int32_t* results = nullptr;
+
+        if(!histogram) {
+            results = (int32_t*)malloc(std::max<size_t>(1, (size_t)count) * sizeof(int32_t));
+
+            if(results == nullptr) {
+                resolver->Reject(context, Exception::RangeError(String::NewFromUtf8(isolate,
+                    "not enough memory for that many rolls", NewStringType::kNormal).ToLocalChecked())).Check();
+                return;
+            }
+        }
+
+        RollBatch* batch = new RollBatch;
+
+        batch->request.data = batch;
+        batch->isolate = isolate;
+        batch->resolver.Reset(isolate, resolver);
+        batch->expression = expression;
+        batch->count = (size_t)count;
+        batch->histogram = histogram;
+        batch->results = results;
+        batch->counts = histogram ? new std::vector<double> : nullptr;
+        batch->lowest = 0;
+        batch->sum = 0.0;
+
+        Local<Object> resource = Object::New(isolate);
+        batch->resource.Reset(isolate, resource);
+        batch->asyncContext = node::EmitAsyncInit(isolate, resource,
+                                                  histogram ? "orpg:simulate" : "orpg:rollMany");
+
+        uv_queue_work(node::GetCurrentEventLoop(isolate), &batch->request, roll_batch, roll_batch_done);
+    }
+
+    void roll_many(const FunctionCallbackInfo<Value>& args) {
+        queue_roll_batch(args, false);
+    }
+
+    void simulate(const FunctionCallbackInfo<Value>& args) {
+        queue_roll_batch(args, true);
+    }
+}
@@ -6,14 +6,21 @@ OpenRPG Software License - Version 1.0 - February 10th, 2017 <https://openrpg.io
 This is free software: you are free to change and redistribute it.
 There is NO WARRANTY, to the extent permitted by law.
 */
+#include <cctype>
 #include <string>
 
 #include "openrpg.h"
+#include "core/buffered-reader.h"
+#include "core/buffered-writer.h"
+#include "roll/expression-cache.h"
 #include "roll/roll-parser.h"
 
 using namespace std;
 using namespace ORPG;
 
+/* set by -b --batch --stdin */
+static bool BATCH_FLAG = false;
+
 /**
   * @desc parses through the arguements passed by char* argv[] and runs
   *     program logic realted to those arguements. This function may
@@ -33,8 +40,10 @@ int parse_args(int argc, char* argv[], string* inputString) {
 
     /* these are the long cla's and their corresponding chars */
     static struct Core::option long_opts[] = {
+        {"batch",       no_argument,        0,  'b'},
         {"help",        no_argument,        0,  'h'},
         {"positive",    no_argument,        0,  'p'},
+        {"stdin",       no_argument,        0,  'b'},
         {"sum-series",  no_argument,        0,  's'},
         {"verbose",     no_argument,        0,  'v'},
         {"version",     no_argument,        0,  'V'},
@@ -42,9 +51,14 @@ int parse_args(int argc, char* argv[], string* inputString) {
         {0,         0,                      0,   0}
     };
 
-    while ((opt = getopt_long(argc, argv, "hvV",
+    while ((opt = getopt_long(argc, argv, "bhvV",
                                long_opts, &opt_ind)) != EOF) {
         switch (opt) {
+        /* -b --batch --stdin */
+        case 'b': {
+            BATCH_FLAG = true;
+        } break;
+
         /* -h --help */
         case 'h': {
             Roll::PRINT_HELP_FLAG();
@@ -94,6 +108,73 @@ int parse_args(int argc, char* argv[], string* inputString) {
     return status;
 }
 
+/**
+  * @desc returns the parse tree of exp, for verbose output. Only the parser
+  *     keeps the tree around, so exp is parsed again just to print it.
+  * @param const string& exp - a valid expression
+  * @return string - the tree as ExpressionTree::to_string() prints it
+  */
+string verbose_tree(const string& exp) {
+    ExpressionTree tree;
+    tree.set_expression(exp);
+
+    return tree.to_string();
+}
+
+/**
+  * @desc rolls every line of stdin as its own expression, writing one result
+  *     per line to stdout. Blank lines are skipped, and a line that is not an
+  *     expression gets an error on stderr and an empty line on stdout, so the
+  *     output always lines up with the input. Expressions are parsed through
+  *     the shared ExpressionCache, so a line that repeats is only parsed once.
+  * @return int - EXIT_FAILURE if any line was not an expression
+  */
+int roll_batch() {
+    int status = EXIT_SUCCESS;
+
+    Core::BufferedReader in(stdin);
+    Core::BufferedWriter out(stdout);
+
+    ExpressionCache& cache = ExpressionCache::shared();
+
+    const char* line;
+    size_t len;
+    string exp;
+
+    while(in.next_line(line, len)) {
+        // the same expression the arguments would make, which ignore whitespace
+        exp.clear();
+        for(size_t i = 0; i < len; i++) {
+            if(!isspace((unsigned char)line[i])) exp += line[i];
+        }
+
+        if(exp.empty()) continue;
+
+        auto expression = cache.get(exp);
+
+        if(expression == nullptr) {
+            fprintf(stderr, "Invalid expression - %s\n", exp.c_str());
+            out.write("\n", 1);
+            status = EXIT_FAILURE;
+            continue;
+        }
+
+        if(Core::VB_FLAG) out.write(verbose_tree(exp));
+
+        char result[16];
+        const int written = snprintf(result, sizeof(result), "%i\n", expression->evaluate());
+
+        out.write(result, written);
+
+        // the parser prints each die straight to stdout, keep it beside its result
+        if(Core::VB_FLAG) out.flush();
+    }
+
+    if(!out.flush()) status = EXIT_FAILURE;
+
+    return status;
+}
+
 /**
   * @desc parses through the arguements passed by char* argv[] and runs
   *     program logic realted to those arguements. This function may
@@ -106,14 +187,16 @@ int main(int argc, char* argv[]) {
     string inputString;
 
     int status = parse_args(argc, argv, &inputString);
-    
+
+    if(status == EXIT_SUCCESS && BATCH_FLAG) return roll_batch();
+
     if(status == EXIT_SUCCESS) {
-        ExpressionTree tree;
+        auto expression = ExpressionCache::shared().get(inputString);
 
-        if(tree.set_expression(inputString)) {
-            if(Core::VB_FLAG) printf("%s", tree.to_string().c_str());
+        if(expression != nullptr) {
+            if(Core::VB_FLAG) printf("%s", verbose_tree(inputString).c_str());
             
-            printf("%i\n", tree.parse_expression());
+            printf("%i\n", expression->evaluate());
         } else {
             // TODO: improve error output
             fprintf(stderr, "Invalid expression - %s\n", inputString.c_str());
@@ -0,0 +1,70 @@
+/*
+parse-bench - parse-bench.cpp
+Created on: Oct 18, 2026
+
+OpenRPG Software License - Version 1.0 - February 10th, 2017 <https://openrpg.io/about/license/>
+This is free software: you are free to change and redistribute it.
+There is NO WARRANTY, to the extent permitted by law.
+*/
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "roll/roll-parser.h"
+
+using namespace std;
+using namespace ORPG;
+
+/**
+ * Benchmarks the roll parser alone, without the ExpressionCache in front of
+ * it: every expression in the corpus is parsed from scratch, over and over,
+ * and the trees are checked so a parser that fails counts as a failure
+ * rather than a number.
+ *
+ * usage: parse-bench [corpus] [passes]
+ **/
+int main(int argc, char* argv[]) {
+    const string corpus = argc > 1 ? argv[1] : BENCH_CORPUS;
+    const int passes = argc > 2 ? atoi(argv[2]) : 20000;
+
+    vector<string> expressions;
+    ifstream file(corpus);
+    string line;
+
+    while(getline(file, line)) {
+        if(!line.empty()) expressions.push_back(line);
+    }
+
+    if(expressions.empty()) {
+        fprintf(stderr, "parse-bench: no expressions in %s\n", corpus.c_str());
+        return EXIT_FAILURE;
+    }
+
+    ExpressionTree tree;
+    size_t bytes = 0;
+
+    auto start = chrono::steady_clock::now();
+
+    for(int pass = 0; pass < passes; pass++) {
+        for(const auto& exp : expressions) {
+            if(!tree.set_expression(exp)) {
+                fprintf(stderr, "parse-bench: failed to parse %s\n", exp.c_str());
+                return EXIT_FAILURE;
+            }
+
+            bytes += exp.size();
+        }
+    }
+
+    const double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    const double parses = (double)passes * expressions.size();
+
+    printf("%zu expressions x %d passes: %.0f parses/s, %.1f ns/parse, %.1f MB/s\n",
+           expressions.size(), passes, parses / seconds, seconds * 1e9 / parses,
+           bytes / seconds / 1e6);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,75 @@
+/**
+ * Benchmarks the addon under worker_threads: every worker loads its own
+ * instance of the addon and works many ExpressionTrees and NameGenerators
+ * side by side, checking each result so any cross-talk between objects or
+ * threads shows up as a failure rather than a number.
+ *
+ * usage: node test/bench/workers.js [max workers] [operations per worker]
+ **/
+const os = require('os');
+const path = require('path');
+const { Worker, isMainThread, parentPort, workerData } = require('worker_threads');
+
+const ASSET_LOC = path.join(path.dirname(path.dirname(__dirname)), 'data/');
+const TREES = 16; // the number of trees each worker keeps in use at once
+
+if (isMainThread) {
+    const maxWorkers = parseInt(process.argv[2]) || os.cpus().length;
+    const operations = parseInt(process.argv[3]) || 1e6;
+
+    const run = (workers) => {
+        const start = process.hrtime.bigint();
+        const jobs = [];
+
+        for (let i = 0; i < workers; i++) {
+            jobs.push(new Promise((resolve, reject) => {
+                const worker = new Worker(__filename, { workerData: { operations } });
+                worker.once('message', resolve);
+                worker.once('error', reject);
+            }));
+        }
+
+        return Promise.all(jobs).then((results) => {
+            const seconds = Number(process.hrtime.bigint() - start) / 1e9;
+            const failures = results.reduce((sum, result) => sum + result.failures, 0);
+            const names = results.reduce((sum, result) => sum + result.names, 0);
+
+            console.log(`${workers} worker(s): ${(workers * operations / seconds / 1e6).toFixed(2)}M rolls/s, ` +
+                        `${(names / seconds / 1e3).toFixed(1)}k names/s, ${failures} failures (${seconds.toFixed(2)}s)`);
+        });
+    };
+
+    let chain = Promise.resolve();
+    for (let workers = 1; workers <= maxWorkers; workers *= 2) chain = chain.then(() => run(workers));
+    chain.catch((err) => { console.error(err); process.exit(1); });
+} else {
+    const ORPG = require('../../src/nodejs/export');
+    const trees = [];
+    let failures = 0;
+
+    // tree n always rolls n*100 + 1d6, so a tree reading another trees expression is caught
+    for (let n = 0; n < TREES; n++) {
+        trees.push(new ORPG.ExpressionTree());
+        trees[n].set_expression(`${n * 100}+1d6`);
+    }
+
+    for (let i = 0; i < workerData.operations; i++) {
+        const n = i % TREES;
+        const val = trees[n].parse_expression();
+
+        if (val <= n * 100 || val > n * 100 + 6) failures++;
+    }
+
+    const races = ['dwarf', 'elf', 'human', 'halfling'];
+    const generators = races.map((race) => new ORPG.NameGenerator(race, 'male', ASSET_LOC));
+    let names = 0;
+
+    for (let i = 0; i < workerData.operations / 100; i++) {
+        const generator = generators[i % generators.length];
+
+        if (generator.get_race() !== races[i % races.length]) failures++;
+        if (generator.make_name().length > 0) names++;
+    }
+
+    parentPort.postMessage({ failures, names });
+}
@@ -0,0 +1,112 @@
+/*
+capi-test.c - Test program for the C API, written in C so it is built the
+way any other language binding would use it
+
+OpenRPG Software License - Version 1.0 - February 10th, 2017 <https://openrpg.io/about/license/>
+This is free software: you are free to change and redistribute it.
+There is NO WARRANTY, to the extent permitted by law.
+*/
+#include <stdio.h>
+#include <string.h>
+
+#include "capi/orpg.h"
+
+int main(int argc, char* argv[]) {
+    int32_t rolls[1000];
+    uint8_t scores[6 * 100];
+    size_t offsets[50];
+    char buffer[4096];
+    char tiny[4];
+    orpg_roll* roll;
+    orpg_names* names;
+    int64_t needed;
+    int len;
+    size_t i;
+
+    (void)argc;
+    (void)argv;
+
+    if(orpg_api_version() != ORPG_C_API_VERSION)            return 1;
+    if(orpg_version()[0] != 'v')                            return 1;
+
+    /* a compiled expression rolls inside its bounds, one at a time or in bulk */
+    roll = orpg_roll_compile("2d6+1");
+    if(roll == NULL)                                        return 1;
+
+    if(orpg_roll_eval(roll, rolls) != ORPG_OK)              return 1;
+    if(orpg_roll_eval_batch(roll, rolls, 1000) != ORPG_OK)  return 1;
+
+    for(i = 0; i < 1000; i++) {
+        if(rolls[i] < 3 || rolls[i] > 13)                   return 1;
+    }
+
+    if(orpg_roll_eval_batch(NULL, rolls, 1) != ORPG_ERROR_ARGUMENT) return 1;
+    orpg_roll_free(roll);
+
+    /* keeping from more dice than a roll may have fails to compile, rather than to roll */
+    if(orpg_roll_compile("2000000000d6h1") != NULL)         return 1;
+    if(strlen(orpg_last_error()) == 0)                      return 1;
+
+    roll = orpg_roll_compile("100000d6h1");
+    if(roll == NULL)                                        return 1;
+    if(orpg_roll_eval_batch(roll, rolls, 10) != ORPG_OK)    return 1;
+    if(rolls[0] != 6)                                       return 1;
+    orpg_roll_free(roll);
+    orpg_roll_free(NULL);
+
+    /* a bad expression is NULL, and says why */
+    if(orpg_roll_compile("abc") != NULL)                   return 1;
+    if(strlen(orpg_last_error()) == 0)                      return 1;
+    if(orpg_roll_compile(NULL) != NULL)                     return 1;
+
+    /* names are written snprintf() style */
+    names = orpg_names_create("dwarf", "male", TESTING_ASSET_LOC);
+    if(names == NULL)                                       return 1;
+
+    len = orpg_names_make(names, buffer, sizeof(buffer));
+    if(len <= 0 || (size_t)len != strlen(buffer))           return 1;
+
+    len = orpg_names_make(names, tiny, sizeof(tiny));
+    if(len < 0 || strlen(tiny) != (size_t)(len < 3 ? len : 3)) return 1;
+
+    if(orpg_names_make(names, NULL, 0) <= 0)                return 1;
+
+    /* a batch is NUL separated, and untouched when it does not fit */
+    needed = orpg_names_make_batch(names, 50, buffer, sizeof(buffer), offsets);
+    if(needed <= 0 || needed > (int64_t)sizeof(buffer))     return 1;
+
+    for(i = 0; i < 50; i++) {
+        const char* name = buffer + offsets[i];
+
+        if(strlen(name) == 0 || strchr(name, ' ') == NULL)  return 1;
+        if(i > 0 && offsets[i] != offsets[i - 1] + strlen(buffer + offsets[i - 1]) + 1) return 1;
+    }
+
+    memset(tiny, 'x', sizeof(tiny));
+    if(orpg_names_make_batch(names, 50, tiny, sizeof(tiny), offsets) <= (int64_t)sizeof(tiny)) return 1;
+    if(tiny[0] != 'x')                                      return 1;
+
+    orpg_names_free(names);
+
+    if(orpg_names_create(NULL, NULL, NULL) != NULL)         return 1;
+
+    /* scores come back a character at a time */
+    if(orpg_scores_generate("4d6h3", 100, scores) != ORPG_OK) return 1;
+
+    for(i = 0; i < 6 * 100; i++) {
+        if(scores[i] < 3 || scores[i] > 18)                 return 1;
+    }
+
+    if(orpg_scores_generate("standard", 1, scores) != ORPG_OK) return 1;
+    if(scores[0] + scores[1] + scores[2] + scores[3] + scores[4] + scores[5] != 72) return 1;
+
+    if(orpg_scores_generate("abc", 1, scores) != ORPG_ERROR_EXPRESSION) return 1;
+
+    /* a character is written the same way a name is */
+    len = orpg_character_generate(ORPG_FORMAT_JSON, buffer, sizeof(buffer));
+    if(len <= 0 || (size_t)len >= sizeof(buffer) || buffer[0] != '{') return 1;
+
+    if(orpg_character_generate((orpg_format)42, buffer, sizeof(buffer)) != ORPG_ERROR_FORMAT) return 1;
+
+    return 0;
+}
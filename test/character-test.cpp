@@ -0,0 +1,498 @@
+/*
+character-test.cpp - Test program for the character module
+Created on: Oct 18, 2026
+
+OpenRPG Software License - Version 1.0 - February 10th, 2017 <https://openrpg.io/about/license/>
+This is free software: you are free to change and redistribute it.
+There is NO WARRANTY, to the extent permitted by law.
+*/
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+
+#include "core/xml.h"
+#include "character/ability-generation.h"
+#include "character/build-optimizer.h"
+#include "character/character.h"
+#include "character/checks.h"
+#include "character/combat.h"
+#include "character/initiative.h"
+#include "character/population.h"
+#include "character/progression.h"
+#include "character/roster.h"
+#include "character/sheet.h"
+
+using namespace std;
+using namespace ORPG;
+using namespace ORPG::Characters;
+
+int main(int argc, char* argv[]) {
+    /* a Human adds +1 to every score, so everything starts at 11 (+0) */
+    Character character(select_race(Human::ID), new AbilityScores(10),
+                        select_character_class(Wizard::ID), Acolyte::ID,
+                        new Skills, "Test Subject");
+
+    if(character.get_first_name() != "Test")        return 1;
+    if(character.get_last_name() != "Subject")      return 1;
+    if(character.STR() != 11)                       return 1;
+    if(character.SKILL_MOD(ATH) != 0)               return 1;
+    if(character.PASSIVE(PRC) != 10)                return 1;
+
+    /* derived values must follow a changed score */
+    character.set_ability_score(STR, 18);
+    if(character.SKILL_MOD(ATH) != 4)               return 1;
+    if(character.STR_SAVE() != 4)                   return 1;
+    if(character.SKILL_MOD(ACR) != 0)               return 1;
+
+    character.set_ability_score(WIS, 14);
+    if(character.PASSIVE(PRC) != 12)                return 1;
+
+    character.set_level(5);
+    if(character.get_proficiency_bonus() != 3)      return 1;
+    if(character.STR_SAVE() != 4)                   return 1;
+
+    /* a Population member must round trip back into the same Character */
+    Population population;
+
+    character.set_save_prof(INT, true);
+    character.set_skill_prof(ARC, 2);
+    character.set_hit_points(20, 30, 5);
+
+    Population::Index member = population.add(character);
+    population.add(character);
+
+    if(population.size() != 2)                      return 1;
+    if(population.first_name(member) != "Test")     return 1;
+    if(population.intern("Test") != population.intern("Test")) return 1;
+    if(population.race_id(member) != Human::ID)     return 1;
+
+    Character* copy = population.to_character(member);
+
+    if(copy == nullptr)                             return 1;
+    if(copy->get_last_name() != "Subject")          return 1;
+    if(copy->STR() != 18 || copy->get_level() != 5) return 1;
+    if(copy->INT_SAVE() != character.INT_SAVE())    return 1;
+    if(copy->get_current_hp() != 20)                return 1;
+    if(copy->get_skill_prof(ARC) != 2)           return 1;
+    if(copy->get_languages() != character.get_languages()) return 1;
+
+    delete copy;
+
+    /* a Character saved without a name must not be given one when loaded */
+    FixedNameProvider noName;
+    Character unnamed(select_race(Human::ID), new AbilityScores(10),
+                      select_character_class(Wizard::ID), Acolyte::ID,
+                      new Skills, "", &noName);
+
+    Population unnamedPopulation;
+    copy = unnamedPopulation.to_character(unnamedPopulation.add(unnamed));
+
+    if(copy == nullptr)                             return 1;
+    if(!copy->get_first_name().empty() || !copy->get_last_name().empty()) return 1;
+
+    delete copy;
+
+    /* bulk ops must agree with the Character they came from */
+    int8 saves[2];
+    population.saves(INT, saves);
+    if(saves[1] != character.INT_SAVE())            return 1;
+
+    vector<uint8> passed;
+    if(population.roll_saves(STR, 100, passed) != 0) return 1;
+
+    vector<uint8> mask;
+    if(population.filter_mask([](const Population& p, Population::Index i) {
+            return i == 1; }, mask) != 1)           return 1;
+
+    population.apply_damage(mask, 8);
+    if(population.temp_hp(1) != 0 || population.current_hp(1) != 17) return 1;
+    if(population.current_hp(0) != 20)              return 1;
+
+    /* a roster must read back exactly what was written */
+    const string rosterFile = "character-test.roster";
+    RosterWriter writer;
+
+    character.set_skill_prof(ARC, 2);
+    character.set_languages({ Common, Draconic });
+
+    writer.add(character);
+    writer.add(population, 1);
+
+    if(!writer.save(rosterFile))                    return 1;
+
+    RosterReader reader;
+
+    if(!reader.open(rosterFile))                    return 1;
+    if(reader.size() != 2 || reader.version() != ROSTER_VERSION) return 1;
+    if(string(reader.first_name(1)) != "Test")      return 1;
+    if(reader[0].skill_prof(ARC) != 2)              return 1;
+    if(reader[1].currHP != 17)                      return 1;
+
+    copy = reader.to_character(0);
+
+    if(copy == nullptr)                             return 1;
+    if(copy->get_last_name() != "Subject")          return 1;
+    if(copy->get_skill_prof(ARC) != 2)              return 1;
+    if(copy->get_languages().size() != 2)           return 1;
+    if(copy->SKILL_MOD(ARC) != character.SKILL_MOD(ARC)) return 1;
+
+    delete copy;
+
+    reader.close();
+
+    /* nor may a first name with a space in it be split up */
+    FixedNameProvider twoWords("Mary Ann", "Smith");
+    Character spaced(select_race(Human::ID), new AbilityScores(10),
+                     select_character_class(Wizard::ID), Acolyte::ID,
+                     new Skills, "", &twoWords);
+
+    RosterWriter spacedWriter;
+    spacedWriter.add(spaced);
+
+    if(!spacedWriter.save(rosterFile) || !reader.open(rosterFile)) return 1;
+
+    copy = reader.to_character(0);
+
+    if(copy == nullptr)                             return 1;
+    if(copy->get_first_name() != "Mary Ann" || copy->get_last_name() != "Smith") return 1;
+
+    delete copy;
+
+    reader.close();
+    remove(rosterFile.c_str());
+
+    /* anything that is not a roster must be refused */
+    if(reader.open("character-test.missing"))       return 1;
+
+    /* imported numbers are decimal even with a leading zero, and a level without hit points gets its own */
+    const string xmlFile = "character-test.xml";
+    FILE* xml = fopen(xmlFile.c_str(), "w");
+
+    if(xml == nullptr)                              return 1;
+    fprintf(xml, "<character name=\"Imported\" race=\"%#x\" class=\"%#x\" background=\"%#x\" level=\"03\">\n"
+                 "    <abilities str=\"10\" dex=\"08\" con=\"14\" int=\"09\" wis=\"10\" cha=\"10\"/>\n"
+                 "</character>\n", Human::ID, Wizard::ID, Acolyte::ID);
+    fclose(xml);
+
+    Characters::ImportError importError;
+    copy = Characters::import_character(xmlFile, &importError);
+    remove(xmlFile.c_str());
+
+    if(copy == nullptr)                             return 1;
+    if(copy->DEX() != 8 || copy->INT() != 9 || copy->get_level() != 3) return 1;
+    if(copy->get_max_hp() != 20 || copy->get_current_hp() != 20) return 1;
+
+    delete copy;
+
+    /* a sheet template fills and pads each placeholder */
+    SheetTemplate sheet;
+
+    if(!sheet.compile("[{{str:3}}|{{first_name:>6}}]\n")) return 1;
+
+    SheetValue values[SHEET_FIELD_COUNT] = {};
+    values[SHEET_STR] = { "18", 2 };
+    values[SHEET_FIRST_NAME] = { "Test", 4 };
+
+    string rendered;
+    sheet.render(values, rendered);
+    if(rendered != "[18 |  Test]\n")               return 1;
+
+    if(sheet.compile("ok\n{{nope:3}}"))             return 1;
+    if(sheet.get_error() != "line 2: unknown placeholder 'nope'") return 1;
+    if(sheet.compile("{{str:3"))                    return 1;
+
+    SheetTemplate asciiSheet;
+
+    if(!asciiSheet.load_file(TESTING_ASSET_LOC "/" ASCII_SHEET_TEMPLATE)) return 1;
+
+    character.to_ascii_sheet(rendered, asciiSheet);
+    if(rendered.find("Test") == string::npos)       return 1;
+
+    // the widest numbers must fit their field, and nothing past it may leak in
+    Character extreme(select_race(Human::ID), new AbilityScores(10),
+                      select_character_class(Wizard::ID), Acolyte::ID,
+                      new Skills, "Test Subject");
+
+    extreme.set_level(20);
+    extreme.set_exp(-2000000000);
+    extreme.to_ascii_sheet(rendered, asciiSheet);
+
+    if(rendered.find('\0') != string::npos)         return 1;
+    if(rendered.find("-2000000000/355000") == string::npos) return 1;
+
+    /* the XML parser should report the line a problem was found on */
+    Core::XMLDocument doc;
+
+    if(!doc.parse("<a>\n  <b x=\"1\"/>\n</a>\n"))    return 1;
+    if(doc.get_root()->first_child_element("b")->attribute("x") != "1") return 1;
+    if(doc.get_root()->first_child_element("b")->get_line_number() != 2) return 1;
+
+    if(doc.parse("<a>\n  <b>\n</a>\n"))             return 1;
+    if(doc.get_error_line() != 3)                   return 1;
+
+    /* races, classes and backgrounds are shared, every lookup hands back the same one */
+    if(select_race(Human::ID) != select_race(Human::ID)) return 1;
+    if(select_character_class(Wizard::ID) != select_character_class(Wizard::ID)) return 1;
+    if(select_background(Acolyte::ID) != select_background(Acolyte::ID)) return 1;
+    if(select_race(Elf::ID)->to_string() != "Elf")  return 1;
+    if(select_race(Race::ID) != nullptr)            return 1;
+
+    /* characters built without a name take one from their NameProvider */
+    FixedNameProvider stub("Stub", "Name");
+    Character stubbed(select_race(Elf::ID), new AbilityScores, select_character_class(Wizard::ID),
+                      Acolyte::ID, new Skills, "", &stub);
+
+    if(stubbed.get_first_name() != "Stub" || stubbed.get_last_name() != "Name") return 1;
+
+    ListNameProvider list({ "Ann Alpha", "Bob" });
+    string first, last;
+
+    list.make_name(*select_race(Human::ID), first, last);
+    if(first != "Ann" || last != "Alpha")           return 1;
+    list.make_name(*select_race(Human::ID), first, last);
+    if(first != "Bob" || !last.empty())             return 1;
+    list.make_name(*select_race(Human::ID), first, last);
+    if(first != "Ann")                              return 1;
+
+    Character* generated = new_random_character(&list);
+    if(generated->get_first_name() != "Bob")        return 1;
+    delete generated;
+
+    GeneratorNameProvider generatorNames(TESTING_ASSET_LOC);
+
+    generatorNames.make_name(*select_race(Human::ID), first, last);
+    if(first.empty() || last.empty())               return 1;
+
+    /* a Wizard (d6) with +0 Constitution gains 1 - 6 hit points a level */
+    Character climber(select_race(Human::ID), new AbilityScores(10),
+                      select_character_class(Wizard::ID), Acolyte::ID, new Skills, "Level Test");
+
+    const int gain = climber.level_up();
+    if(gain < 1 || gain > 6)                        return 1;
+    if(climber.get_level() != 2 || climber.get_max_hp() != 6 + gain) return 1;
+    if(climber.add_exp(EXP[2]) != 2 || climber.get_level() != 4) return 1;
+
+    while(climber.get_level() < 20) climber.level_up();
+    if(climber.level_up() != 0)                     return 1;
+    if(climber.get_max_hp() < 25 || climber.get_max_hp() > 120) return 1;
+
+    Population party;
+    party.add(climber);
+    party.add(stubbed);
+
+    if(party.level_up(5) != 4 || party.level(1) != 5) return 1;
+    if(party.level(0) != 20 || party.max_hp(0) != climber.get_max_hp()) return 1;
+    // a Constitution of 0 (-5) still gains the minimum of 1 hit point a level
+    if(party.max_hp(1) != stubbed.get_max_hp() + 4) return 1;
+
+    HitPointDistribution spread = simulate_hit_points(*select_character_class(Wizard::ID), 0, 1000, 1);
+    if(spread.samples != 1000 || spread.lowest(1) != 6 || spread.highest(1) != 6) return 1;
+    if(spread.lowest(20) < 25 || spread.highest(20) > 120) return 1;
+    if(spread.mean(20) < 60 || spread.mean(20) > 85) return 1;
+    if(spread.percentile(20, 0.5) < spread.lowest(20)) return 1;
+
+    /* a knight that cannot be hit must always beat two rats, one a round unless he rolls a 1 */
+    Combatant knight = { "Knight", { 16, 10, 14, 10, 10, 10 }, 50, 30, { { "Sword", 30, "1d8+10" } } };
+    Combatant rat = { "Rat", { 2, 11, 9, 2, 10, 4 }, 1, 10, { { "Bite", 0, "1" } } };
+
+    EncounterSimulator duel({ knight }, { rat, rat });
+    if(!duel.is_valid())                            return 1;
+
+    EncounterResult outcome = duel.run(500, 2);
+    if(outcome.combats != 500 || outcome.partyWins + outcome.monsterWins + outcome.draws != 500) return 1;
+    if(outcome.survivors[0] != 500)                 return 1;
+    if(outcome.mean_rounds() < 2.0 || outcome.mean_rounds() > 2.5) return 1;
+
+    // a natural 20 always hits, so the knight may lose a point or two, but never most of it
+    if(outcome.mean_party_hp() < 95.0)              return 1;
+
+    // a side with no hit points between them has already lost
+    Combatant fallen = rat;
+    fallen.maxHP = 0;
+
+    outcome = EncounterSimulator({ knight }, { fallen, fallen }).run(10, 1);
+    if(outcome.partyWins != 10 || outcome.rounds[0] != 10) return 1;
+
+    rat.attacks[0].damage = "bite";
+    if(EncounterSimulator({ knight }, { rat }).is_valid()) return 1;
+    if(EncounterSimulator({ knight }, {}).is_valid()) return 1;
+
+    /* ties go to the higher Dexterity modifier, then to whoever joined first */
+    InitiativeTracker tracker;
+    auto goblin = tracker.add("goblin", 2, 15);
+    auto fighter = tracker.add("fighter", 1, 15);
+    auto orc = tracker.add("orc", 2, 15);
+    auto wizard = tracker.add("wizard", -1, 18);
+
+    if(tracker.find("orc") != orc || tracker.find("bard") != InitiativeTracker::NONE) return 1;
+    if(tracker.order() != vector<InitiativeTracker::Handle>({ wizard, goblin, orc, fighter })) return 1;
+    if(tracker.next() != wizard || tracker.next() != goblin || tracker.round() != 1) return 1;
+
+    // the orc acts after the fighter this round, then keeps 10 from then on
+    if(tracker.delay(fighter, 10) || tracker.delay(goblin, 20)) return 1;
+    if(tracker.next() != orc || !tracker.delay(orc, 10)) return 1;
+
+    // a newcomer whose initiative has already passed waits for the next round
+    auto rogue = tracker.add("rogue", 3, 20);
+    auto bard = tracker.add("bard", 0, 1);
+
+    if(tracker.next() != fighter || tracker.next() != orc || tracker.next() != bard) return 1;
+    if(!tracker.remove(goblin) || tracker.remove(goblin) || tracker.size() != 5) return 1;
+    if(tracker.next() != rogue || tracker.next() != wizard || tracker.round() != 2) return 1;
+
+    tracker.clear();
+    if(tracker.size() != 0 || tracker.next() != InitiativeTracker::NONE) return 1;
+
+    vector<string> horde(10000, "zombie");
+    vector<int> dexMods(10000, -2);
+    tracker.add_all(horde, dexMods);
+
+    auto turns = tracker.order();
+    for(size_t i = 1; i < turns.size(); i++) {
+        if(tracker.get(turns[i - 1]).initiative < tracker.get(turns[i]).initiative) return 1;
+    }
+
+    if(tracker.peek() != turns[0] || tracker.next() != turns[0]) return 1;
+    if(tracker.get(turns[0]).initiative > 18 || tracker.get(turns.back()).initiative < -1) return 1;
+
+    /* every face of a bulk rolled die must come up, and nothing else */
+    vector<uint8> faces(20000);
+    roll_dice(Die(20), faces.size(), faces.data(), Utils::thread_engine());
+
+    uint64 seen[21] = { 0 };
+    for(auto face : faces) {
+        if(face < 1 || face > 20) return 1;
+        seen[face]++;
+    }
+
+    for(int face = 1; face <= 20; face++) if(seen[face] < 800 || seen[face] > 1200) return 1;
+
+    // odd checks can never fail, even checks can never pass
+    vector<int8> mods(130);
+    for(size_t i = 0; i < mods.size(); i++) mods[i] = (i % 2) ? 20 : -20;
+
+    CheckResult checks = resolve_checks(mods.data(), mods.size(), 21, ADVANTAGE);
+    if(checks.count != 130 || checks.passes != 65 || checks.passed.size() != 3) return 1;
+
+    for(size_t i = 0; i < mods.size(); i++) {
+        if(checks.is_pass(i) != (i % 2 == 1)) return 1;
+        if(checks.totals[i] - mods[i] < 1 || checks.totals[i] - mods[i] > 20) return 1;
+    }
+
+    // advantage keeps the higher of two d20s, which averages about 13.8
+    vector<int8> flat(10000, 0);
+    CheckResult high = resolve_checks(flat.data(), flat.size(), 11, ADVANTAGE);
+    CheckResult low = resolve_checks(flat.data(), flat.size(), 11, DISADVANTAGE);
+    if(high.passes < 7000 || low.passes > 3000) return 1;
+
+    if(roll_saves(population, STR, 100).passes != 0) return 1;
+
+    const int athletics = character.SKILL_MOD(ATH);
+    if(roll_checks({ &character, &character }, ATH, athletics + 21).passes != 0) return 1;
+    if(roll_checks({ &character, &character }, ATH, athletics + 1).passes != 2) return 1;
+    if(roll_saves({ &character }, INT, character.INT_SAVE() + 1).totals[0] < character.INT_SAVE() + 1) return 1;
+
+    /* 21 of the 1296 ways 4 dice can land keep 18, and 6 of the 36 ways 2 can land sum to 7 */
+    Distribution dropLowest = Roll::keep_highest(4, 6, 3);
+    if(dropLowest.lowest != 3 || dropLowest.highest() != 18) return 1;
+    if(fabs(dropLowest.chance(18) - 21.0 / 1296) > 1e-12) return 1;
+    if(fabs(dropLowest.mean() - 15869.0 / 1296) > 1e-9) return 1;
+    if(fabs(Roll::keep_highest(2, 6, 2, 6).chance(13) - 6.0 / 36) > 1e-12) return 1;
+
+    ScoreMethod fourDSix("4d6h3");
+    if(fourDSix.type() != DICE_SCORES || !fourDSix.is_exact()) return 1;
+    if(ScoreMethod("Standard").type() != STANDARD_ARRAY) return 1;
+    if(ScoreMethod("1d20+2d4").type() != EXPRESSION_SCORES) return 1;
+    if(ScoreMethod("bite").is_valid() || ScoreMethod().to_string() != "2d6+6") return 1;
+
+    ScoreColumns rolled = fourDSix.generate(10000, 2);
+    if(rolled.size() != 10000) return 1;
+
+    for(auto& column : rolled.scores) {
+        for(auto score : column) if(score < 3 || score > 18) return 1;
+    }
+
+    // every standard array is the same six scores, in some order
+    ScoreColumns dealt = ScoreMethod("standard").generate(100, 1);
+    for(size_t n = 0; n < dealt.size(); n++) {
+        int sum = 0, product = 1;
+
+        for(auto& column : dealt.scores) {
+            sum += column[n];
+            product *= column[n];
+        }
+
+        if(sum != 72 || product != 15 * 14 * 13 * 12 * 10 * 8) return 1;
+    }
+
+    // a point buy always spends every point, and the chance of each score sums to 1
+    ScoreMethod pointBuy("point-buy");
+    ScoreColumns bought = pointBuy.generate(1000, 1);
+    const int costs[] = { 0, 1, 2, 3, 4, 5, 7, 9 };
+
+    for(size_t n = 0; n < bought.size(); n++) {
+        int spent = 0;
+
+        for(auto& column : bought.scores) {
+            if(column[n] < 8 || column[n] > 15) return 1;
+            spent += costs[column[n] - 8];
+        }
+
+        if(spent != 27) return 1;
+    }
+
+    if(fabs(pointBuy.distribution().at_least(8) - 1.0) > 1e-9) return 1;
+    if(ability_score_vector(fourDSix).size() != ABILITY_SCORE_COUNT) return 1;
+
+    /* the optimizer must find the same best point buy as trying every one of them */
+    const Race* highElf = select_race(HighElf::ID);
+    const CharacterClass* wizardClass = select_character_class(Wizard::ID);
+
+    BuildGoal goal;
+    goal.weights[INT] = 3;
+    goal.weights[DEX] = 2;
+    goal.weights[WIS] = 1;
+    goal.minimum[CON] = 14;
+
+    double bruteForce = -1000;
+
+    for(int n = 0; n < 8 * 8 * 8 * 8 * 8 * 8; n++) {
+        int base[ABILITY_SCORE_COUNT], spent = 0;
+        double value = 0;
+
+        for(int ability = 0, rest = n; ability < ABILITY_SCORE_COUNT; ability++, rest /= 8) {
+            base[ability] = 8 + rest % 8;
+            spent += costs[rest % 8];
+        }
+
+        if(spent > 27 || base[CON] < 14) continue;
+
+        value += 3 * modifier(base[INT] + 1) + 2 * modifier(base[DEX] + 2) + modifier(base[WIS]);
+        bruteForce = max(bruteForce, value);
+    }
+
+    vector<Build> builds = optimize_point_buy(*highElf, *wizardClass, goal, 20, 2);
+    if(builds.size() != 20 || builds[0].value != bruteForce) return 1;
+    if(builds[0].scores[DEX] != builds[0].base[DEX] + 2 || builds[0].scores[CON] < 14) return 1;
+
+    for(size_t i = 1; i < builds.size(); i++) {
+        if(builds[i].value > builds[i - 1].value || builds[i].pointsSpent > 27) return 1;
+    }
+
+    // the same search on any number of threads finds the same builds
+    vector<Build> single = optimize_point_buy(*highElf, *wizardClass, goal, 20, 1);
+    for(size_t i = 0; i < builds.size(); i++) {
+        if(!equal(single[i].base, single[i].base + ABILITY_SCORE_COUNT, builds[i].base)) return 1;
+    }
+
+    goal.accept = [](const uint8* scores) { return scores[CHA] >= 12; };
+    for(auto& build : optimize_point_buy(*highElf, *wizardClass, goal, 5)) if(build.scores[CHA] < 12) return 1;
+
+    vector<Build> assigned = optimize_assignment({ 8, 10, 12, 13, 14, 15 }, *highElf, *wizardClass, goal, 3);
+    if(assigned.empty() || assigned[0].base[INT] != 15 || assigned[0].base[CHA] < 12) return 1;
+    if(!optimize_assignment({ 15, 14 }, *highElf, *wizardClass, goal).empty()) return 1;
+    if(roll_saves(population, STR, -100).passes != population.size()) return 1;
+
+    return 0;
+}
@@ -45,5 +45,15 @@ int main(int argc, char* argv[]) {
         if(full.empty()) return 1;
     }
 
+    NameBatch batch = gen.make_names(10000);
+
+    if(batch.size() != 10000) return 1;
+
+    for(size_t i = 0; i < batch.size(); i++) {
+        // Check batched names are put together like make_name()
+        if(batch.name(i).empty()) return 1;
+        if(race_has_last(race) && batch.name(i).find(' ') == std::string::npos) return 1;
+    }
+
     return 0;
 }
\ No newline at end of file
@@ -6,8 +6,13 @@ OpenRPG Software License - Version 1.0 - February 10th, 2017 <https://openrpg.io
 This is free software: you are free to change and redistribute it.
 There is NO WARRANTY, to the extent permitted by law.
 */
+#include <cmath>
 #include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
 
+#include "roll/expression-cache.h"
 #include "roll/roll-parser.h"
 
 using namespace std;
@@ -48,5 +53,221 @@ int main(int argc, char* argv[]) {
     if(d20 > 20 || d20 < 0)     return 1;
     if(d100 > 100 || d100 < 0)  return 1;
 
+    /* whitespace and bracket style share a tree, and only the first lookup parses */
+    ExpressionCache cache(4, 2);
+
+    auto first = cache.get("[1d6 + 2]");
+    auto second = cache.get("(1d6+2)");
+
+    if(first == nullptr || first != second)                     return 1;
+    if(cache.hits() != 1 || cache.misses() != 1)                return 1;
+    if(ExpressionCache::normalize(" {2d4} ") != "(2d4)")        return 1;
+
+    for(int i = 0; i < 100; i++) {
+        const int total = first->evaluate();
+        if(total < 3 || total > 8)                              return 1;
+    }
+
+    /* bad expressions are not held, and nothing past capacity is */
+    if(cache.get("abc") != nullptr)                             return 1;
+
+    for(int sides = 2; sides < 20; sides++) cache.get("1d" + to_string(sides));
+
+    if(cache.size() > cache.capacity())                         return 1;
+
+    /* an evicted tree lives on for whoever still holds it */
+    if(first->evaluate() < 3)                                   return 1;
+
+    cache.clear();
+    if(cache.size() != 0 || cache.hits() != 0)                  return 1;
+
+    /* a compiled Expression rolls the same as its tree, drawing only from the engine it is given */
+    Expression attack;
+
+    if(!Expression::parse("(4d6h3) + 1d4", attack))         return 1;
+    if(Expression::parse("abc", attack))                        return 1;
+
+    Utils::RandomEngine engineA(42);
+    Utils::RandomEngine engineB(42);
+
+    for(int i = 0; i < 1000; i++) {
+        const int total = attack.evaluate(engineA);
+
+        if(total < 4 || total > 22)                             return 1;
+        if(total != attack.evaluate(engineB))                   return 1;
+    }
+
+    ExpressionTree lowTree;
+    lowTree.set_expression("3d20l1");
+
+    const Expression low = lowTree.compile();
+
+    if(low.get_input_string() != "3d20l1")                      return 1;
+
+    for(int i = 0; i < 1000; i++) {
+        const int total = low.evaluate();
+        if(total < 1 || total > 20)                             return 1;
+    }
+
+    /* many threads may share one Expression, each with its own engine */
+    vector<thread> threads;
+    vector<int> failures(4, 0);
+
+    for(int t = 0; t < 4; t++) {
+        threads.emplace_back([&attack, &failures, t]() {
+            Utils::RandomEngine engine(t);
+
+            for(int i = 0; i < 10000; i++) {
+                const int total = attack.evaluate(engine);
+                if(total < 4 || total > 22) failures[t]++;
+            }
+        });
+    }
+
+    for(auto& worker : threads) worker.join();
+    for(auto failed : failures) if(failed != 0)                 return 1;
+
+    /* operators bind by precedence, left to right, and groups must close the way they open */
+    ExpressionTree precedence;
+
+    if(!precedence.set_expression("2d20h1+4"))                  return 1;
+    if(precedence.to_string() != "head->(+)\n"
+                                 "  left->(high)\n"
+                                 "    left->(die)\n"
+                                 "      left->(2)\n"
+                                 "      right->(20)\n"
+                                 "    right->(1)\n"
+                                 "  right->(4)\n")              return 1;
+
+    if(!precedence.set_expression("10-3-2"))                    return 1;
+    if(precedence.parse_expression() != 5)                      return 1;
+
+    if(!precedence.set_expression("2+3*4"))                     return 1;
+    if(precedence.parse_expression() != 14)                     return 1;
+
+    if(!precedence.set_expression("-2+5"))                      return 1;
+    if(precedence.parse_expression() != 3)                      return 1;
+
+    /* the old parser grouped everything after a number to the right, and everything
+        before a roll or group to the left. these pin each shape that changed */
+    const struct { const char* expression; int total; } arithmetic[] = {
+        { "2*3+4",      10 },   // was 2*(3+4), 14
+        { "2*3-4",      2 },    // was 2*(3-4), -2
+        { "12/4+2",     5 },    // was 12/(4+2), 2
+        { "7%4+1",      4 },    // was 7%(4+1), 2
+        { "12/3*2",     8 },    // was 12/(3*2), 2
+        { "8/2/2",      2 },    // was 8/(2/2), 8
+        { "7%4*2",      6 },    // was 7%(4*2), 7
+        { "17%5%3",     2 },    // was 17%(5%3), 1
+        { "10-3+2",     9 },    // was 10-(3+2), 5
+        { "-1+4",       3 },    // was -(1+4), -5
+        { "-2*3+1",     -5 },   // was -(2*(3+1)), -8
+        { "3+1d1*3",    6 },    // was (3+1d1)*3, 12
+        { "1d1+2*3",    7 },    // unchanged
+        { "2*1d1+3",    5 },    // unchanged
+    };
+
+    for(auto& check : arithmetic) {
+        if(!precedence.set_expression(check.expression))        return 1;
+        if(precedence.parse_expression() != check.total)        return 1;
+    }
+
+    // was 4d6h(3+2)
+    if(!precedence.set_expression("4d6h3+2"))                   return 1;
+    if(precedence.to_string() != "head->(+)\n"
+                                 "  left->(high)\n"
+                                 "    left->(die)\n"
+                                 "      left->(4)\n"
+                                 "      right->(6)\n"
+                                 "    right->(3)\n"
+                                 "  right->(2)\n")              return 1;
+
+    // was (3+1d6)>=3
+    if(!precedence.set_expression("3+1d6>=3"))                  return 1;
+    if(precedence.to_string() != "head->(+)\n"
+                                 "  left->(3)\n"
+                                 "  right->(>=)\n"
+                                 "    left->(die)\n"
+                                 "      left->(1)\n"
+                                 "      right->(6)\n"
+                                 "    right->(3)\n")            return 1;
+
+    // was 1d20>(1<20)
+    if(!precedence.set_expression("1d20>1<20"))                 return 1;
+    if(precedence.to_string() != "head->(<)\n"
+                                 "  left->(>)\n"
+                                 "    left->(die)\n"
+                                 "      left->(1)\n"
+                                 "      right->(20)\n"
+                                 "    right->(1)\n"
+                                 "  right->(20)\n")             return 1;
+
+    if(!precedence.set_expression("[2*(1+2)]-{4}"))             return 1;
+    if(precedence.parse_expression() != 2)                      return 1;
+
+    if(precedence.set_expression("(1d6]"))                      return 1;
+    if(precedence.set_expression("5h2"))                        return 1;
+    if(precedence.set_expression("99999999999"))                return 1;
+
+    /* no expression may roll more dice, or bigger ones, than an Expression allows */
+    if(precedence.set_expression("2000000000d6h1"))             return 1;
+    if(precedence.set_expression("(2000d1000)d6"))              return 1;
+    if(precedence.set_expression("1d2000000"))                  return 1;
+    if(!precedence.set_expression("1000d6>=3000"))              return 1;
+
+    /* nesting too deeply would overflow the stack, whether in brackets, signs, or a long sum */
+    const std::string opens(100000, '('), closes(100000, ')');
+    const std::string signs(100000, '-'), dice(100000, 'd');
+    std::string sum = "1";
+    for(int i = 0; i < 100000; i++) sum += "+1";
+
+    if(precedence.set_expression(opens + "1" + closes))         return 1;
+    if(precedence.set_expression(signs + "1"))                  return 1;
+    if(precedence.set_expression(dice + "6"))                   return 1;
+    if(precedence.set_expression(sum))                          return 1;
+    if(cache.get(sum) != nullptr)                               return 1;
+
+    if(!precedence.set_expression(opens.substr(0, 200) + "1" + closes.substr(0, 200))) return 1;
+    if(!precedence.set_expression(sum.substr(0, 401)))          return 1;
+    if(precedence.parse_expression() != 201)                    return 1;
+    if(cache.get("[1d6)") != nullptr)                           return 1;
+    if(cache.get("1 2") != nullptr)                             return 1;
+    if(cache.get("1d2 0") != nullptr)                           return 1;
+    if(cache.get("1d6 > = 3") != nullptr)                       return 1;
+    if(cache.get(" 1d6 >= 3 ") == nullptr)                      return 1;
+
+    /* rerolls draw straight from the totals that meet them, and ones that never can do not parse */
+    Expression reroll;
+
+    if(Expression::parse("1d6>6", reroll))                      return 1;
+    if(Expression::parse("(1d2)d2>4", reroll))                  return 1;
+    if(!Expression::parse("1d100>98", reroll))                  return 1;
+
+    for(int i = 0; i < 1000; i++) {
+        const int total = reroll.evaluate();
+        if(total != 99 && total != 100)                         return 1;
+    }
+
+    if(!Expression::parse("1d6!1", reroll))                     return 1;
+
+    for(int i = 0; i < 1000; i++) {
+        const int total = reroll.evaluate();
+        if(total < 2 || total > 6)                              return 1;
+    }
+
+    // a limit no total can meet, like a 6 here, is rolled again
+    if(!Expression::parse("1d6>1d8", reroll))                   return 1;
+
+    for(int i = 0; i < 1000; i++) {
+        const int total = reroll.evaluate();
+        if(total < 2 || total > 6)                              return 1;
+    }
+
+    // too many totals to table, and none of them can meet the limit, so it gives up
+    if(!Expression::parse("100d1000>100000", reroll))           return 1;
+    if(reroll.evaluate() != 0)                                  return 1;
+
+    if(fabs(Roll::dice_sum(3, 6).chance(10) - 27.0 / 216) > 1e-12) return 1;
+
     return 0;
 }
@@ -161,8 +161,17 @@ describe('OpenRPG ' + ORPG.ORPG_VERSION(), () => {
                 }
             });
 
-            it("expression 'd6 + d8 % 2' >= 0 && <= 1", () => {
+            it("expression 'd6 + d8 % 2' >= 1 && <= 7", () => {
                 exp.set_expression('d6 + d8 % 2');
+                for (i = 0; i < LOOP_INT; i++) {
+                    val = exp.parse_expression();
+                    assert.ok(val >= 1);
+                    assert.ok(val <= 7);
+                }
+            });
+
+            it("expression '(d6 + d8) % 2' >= 0 && <= 1", () => {
+                exp.set_expression('(d6 + d8) % 2');
                 for (i = 0; i < LOOP_INT; i++) {
                     val = exp.parse_expression();
                     assert.ok(val >= 0);
@@ -247,8 +256,72 @@ describe('OpenRPG ' + ORPG.ORPG_VERSION(), () => {
                 assert.ok(exp.parse_expression() === -1);
             });
 
+            it('ExpressionTrees do not share expressions', () => {
+                const d4 = new ORPG.ExpressionTree();
+                const d100 = new ORPG.ExpressionTree();
+                d4.set_expression('1d4');
+                d100.set_expression('100+1d4');
+                for (i = 0; i < LOOP_INT; i++) {
+                    assert.ok(d4.parse_expression() <= 4);
+                    assert.ok(d100.parse_expression() > 100);
+                }
+                assert.strictEqual(d4.get_input_string(), '1d4');
+            });
+
             // TODO continue adding expression tests to esure we fully test our ExpressionParser
         });
+
+        describe('rollMany', () => {
+            it("rollMany('2d6', LOOP_INT) resolves LOOP_INT rolls >= 2 && <= 12", () => {
+                return ORPG.rollMany('2d6', LOOP_INT).then((rolls) => {
+                    assert.ok(rolls instanceof Int32Array);
+                    assert.strictEqual(rolls.length, LOOP_INT);
+                    for (i = 0; i < rolls.length; i++) {
+                        assert.ok(rolls[i] >= 2);
+                        assert.ok(rolls[i] <= 12);
+                    }
+                });
+            });
+
+            it("rollMany('1d20', 0) resolves an empty Int32Array", () => {
+                return ORPG.rollMany('1d20', 0).then((rolls) => {
+                    assert.strictEqual(rolls.length, 0);
+                });
+            });
+
+            it("rollMany('bite', 1) rejects", () => {
+                return ORPG.rollMany('bite', 1).then(() => assert.fail(), (err) => {
+                    assert.ok(err instanceof TypeError);
+                });
+            });
+
+            it("rollMany('1d4', -1) rejects", () => {
+                return ORPG.rollMany('1d4', -1).then(() => assert.fail(), (err) => {
+                    assert.ok(err instanceof RangeError);
+                });
+            });
+        });
+
+        describe('simulate', () => {
+            it("simulate('3d6', LOOP_INT) counts every trial between 3 and 18", () => {
+                return ORPG.simulate('3d6', LOOP_INT).then((result) => {
+                    let total = 0;
+                    assert.ok(result.counts instanceof Float64Array);
+                    assert.strictEqual(result.trials, LOOP_INT);
+                    assert.ok(result.lowest >= 3);
+                    assert.ok(result.lowest + result.counts.length - 1 <= 18);
+                    for (i = 0; i < result.counts.length; i++) total += result.counts[i];
+                    assert.strictEqual(total, LOOP_INT);
+                    assert.ok(Math.abs(result.mean - 10.5) < 0.5);
+                });
+            });
+
+            it("simulate('bite', 1) rejects", () => {
+                return ORPG.simulate('bite', 1).then(() => assert.fail(), (err) => {
+                    assert.ok(err instanceof TypeError);
+                });
+            });
+        });
     });
 
     describe('Names Module', () => {
@@ -410,6 +483,49 @@ describe('OpenRPG ' + ORPG.ORPG_VERSION(), () => {
                     }
                 });
             }
+
+            it('NameGenerators do not share races', () => {
+                const elf = new ORPG.NameGenerator('elf', 'female', TESTING_ASSET_LOC);
+                const halfling = new ORPG.NameGenerator('halfling', 'male', TESTING_ASSET_LOC);
+                assert.strictEqual(elf.get_race(), 'elf');
+                assert.strictEqual(halfling.get_race(), 'halfling');
+                assert.strictEqual(elf.get_gender(), 'female');
+            });
+
+            it('makeNames(LOOP_INT) returns LOOP_INT full names', () => {
+                const dwarf = new ORPG.NameGenerator('dwarf', 'male', TESTING_ASSET_LOC);
+                const names = dwarf.makeNames(LOOP_INT);
+                assert.ok(Array.isArray(names));
+                assert.strictEqual(names.length, LOOP_INT);
+                for (i = 0; i < names.length; i++) {
+                    assert.strictEqual(names[i].split(' ').length >= 2, true);
+                }
+                assert.strictEqual(dwarf.makeNames(0).length, 0);
+                assert.throws(() => dwarf.makeNames(-1), RangeError);
+            });
+        });
+    });
+
+    describe('worker_threads', () => {
+        it('loads in a worker and rolls there', () => {
+            const { Worker } = require('worker_threads');
+            const worker = new Worker(`
+                const { parentPort } = require('worker_threads');
+                const ORPG = require(${JSON.stringify(require.resolve('../src/nodejs/export'))});
+                const tree = new ORPG.ExpressionTree();
+                tree.set_expression('1d6');
+                let ok = true;
+                for (let i = 0; i < 1000; i++) {
+                    const val = tree.parse_expression();
+                    ok = ok && val >= 1 && val <= 6;
+                }
+                parentPort.postMessage(ok);
+            `, { eval: true });
+
+            return new Promise((resolve, reject) => {
+                worker.once('message', resolve);
+                worker.once('error', reject);
+            }).then((ok) => assert.ok(ok));
         });
     });
 });